@@ -0,0 +1,97 @@
+#ifndef ALLOCATIONTRACKER_H
+#define ALLOCATIONTRACKER_H
+
+/*
+ * ALLOCATION PHASE
+ * ----------------
+ * The part of a round that is running. Allocations are counted under the
+ * phase set on the allocating thread.
+ */
+enum class AllocationPhase {
+    Other,       // Outside any marked phase (setup, simulator bookkeeping)
+    Deal,        // dealInitialCards
+    PlayerTurn,  // playerTurn (including splits and hints)
+    DealerTurn,  // dealerTurn
+    Settle,      // determineWinner
+    Reset,       // resetRound (new Player / Dealer / shoe)
+    COUNT
+};
+
+struct AllocationCounts {
+    long long allocations = 0;  // Calls to operator new / new[]
+    long long frees = 0;        // Calls to operator delete / delete[]
+    long long bytes = 0;        // Bytes requested from operator new
+
+    AllocationCounts operator-(const AllocationCounts& earlier) const {
+        AllocationCounts difference;
+        difference.allocations = allocations - earlier.allocations;
+        difference.frees = frees - earlier.frees;
+        difference.bytes = bytes - earlier.bytes;
+        return difference;
+    }
+};
+
+/*
+ * ALLOCATIONTRACKER CLASS
+ * -----------------------
+ * Counts heap allocations by replacing the global operator new/delete.
+ *
+ * ONLY IN TRACKING BUILDS:
+ * Configure with -DBLACKJACK_TRACK_ALLOCATIONS=ON to turn it on. In normal
+ * builds the operators are not replaced, enabled() is false, every count
+ * is zero and AllocationScope compiles to nothing.
+ *
+ * USE:
+ *   AllocationCounts before = AllocationTracker::total();
+ *   ... play rounds ...
+ *   AllocationCounts used = AllocationTracker::total() - before;
+ * "Zero allocations in steady state" is then simply used.allocations == 0.
+ *
+ * Counters are relaxed atomics shared by all threads; the current phase
+ * is per thread.
+ */
+class AllocationTracker {
+public:
+    static const int PHASES = static_cast<int>(AllocationPhase::COUNT);
+
+    static bool enabled();
+    static AllocationCounts total();
+    static AllocationCounts phase(AllocationPhase phase);
+    static const char* phaseName(AllocationPhase phase);
+
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+    static AllocationPhase currentPhase();
+    static void setPhase(AllocationPhase phase);
+#else
+    // Inline no-ops, so marking phases in hot loops costs nothing
+    static AllocationPhase currentPhase() { return AllocationPhase::Other; }
+    static void setPhase(AllocationPhase) {}
+#endif
+};
+
+/*
+ * ALLOCATIONSCOPE CLASS
+ * ---------------------
+ * Marks a phase for the lifetime of the object and restores the previous
+ * phase afterwards:   AllocationScope scope(AllocationPhase::Deal);
+ */
+class AllocationScope {
+public:
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+    explicit AllocationScope(AllocationPhase phase) : previous(AllocationTracker::currentPhase()) {
+        AllocationTracker::setPhase(phase);
+    }
+    ~AllocationScope() { AllocationTracker::setPhase(previous); }
+
+private:
+    AllocationPhase previous;
+#else
+    explicit AllocationScope(AllocationPhase) {}
+#endif
+
+public:
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+#endif
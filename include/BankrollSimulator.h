@@ -0,0 +1,102 @@
+#ifndef BANKROLLSIMULATOR_H
+#define BANKROLLSIMULATOR_H
+
+#include "Betting.h"
+#include "GameConfig.h"
+#include "PlayerPolicy.h"
+#include "Simulator.h"
+#include <cstdint>
+#include <vector>
+
+/*
+ * BANKROLL OPTIONS / RESULT
+ */
+struct BankrollOptions {
+    long long bankrolls = 10000;      // Independent players simulated
+    long long rounds = 10000;         // Rounds each bankroll tries to play
+    double startingUnits = 100.0;     // Starting bankroll in betting units
+    int trajectoryPoints = 10;        // Snapshots of every bankroll along the way
+    int threads = 1;
+    uint64_t seed = 1;
+};
+
+// Spread of bankrolls at one moment
+struct BankrollSnapshot {
+    long long round = 0;
+    double ruined = 0.0;    // Fraction of bankrolls ruined by this round
+    double mean = 0.0;
+    double p5 = 0.0, p25 = 0.0, median = 0.0, p75 = 0.0, p95 = 0.0;
+};
+
+struct BankrollResult {
+    double riskOfRuin = 0.0;          // Fraction ruined before the last round
+    double riskOfRuinHalfWidth = 0.0; // 95% confidence half-width
+    double meanRoundsToRuin = 0.0;    // Over the ruined bankrolls only
+    long long roundsPlayed = 0;
+    double wagered = 0.0;             // Units bet in total
+    double won = 0.0;                 // Units won (+) or lost (-) in total
+    double meanBet = 0.0;
+    std::vector<BankrollSnapshot> trajectory;  // Last entry = final bankrolls
+    double seconds = 0.0;
+
+    double edgePerUnit() const { return wagered > 0.0 ? won / wagered : 0.0; }
+};
+
+/*
+ * BANKROLLSIMULATOR CLASS
+ * -----------------------
+ * Puts BETTING back on top of the points game: many bankrolls each play a
+ * long session with a BettingStrategy, and the simulator reports how
+ * often they go broke and how their bankrolls spread out over time.
+ *
+ * A bankroll is RUINED when it drops below the minimum bet of one unit; it
+ * then stops playing. A bigger bet than the bankroll can cover (a count
+ * spread at a high count) is cut down to the whole bankroll instead. Rounds are played by RoundEngine with the configured
+ * rules and PlayerPolicy; the round's net points are multiplied by the bet.
+ *
+ * BATCHED LAYOUT:
+ * - Bankrolls are processed in groups of LANE_WIDTH. A group keeps each
+ *   field in its own array (structure of arrays): bankrolls together,
+ *   shoes together, random streams together
+ * - Within a group all lanes play round r before any plays round r + 1,
+ *   so the group's state stays in the cache for the whole session
+ * - Groups are claimed by threads from an atomic counter; bankroll i always
+ *   uses random stream i, so results do not depend on the thread count
+ *
+ * The trajectory stores every bankroll at 'trajectoryPoints' evenly spaced
+ * rounds; percentiles are taken across bankrolls at each point.
+ */
+class BankrollSimulator {
+public:
+    static const int LANE_WIDTH = 16;
+    static constexpr double MIN_BET = 1.0;  // Units; below this a bankroll is ruined
+
+    // Throws std::invalid_argument for a count-based betting strategy without a finite shoe
+    BankrollSimulator(const GameConfig& config, const PlayerPolicy& policy, const BettingStrategy& betting);
+
+    BankrollResult run(const BankrollOptions& options) const;
+
+private:
+    struct LaneGroup {
+        Rng rng[LANE_WIDTH];
+        ShoeState shoe[LANE_WIDTH];
+        double bankroll[LANE_WIDTH];
+        double wagered[LANE_WIDTH];
+        double won[LANE_WIDTH];
+        double nextBet[LANE_WIDTH];      // Decided before the round, from the shoe
+        long long ruinedAt[LANE_WIDTH];  // Rounds played before ruin, -1 = still playing
+    };
+
+    GameConfig config;
+    const PlayerPolicy& policy;
+    const BettingStrategy& betting;
+    RoundEngine engine;
+
+    // Plays one group; snapshots[point * bankrolls + bankroll] receives the bankrolls
+    void playGroup(LaneGroup& group, long long firstBankroll, int lanes, const BankrollOptions& options,
+                   const std::vector<long long>& snapshotRounds, std::vector<float>& snapshots) const;
+    void takeSnapshot(const LaneGroup& group, long long firstBankroll, int lanes, long long bankrolls,
+                      size_t point, std::vector<float>& snapshots) const;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef BETTING_H
+#define BETTING_H
+
+#include "ShoeState.h"
+#include <memory>
+#include <string>
+
+/*
+ * BETTING STRATEGY
+ * ----------------
+ * How much to bet before a round, in betting units. Same Strategy pattern
+ * as DrawStrategy: the bankroll simulator only talks to this interface,
+ * so new bet sizing schemes plug in without touching it.
+ *
+ * Game itself still scores in points (see determineWinner); betting only
+ * exists in the bankroll simulation.
+ */
+class BettingStrategy {
+public:
+    // Bet for the next round, dealt from 'shoe' (a full shoe has 'fullShoe' cards)
+    virtual double bet(const ShoeState& shoe, int fullShoe) const = 0;
+    virtual std::string describe() const = 0;
+    // True if bets depend on the cards dealt, which needs a finite shoe
+    virtual bool needsFiniteShoe() const { return false; }
+    virtual ~BettingStrategy() = default;
+};
+
+/*
+ * FLAT BETTING
+ * ------------
+ * The same bet every round.
+ */
+class FlatBetting : public BettingStrategy {
+public:
+    explicit FlatBetting(double units = 1.0);
+
+    double bet(const ShoeState& shoe, int fullShoe) const override;
+    std::string describe() const override;
+
+private:
+    double units;
+};
+
+/*
+ * COUNT SPREAD BETTING
+ * --------------------
+ * Hi-Lo card counting: 2-6 count +1, 7-9 count 0, tens and Aces count -1.
+ * The RUNNING COUNT is the sum over the cards already dealt from the shoe
+ * (read straight from the ShoeState counts), and the TRUE COUNT divides it
+ * by the decks still left. The bet is
+ *     1 unit                        when trueCount < 1
+ *     1 + (trueCount - 1) * ramp    above that, capped at maxUnits
+ * Only meaningful with a finite shoe (GameConfig::useCompositionDeck);
+ * with independent cards the count never moves, so BankrollSimulator
+ * refuses to run it without one.
+ */
+class CountSpreadBetting : public BettingStrategy {
+public:
+    CountSpreadBetting(double maxUnits, double ramp);
+
+    double bet(const ShoeState& shoe, int fullShoe) const override;
+    std::string describe() const override;
+    bool needsFiniteShoe() const override { return true; }
+
+    static double trueCount(const ShoeState& shoe, int fullShoe);
+
+private:
+    double maxUnits;
+    double ramp;
+};
+
+// Factory: "flat" or "spread"; throws std::invalid_argument for any other name
+std::unique_ptr<BettingStrategy> createBettingStrategy(const std::string& name, double maxUnits, double ramp);
+
+#endif
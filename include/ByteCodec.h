@@ -0,0 +1,131 @@
+#ifndef BYTECODEC_H
+#define BYTECODEC_H
+
+#include "GameException.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/*
+ * BYTEWRITER / BYTEREADER
+ * -----------------------
+ * The compact binary encoding of session files (see SessionStore.h).
+ *
+ * - Integers are LEB128 varints (7 bits per byte), signed ones zigzag
+ *   encoded first, so the small numbers a game is full of take one byte
+ * - Doubles and 64-bit random states are 8 bytes, little-endian
+ * - Strings are a varint length followed by the bytes
+ *
+ * The format is the same on every machine. ByteReader checks every read
+ * against the end of the data and throws TableFormatException instead of
+ * reading past it.
+ */
+class ByteWriter {
+public:
+    explicit ByteWriter(std::string& target) : out(target) {}
+
+    void putByte(uint8_t value) { out.push_back(static_cast<char>(value)); }
+
+    void putVarint(uint64_t value) {
+        while (value >= 0x80) {
+            putByte(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        putByte(static_cast<uint8_t>(value));
+    }
+
+    void putSigned(int64_t value) {
+        putVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void putFixed64(uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            putByte(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void putDouble(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putFixed64(bits);
+    }
+
+    void putString(const std::string& value) {
+        putVarint(value.size());
+        out.append(value);
+    }
+
+private:
+    std::string& out;
+};
+
+class ByteReader {
+public:
+    ByteReader(const std::string& source) : in(source), at(0) {}
+
+    uint8_t getByte() {
+        if (at >= in.size()) {
+            throw TableFormatException("Session data is truncated");
+        }
+        return static_cast<uint8_t>(in[at++]);
+    }
+
+    uint64_t getVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = getByte();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw TableFormatException("Session data has a bad number");
+    }
+
+    int64_t getSigned() {
+        uint64_t value = getVarint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    // A varint that must lie in [low, high]
+    int getInt(int low, int high) {
+        int64_t value = getSigned();
+        if (value < low || value > high) {
+            throw TableFormatException("Session data has a value out of range");
+        }
+        return static_cast<int>(value);
+    }
+
+    uint64_t getFixed64() {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++) {
+            value |= static_cast<uint64_t>(getByte()) << (8 * i);
+        }
+        return value;
+    }
+
+    double getDouble() {
+        uint64_t bits = getFixed64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string getString() {
+        uint64_t size = getVarint();
+        if (size > in.size() - at) {
+            throw TableFormatException("Session data is truncated");
+        }
+        std::string value = in.substr(at, static_cast<size_t>(size));
+        at += static_cast<size_t>(size);
+        return value;
+    }
+
+    bool atEnd() const { return at == in.size(); }
+
+private:
+    const std::string& in;
+    size_t at;
+};
+
+#endif
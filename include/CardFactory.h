@@ -28,6 +28,17 @@ public:
     // Static method - no need to instantiate the factory
     // Returns a dynamically allocated Card object
     static Card* createCard(int number, const string& suit);
+
+    /*
+     * CARD CODES:
+     * One byte per card for saved sessions (see SessionStore.h).
+     * Code c is rank c % 13 + 1 of suit c / 13, the same numbering as
+     * Deck's card types. An Ace carries no suit, so it is always suit 0.
+     */
+    static const int CODES = 52;
+    static int rankOf(const Card& card);       // 1-13
+    static int codeOf(const Card& card);
+    static Card* createFromCode(int code);     // Throws TableFormatException for a bad code
 };
 
 #endif
@@ -0,0 +1,70 @@
+#ifndef CHECKPOINTWRITER_H
+#define CHECKPOINTWRITER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/*
+ * CHECKPOINTWRITER CLASS
+ * ----------------------
+ * Saves checkpoint files on a BACKGROUND THREAD, so the code producing
+ * them never waits for the disk.
+ *
+ * DOUBLE BUFFERED:
+ * - submit() only moves the new contents into the 'pending' buffer and
+ *   wakes the writer thread - it never touches the file itself
+ * - The writer thread swaps 'pending' with its own 'writing' buffer and
+ *   writes that one out, while the next checkpoint can already be queued
+ * - If a checkpoint arrives while an older one is still waiting, the older
+ *   one is dropped: only the newest state is worth saving
+ *
+ * ATOMIC:
+ * Every write goes to "<path>.tmp" first, is flushed and fsync'ed, and is
+ * then renamed over the old file (which replaces it in one step), and the
+ * directory is synced. A crash at any moment leaves either the previous
+ * checkpoint or the new one - never half a file or an empty one. If the
+ * rename fails the previous checkpoint is left as it was.
+ *
+ * flush() waits until everything submitted so far is on disk; the
+ * destructor flushes too.
+ */
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const std::string& path);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    void submit(std::string contents);
+    void flush();
+
+    const std::string& getPath() const { return path; }
+    int getWrites() const;    // Files written
+    int getDropped() const;   // Checkpoints replaced before they were written
+    int getFailures() const;  // Writes that could not be completed
+
+    // Write 'contents' to 'path' through a temporary file and a rename
+    static bool writeAtomically(const std::string& path, const std::string& contents);
+
+private:
+    std::string path;
+    std::string pending;     // Newest checkpoint, not yet picked up
+    std::string writing;     // The one the writer thread is saving
+    bool hasPending;
+    bool busy;
+    bool stopping;
+    int writes;
+    int dropped;
+    int failures;
+
+    mutable std::mutex lock;
+    std::condition_variable changed;
+    std::thread writer;
+
+    void writerLoop();
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef COMPOSITIONDECK_H
+#define COMPOSITIONDECK_H
+
+#include "Shoe.h"
+#include "ShoeState.h"
+#include "Rng.h"
+
+/*
+ * COMPOSITIONDECK CLASS
+ * ---------------------
+ * A Shoe that stores only how many cards of each rank are left.
+ *
+ * COMPARED WITH DECK:
+ * - Deck creates all 'deckSize' Card objects up front (linear memory and time)
+ * - CompositionDeck keeps a ShoeState (13 counts) and creates a Card object
+ *   only at the moment it is drawn
+ * - Memory and construction time are constant for any shoe size
+ *
+ * Cards are drawn WITHOUT replacement by weighted sampling over the counts,
+ * so the shoe behaves like a real, finite, shuffled shoe.
+ */
+class CompositionDeck : public Shoe {
+private:
+    ShoeState state;   // Remaining rank counts
+    Rng rng;           // Private random stream for draws and suits
+    int fullSize;      // Cards in a new shoe (for refill)
+
+public:
+    CompositionDeck(int size, uint64_t seed);
+
+    Card* drawCard() override;
+    int getSize() const override;
+    bool isEmpty() const override;
+    void refill(uint64_t seed) override;
+    void saveState(ByteWriter& out) const override;  // 13 counts + the Rng
+    void loadState(ByteReader& in) override;
+
+    // Read-only view of the remaining composition (for solvers)
+    const ShoeState& getState() const;
+
+    /*
+     * SNAPSHOT / RESTORE:
+     * The whole shoe is ShoeState + Rng (about 64 bytes), so saving and
+     * restoring it is a plain copy. Restoring also rewinds the random
+     * stream, so the same cards come out again in the same order.
+     */
+    struct Snapshot {
+        ShoeState state;
+        Rng rng;
+    };
+
+    Snapshot snapshot() const;
+    void restore(const Snapshot& saved);
+};
+
+#endif
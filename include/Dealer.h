@@ -34,8 +34,8 @@ public:
     // Takes ownership of strategy via move semantics
     Dealer(std::unique_ptr<DrawStrategy> s);
 
-    // Delegates decision to strategy object
-    bool shouldDraw();
+    // Delegates decision to strategy object (with the shoe's Hi-Lo count)
+    bool shouldDraw(int runningCount = 0);
 };
 
 #endif
@@ -0,0 +1,53 @@
+#ifndef DECISIONTABLE_H
+#define DECISIONTABLE_H
+
+#include "PlayerPolicy.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/*
+ * DECISIONTABLE CLASS
+ * -------------------
+ * A player policy stored as a lookup table: one Hit/Stand choice for every
+ * (hard or soft total, dealer upcard). This is how a learned or solved
+ * strategy is handed to the simulator.
+ *
+ * FILE FORMAT (plain text, one row per total):
+ *   blackjack-decision-table 1
+ *   hard 12 HHSSSHHHHH
+ *   soft 18 HSSSSSSSHH
+ *   ...
+ * Columns are the dealer upcard A, 2, 3, ... 9, 10 (all ten-value cards).
+ * Missing rows keep the default (hit below 17, stand from 17).
+ * Reading a bad file throws TableFormatException.
+ */
+class DecisionTable : public PlayerPolicy {
+public:
+    static const int MAX_TOTAL = 21;
+    static const int UPCARDS = 10;
+
+    DecisionTable();
+
+    PlayerAction decide(const HandState& hand, int dealerUpcard, const ShoeState& shoe) const override;
+    uint64_t identity() const override;  // Hash of every cell
+
+    PlayerAction get(bool soft, int total, int upcard) const;
+    void set(bool soft, int total, int upcard, PlayerAction action);
+
+    void save(std::ostream& out) const;
+    void saveFile(const std::string& path) const;
+    static DecisionTable load(std::istream& in);
+    static DecisionTable loadFile(const std::string& path);
+
+    // Upcard rank 1-13 -> table column 1-10
+    static int column(int upcardRank) { return upcardRank > UPCARDS ? UPCARDS : upcardRank; }
+
+private:
+    static const char* const HEADER;
+    static const int VERSION = 1;
+
+    uint8_t hit[2][MAX_TOTAL + 1][UPCARDS + 1];  // [soft][total][upcard], 1 = Hit
+};
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "Card.h"
 #include "CardFactory.h"
+#include "Rng.h"
+#include "Shoe.h"
 
 /*
  * DECK CLASS
@@ -13,19 +15,40 @@
  * - Uses Card** to store polymorphic Card objects
  * - Enables storing different card types (NormalCard, FaceCard, AceCard) together
  * - Dynamic allocation allows deck size to be set at runtime
+ *
+ * Implements the Shoe interface; see CompositionDeck for the
+ * constant-memory alternative used for very large shoes.
+ *
+ * RANDOMNESS:
+ * - Every card is an independent, uniformly random one of the 52 card
+ *   types, drawn from a seeded Rng with Lemire's unbiased method
+ *   ('rand() % 13' favoured some ranks whenever RAND_MAX + 1 is not a
+ *   multiple of 13)
+ * - randomCard() is THE way a card type is chosen; ShuffleAudit calls it
+ *   with the same seeds to test billions of shoes without allocating
  */
-class Deck {
+class Deck : public Shoe {
 private:
     Card** cards;       // Pointer to array of Card pointers (dynamic array)
     int capacity;       // Total number of cards created
     int currentIndex;   // Index of next card to draw
 
+    void fill(uint64_t seed);  // Create every card from 'seed'
+
 public:
-    Deck(int s);
-    Card* drawCard();       // Returns ownership of card to caller
-    int getSize() const;    // Cards remaining
-    bool isEmpty() const;   // Check if deck is empty
-    ~Deck();                // Cleans up remaining cards
+    static const int CARD_TYPES = 52;   // Type c is rank c % 13 + 1 of suit c / 13
+
+    Deck(int s, uint64_t seed);
+    static int randomCard(Rng& rng) { return static_cast<int>(rng.below(CARD_TYPES)); }
+    static const string& suitName(int suit);
+
+    Card* drawCard() override;       // Returns ownership of card to caller
+    int getSize() const override;    // Cards remaining
+    bool isEmpty() const override;   // Check if deck is empty
+    void refill(uint64_t seed) override;  // Reuses the Card* array
+    void saveState(ByteWriter& out) const override;  // One byte per card left
+    void loadState(ByteReader& in) override;
+    ~Deck() override;                // Cleans up remaining cards
 };
 
 #endif
@@ -1,11 +1,19 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include "Deck.h"
+#include "Shoe.h"
 #include "Player.h"
 #include "Dealer.h"
 #include "Strategy.h"
 #include "GameConfig.h"  // For game configuration
+#include "Rules.h"       // Compile-time rule sets
+#include "MatchOdds.h"   // Chance of winning the whole game
+#include "HintEngine.h"  // Live hit/stand advice
+#include "StrategyTables.h" // Solved tables shared between processes
+#include "Metrics.h"     // Latency histograms for hosted tables
+#include "ShoePipeline.h" // Next shoes are built in the background
+#include "RuleTable.h"   // Dealer rules loaded from a text file
+#include <iostream>      // Player decisions come from std::cin or a script
 #include <memory>        // For smart pointers
 
 /*
@@ -30,6 +38,20 @@
  * - Points-based scoring system
  * - Multiple round support
  * - Score tracking across the game
+ * - Chance of winning the game from the current score (MatchOdds)
+ * - Optional hit/stand hints within a time budget (HintEngine)
+ * - Optional rules (double down, split, surrender, natural payouts,
+ *   dealer hits soft 17) chosen by GameConfig::ruleVariant
+ * - Optional dealer behaviour from a rule file (GameConfig::dealerRulesFile),
+ *   compiled once when the Game is created
+ * - Save and load the whole game in a few hundred bytes, so a host can
+ *   move idle tables to disk (see SessionStore.h)
+ *
+ * RULE SETS AS TEMPLATES:
+ * The round functions are templates on a rule set type (see Rules.h).
+ * play() picks the rule set once per round, and inside the round every
+ * "is this rule on?" test is a compile-time constant, so rules that are
+ * switched off are not in the compiled code at all.
  *
  * DESIGN CONSIDERATIONS:
  * - Single Responsibility: Game handles game flow, not card/player logic
@@ -42,23 +64,49 @@ private:
      * unique_ptr automatically manages memory - no manual delete needed.
      * When Game is destroyed, these objects are automatically cleaned up.
      */
-    std::unique_ptr<Deck> deck;       // Smart pointer to deck
+    std::unique_ptr<Shoe> deck;       // Smart pointer to deck (any Shoe backend)
     std::unique_ptr<Player> player;   // Smart pointer to player
     std::unique_ptr<Dealer> dealer;   // Smart pointer to dealer
+    std::unique_ptr<Player> splitHand; // Second hand after a split (empty otherwise)
+    std::unique_ptr<HintEngine> hints; // Only created when config.showHints is set
+
+    // Points can be fractional with some rule sets (3:2 naturals, surrender)
+    double playerPoints = 0;
+    double dealerPoints = 0;
 
-    int playerPoints = 0;
-    int dealerPoints = 0;
+    double stakes[2] = {1.0, 1.0};    // Points riding on each hand this round
+    bool surrendered = false;          // Player gave up this round
+    bool splitAces = false;            // Split Aces only get one card each
 
     GameConfig config;  // Stores all game settings (SCALABILITY)
+    std::shared_ptr<const StrategyTables> tables; // Memory-mapped solver results, one copy per rule set
+    std::shared_ptr<const MatchOdds> matchOdds;   // Built from the tables, looked up after every round
+    MetricsSession session;    // Counted in Metrics::global() while the game runs
+                               // (latencies go to the recorder of whichever thread plays)
+    ShoePipeline shoes;        // Ready-built shoes, so a reshuffle is a pointer swap
+                               // (built by the process-wide ShoeProducer, no thread per Game)
+    std::shared_ptr<const RuleTable> dealerRules;  // Only set with config.dealerRulesFile
+    int runningCount = 0;      // Hi-Lo count of the cards dealt from this shoe
+    std::istream* input = &std::cin;  // Where the player's decisions come from
 
     // Private helper methods for cleaner code organisation
     void displayWelcome();
     void startRound();
     void dealInitialCards();
-    void playerTurn();
-    void dealerTurn();
-    void determineWinner();
     void resetRound();
+    std::unique_ptr<Dealer> newDealer() const;  // Dealer with the configured strategy
+    Card* drawCard();     // Draws from the deck and tells the hint engine
+    void showHint(Player& hand);
+    static void saveHand(ByteWriter& out, const Player& hand);
+    static void loadHand(ByteReader& in, Player& hand);
+
+    void playRuleRound();  // Picks the rule set, then plays one round with it
+
+    // Round steps, compiled once per rule set
+    template <typename Rules> void playRound();
+    template <typename Rules> void playerTurn(Player& hand, int handIndex);
+    template <typename Rules> void dealerTurn();
+    template <typename Rules> void determineWinner();
 
 public:
     // Default constructor - uses default settings
@@ -69,6 +117,31 @@ public:
 
     ~Game() = default;  // Smart pointers handle cleanup automatically
     void play();        // Main game loop
+
+    // One round whose decisions ('h', 's', 'd', 'p', 'u') are read from
+    // 'answers' instead of the keyboard - for a host relaying a remote
+    // player, or to build up game state. Clears the previous round's hands
+    // first; the table output still goes to cout.
+    void playScriptedRound(std::istream& answers);
+
+    /*
+     * SAVED SESSIONS:
+     * saveSession appends the config, the score, the round in progress
+     * (hands, stakes, split and surrender state), the running count and
+     * the shoe to 'out'. loadSession builds a Game that carries on exactly
+     * where the saved one stopped, drawing the same cards.
+     *
+     * Rebuilt rather than saved: the hint engine's caches and the ready
+     * shoes of the pipeline (a fresh random stream). The strategy tables
+     * and match odds are not rebuilt at all: every Game with the same
+     * rules shares one copy, so loading one is a lookup.
+     */
+    void saveSession(std::string& out) const;
+    static std::unique_ptr<Game> loadSession(const std::string& data);  // Throws TableFormatException
+
+    double getPlayerPoints() const { return playerPoints; }
+    double getDealerPoints() const { return dealerPoints; }
+    int getCardsLeft() const { return deck->getSize(); }
 };
 
 #endif
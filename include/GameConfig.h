@@ -1,6 +1,7 @@
 #ifndef GAMECONFIG_H
 #define GAMECONFIG_H
 
+#include "Rules.h"
 #include <string>
 
 /*
@@ -13,6 +14,7 @@ struct GameConfig {
     // === DECK SETTINGS ===
     int deckSize = 52;              // How many cards in the deck
     int reshuffleThreshold = 10;    // Recreate deck when fewer than this many cards remain
+    bool useCompositionDeck = false; // true = CompositionDeck (rank counts), false = Deck (Card objects)
 
     // === SCORE SETTINGS ===
     int targetScore = 5;            // First to this many points wins
@@ -20,10 +22,39 @@ struct GameConfig {
     // === DEALER SETTINGS ===
     bool useAggressiveDealer = true;  // true = aggressive, false = conservative
 
+    // Dealer behaviour as text rules (see RuleTable.h), compiled at startup.
+    // Empty = the built-in strategy chosen by useAggressiveDealer.
+    std::string dealerRulesFile = "";
+
+    // === RULE SETTINGS ===
+    // Which pre-built rule set to play (see Rules.h). Classic = hit/stand only.
+    RuleVariant ruleVariant = RuleVariant::Classic;
+
+    // === SIMULATION SETTINGS ===
+    // Headless simulations have no human at the keyboard, so the player
+    // keeps hitting until reaching this score (like a dealer strategy).
+    int playerStandThreshold = 17;
+
+    // Simulations stop once the 95% confidence interval on the player edge
+    // (points per round) is narrower than this. 0 = always run to the maximum.
+    double targetEdgeCIWidth = 0.01;
+    long long maxSimulationRounds = 100000000;  // Hard upper limit for one run
+
+    // === TABLE SETTINGS ===
+    // Where solved strategy tables are saved and shared (see StrategyTables.h).
+    // Empty = solve in memory for each Game (well under a millisecond), so
+    // nothing is written unless a directory is chosen.
+    std::string tableDirectory = "";
+
     // === DISPLAY SETTINGS ===
     std::string welcomeMessage = "Welcome to the Card Game: Blackjack (Score Mode)";
     bool showDetailedScores = true;
 
+    // Live hit/stand advice at each prompt (see HintEngine.h). If the exact
+    // answer takes longer than the budget, a precomputed one is shown.
+    bool showHints = false;
+    int hintBudgetMicros = 1000;
+
     GameConfig() = default;
 };
 
@@ -35,6 +66,7 @@ inline GameConfig createEasyConfig() {
     GameConfig config;
     config.targetScore = 3;
     config.useAggressiveDealer = false;
+    config.showHints = true;            // Beginners get advice at every prompt
     config.welcomeMessage = "Welcome to the Card Game: Blackjack (Easy Mode)";
     return config;
 }
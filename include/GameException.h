@@ -66,5 +66,47 @@ public:
     }
 };
 
+// Exception thrown when a saved table, checkpoint or session file cannot be read
+class TableFormatException : public std::exception {
+private:
+    std::string message;
+
+public:
+    TableFormatException(const std::string& msg = "Invalid table file!")
+        : message(msg) {}
+
+    const char* what() const noexcept override {
+        return message.c_str();
+    }
+};
+
+// Exception thrown when strategy rule text cannot be compiled (see RuleTable.h)
+class RuleFormatException : public std::exception {
+private:
+    std::string message;
+
+public:
+    RuleFormatException(const std::string& msg = "Invalid strategy rules!")
+        : message(msg) {}
+
+    const char* what() const noexcept override {
+        return message.c_str();
+    }
+};
+
+// Exception thrown when a simulation worker process keeps failing
+class ShardFailedException : public std::exception {
+private:
+    std::string message;
+
+public:
+    ShardFailedException(const std::string& msg = "A simulation shard failed!")
+        : message(msg) {}
+
+    const char* what() const noexcept override {
+        return message.c_str();
+    }
+};
+
 #endif
 
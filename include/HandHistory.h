@@ -0,0 +1,99 @@
+#ifndef HANDHISTORY_H
+#define HANDHISTORY_H
+
+#include "RoundStats.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * HANDRECORD STRUCT
+ * -----------------
+ * One logged round in 8 bytes - a RoundRecord squeezed into the ranges it
+ * can actually take. Billions of rounds stay a few gigabytes.
+ */
+struct HandRecord {
+    enum Flag : uint8_t {
+        OpeningSoft = 1,   // The two-card hand counted an Ace as 11
+        PlayerBust = 2,
+        DealerBust = 4,
+        PlayerSoft = 8,    // Final hand counted an Ace as 11
+        Doubled = 16,
+        Split = 32,
+        Surrendered = 64
+    };
+
+    uint8_t openingTotal;  // Two-card total (RoundRecord::playerStart)
+    uint8_t playerScore;
+    uint8_t dealerScore;
+    uint8_t dealerUpcard;  // Rank 1-13
+    uint8_t playerCards;
+    uint8_t dealerCards;
+    uint8_t flags;
+    int8_t netHalves;      // Net points x 2 (naturals pay 1.5)
+
+    static HandRecord fromRound(const RoundRecord& round);
+
+    bool has(Flag flag) const { return (flags & flag) != 0; }
+    double net() const { return netHalves / 2.0; }
+    int upcardValue() const { return dealerUpcard > 10 ? 10 : dealerUpcard; }  // 1 = Ace ... 10
+};
+
+static_assert(sizeof(HandRecord) == 8, "HandRecord must stay 8 bytes");
+static_assert(std::is_trivially_copyable<HandRecord>::value, "HandRecord is written as raw bytes");
+
+/*
+ * HAND OUTCOME
+ * ------------
+ * How a round ended for the player - one of the index buckets.
+ */
+enum class HandOutcome {
+    PlayerBust,
+    DealerBust,   // Player won because the dealer bust
+    Win,          // Player won on points
+    Tie,
+    Loss,         // Dealer won on points
+    Surrender,
+    COUNT
+};
+
+HandOutcome outcomeOf(const HandRecord& record);
+const char* outcomeName(HandOutcome outcome);
+
+/*
+ * HANDLOG CLASS
+ * -------------
+ * The hand-history file: a 16-byte header ("BJHANDS1", version, record
+ * size) followed by HandRecords, oldest first. Logs only ever grow - new
+ * rounds are appended at the end, which is what lets HandIndex update
+ * itself incrementally.
+ */
+class HandLog {
+public:
+    static const uint32_t VERSION = 1;
+    static const long long HEADER_BYTES = 16;
+
+    // Opens for appending; creates the file (and header) if needed. A
+    // partial record at the end (a crash mid-write) is cut off first. With
+    // keepRecords >= 0 the log is cut back to that many records (resuming
+    // from a checkpoint); it throws TableFormatException if it holds fewer
+    explicit HandLog(const std::string& path, long long keepRecords = -1);
+
+    void append(const std::vector<HandRecord>& records);
+    void flush();
+    long long getRecords() const { return length; }  // Records in the file, appended ones included
+
+    // Number of records in a log file (0 if missing); throws TableFormatException if it is not a log
+    static long long recordCount(const std::string& path);
+    // Reads records [first, first + count) from an open log file
+    static bool readRecords(std::ifstream& file, long long first, long long count, std::vector<HandRecord>& out);
+
+private:
+    std::ofstream file;
+    std::string path;
+    long long length;   // Records in the file
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef HANDINDEX_H
+#define HANDINDEX_H
+
+#include "HandHistory.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * HAND QUERY
+ * ----------
+ * Which rounds to count. 0 / -1 mean "any". The first four fields are the
+ * index buckets; the card-count ranges need the records themselves.
+ */
+struct HandQuery {
+    int openingTotal = 0;      // Two-card total, e.g. 16
+    int soft = -1;             // 0 = hard, 1 = soft opening hand
+    int upcard = 0;            // 1 = Ace ... 10 (faces count as 10)
+    unsigned outcomes = ~0u;   // Bit per HandOutcome
+    int minDealerCards = 0;
+    int maxDealerCards = 255;
+    int minPlayerCards = 0;
+    int maxPlayerCards = 255;
+    int show = 0;              // Also return the first N matching records
+
+    bool bucketsOnly() const;  // Answerable from the index alone
+    bool matchesBucket(int total, bool isSoft, int up, HandOutcome outcome) const;
+    bool matches(const HandRecord& record) const;
+};
+
+struct HandMatch {
+    long long position;  // Record number in the log
+    HandRecord record;
+};
+
+struct HandQueryResult {
+    long long rounds = 0;                                     // Matching rounds
+    long long outcomes[static_cast<int>(HandOutcome::COUNT)] = {};
+    long long netHalves = 0;                                  // Sum of net points x 2
+    long long blocksFromIndex = 0;  // Answered from block summaries
+    long long blocksScanned = 0;    // Records read
+    long long blocksSkipped = 0;    // Ruled out by the index
+    long long tailRecords = 0;      // Newest records, not yet in a full block
+    std::vector<HandMatch> matches; // Up to HandQuery::show, in log order
+    double seconds = 0.0;
+
+    double rate(HandOutcome outcome) const {
+        return rounds > 0 ? static_cast<double>(outcomes[static_cast<int>(outcome)]) / rounds : 0.0;
+    }
+    double meanNet() const { return rounds > 0 ? netHalves / (2.0 * rounds) : 0.0; }
+};
+
+/*
+ * HANDINDEX CLASS
+ * ---------------
+ * A columnar SIDECAR INDEX ("<log>.idx") for a HandLog, so questions like
+ * "bust rate with hard 16 against a 10" do not need to read every round.
+ *
+ * BLOCKS AND BUCKETS:
+ * - The log is split into blocks of BLOCK_RECORDS rounds
+ * - For every full block the index keeps one BlockSummary: the number of
+ *   rounds and their summed net points in each BUCKET
+ *       (opening total, soft flag, dealer upcard, outcome)
+ *   stored column by column (all counts, then all net sums), plus the
+ *   min/max card counts seen in the block (a "zone map")
+ *
+ * QUERIES:
+ * - Only bucket fields asked for: add up the matching buckets of every
+ *   block - no records are read at all
+ * - Card-count ranges too: blocks with no matching bucket, or whose card
+ *   counts cannot match, are skipped; the rest are read and filtered on a
+ *   ThreadPool, one task per block, and merged in block order
+ * - Rounds after the last full block are always read directly
+ *
+ * INCREMENTAL:
+ * update() only summarises the blocks added since the last update - the
+ * summaries are appended and then the header's block count is raised, so
+ * an interrupted update just redoes its last blocks. A missing, foreign or
+ * outdated index is rebuilt, and so is one written for a different log:
+ * the header keeps a hash of the log's header and first block, and update()
+ * starts over when the log at the path no longer matches it.
+ */
+class HandIndex {
+public:
+    static const uint32_t VERSION = 2;  // 2: the header names the log it describes
+    static const long long BLOCK_RECORDS = 1 << 18;
+    static const int TOTALS = 22;    // Opening totals 0-21
+    static const int UPCARDS = 11;   // 1-10 (0 unused)
+    static const int OUTCOMES = static_cast<int>(HandOutcome::COUNT);
+    static const int BUCKETS = TOTALS * 2 * UPCARDS * OUTCOMES;
+
+    struct BlockSummary {
+        uint32_t counts[BUCKETS];
+        int32_t netHalves[BUCKETS];
+        uint8_t minDealerCards, maxDealerCards;
+        uint8_t minPlayerCards, maxPlayerCards;
+        uint8_t padding[4];
+    };
+
+    explicit HandIndex(const std::string& logPath);
+
+    long long update();  // Returns the number of blocks added
+    HandQueryResult query(const HandQuery& query, int threads) const;
+
+    long long getIndexedBlocks() const { return static_cast<long long>(blocks.size()); }
+    const std::string& getIndexPath() const { return indexPath; }
+
+    static int bucketOf(int total, bool soft, int upcard, HandOutcome outcome);
+    static int bucketOf(const HandRecord& record);
+
+private:
+    std::string logPath;
+    std::string indexPath;
+    std::vector<BlockSummary> blocks;
+    uint64_t indexedLog;  // logIdentity() of the log the summaries describe
+
+    void load();
+    uint64_t logIdentity() const;  // 0 until the log has a full block
+    static void summarise(const std::vector<HandRecord>& records, BlockSummary& summary);
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef HINTENGINE_H
+#define HINTENGINE_H
+
+#include "Card.h"
+#include "GameConfig.h"
+#include "Player.h"
+#include "Solver.h"
+#include "StrategyTables.h"
+#include <future>
+
+/*
+ * HINT STRUCT
+ * -----------
+ * Expected points of standing and of hitting for the player's hand.
+ */
+struct Hint {
+    ActionValues values;
+    bool exact = false;     // false = taken from the precomputed table
+    double micros = 0.0;    // Time spent producing the hint
+};
+
+/*
+ * HINTENGINE CLASS
+ * ----------------
+ * Live "hit or stand?" advice for the interactive game, produced within a
+ * fixed time budget (GameConfig::hintBudgetMicros).
+ *
+ * TWO SOURCES:
+ * - TABLE: the saved StrategyTables hold hit/stand values for every total
+ *   (hard and soft) against every dealer upcard, assuming an infinite
+ *   deck. Looking one up costs nothing.
+ * - EXACT: with a CompositionDeck the real odds depend on which cards are
+ *   left, so the Solver is run on the current shoe. It runs on a helper
+ *   thread; if it is not finished within the budget the table value is
+ *   shown instead and the exact solve keeps going in the background.
+ *   With the normal Deck every card is random, so the table IS exact.
+ *
+ * Both sources play the dealer by the game's rules, including hitting
+ * soft 17 under the Vegas rule set. The values are for hit/stand only:
+ * a natural's 3:2 payout, doubling and splitting are not included.
+ *
+ * INCREMENTAL UPDATES:
+ * - Game reports every card that leaves the shoe (cardDrawn), so the
+ *   engine keeps its own copy of the shoe up to date card by card
+ * - The Solver caches live as long as the engine. After a hit, the new
+ *   position was already a branch of the previous prompt's solve, so the
+ *   next answer is mostly cache hits instead of a fresh calculation
+ */
+class HintEngine {
+public:
+    HintEngine(const GameConfig& config, const StrategyTables& tables);
+
+    void newShoe();                      // The deck was replaced
+    void cardDrawn(const Card& card);    // A card left the deck
+    void resumeShoe(const ShoeState& remaining);  // A saved game was loaded mid-shoe
+    Hint hint(Player& hand, Player& dealer);
+
+    // Solver rank (1-13) of a Card object
+    static int rankOf(const Card& card);
+
+private:
+    static const int UPCARDS = 10;       // Ace, 2-9 and all ten-value cards
+
+    GameConfig config;
+    const StrategyTables& tables;        // Kept alive by Game
+    bool finiteShoe;
+    long long budgetMicros;
+    ShoeState shoe;                      // Cards still in the deck (finite shoe only)
+    Solver::DealerCache dealerCache;     // Shared by every exact solve
+    Solver::PlayerCache playerCache;
+    std::future<ActionValues> pending;   // Exact solve still running, if any
+
+    static HandState handOf(Player& hand);
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+
+/*
+ * LATENCYHISTOGRAM CLASS
+ * ----------------------
+ * Fixed-size HDR-style ("high dynamic range") histogram of durations in
+ * nanoseconds, with about 3% precision from 1 ns up to ~18 minutes.
+ *
+ * BUCKETS (log-linear):
+ * - Values below 32 get one bucket each
+ * - Above that, every power of two is split into 16 equal sub-buckets,
+ *   so a bucket is never wider than 1/16 of its value
+ * A value's bucket comes from its highest set bit plus the next four
+ * bits - a couple of shifts, no search, no floating point.
+ *
+ * SINGLE WRITER:
+ * Each histogram belongs to one thread (see MetricsRecorder). record()
+ * is a relaxed load + store on that thread's own counters - no locks, no
+ * read-modify-write, no allocation. Readers (the metrics endpoint) may
+ * copy it at any time with snapshot(); they see every finished record.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BITS = 5;
+    static const int LINEAR = 1 << SUB_BITS;       // 32 exact buckets
+    static const int HALF = LINEAR / 2;            // Sub-buckets per power of two
+    static const int MAX_BIT = 40;                 // Larger values go in the last bucket
+    static const int BUCKETS = LINEAR + (MAX_BIT - SUB_BITS + 1) * HALF;
+
+    /*
+     * SNAPSHOT
+     * A plain (non-atomic) copy that can be merged and queried.
+     */
+    struct Snapshot {
+        uint64_t counts[BUCKETS];
+        uint64_t count;
+        uint64_t sum;   // Nanoseconds
+
+        Snapshot();
+        void merge(const Snapshot& other);
+        uint64_t quantile(double q) const;  // Upper edge of the bucket holding quantile q
+    };
+
+    LatencyHistogram();
+
+    void record(uint64_t nanos) {
+        bump(counts[bucketOf(nanos)], 1);
+        bump(count, 1);
+        bump(sum, nanos);
+    }
+
+    Snapshot snapshot() const;
+
+    static int bucketOf(uint64_t value);
+    static uint64_t bucketUpperBound(int bucket);
+
+private:
+    std::atomic<uint64_t> counts[BUCKETS];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+
+    // Only the owning thread writes, so a plain load + store is enough
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef MATCHODDS_H
+#define MATCHODDS_H
+
+#include "GameConfig.h"
+#include "Solver.h"
+#include <vector>
+
+/*
+ * MATCHODDS CLASS
+ * ---------------
+ * Chance of winning the WHOLE GAME (first to targetScore points) from any
+ * score, built from the odds of a single round.
+ *
+ * AN APPROXIMATION:
+ * Every round is treated as independent, with the odds of a round dealt
+ * from a FRESH shoe. In the game the shoe carries over from round to
+ * round until fewer than reshuffleThreshold cards are left, so the real
+ * odds of a round drift with what has already been dealt. With Deck
+ * (every card independent) nothing drifts and the numbers are exact; with
+ * a finite CompositionDeck they are a close approximation.
+ *
+ * THE SCORE LATTICE:
+ * Every state is a pair (playerPoints, dealerPoints). A round moves it
+ * one step right (player wins, probability w), one step up (dealer wins,
+ * probability l) or leaves it where it is (tie). Ties only delay the
+ * match, so from every state:
+ *
+ *     P(a, b) = (w * P(a + 1, b) + l * P(a, b + 1)) / (w + l)
+ *
+ * with P = 1 once the player reaches the target and P = 0 once the
+ * dealer does. Filling the table from the target backwards (dynamic
+ * programming) needs targetScore^2 steps - microseconds for any preset.
+ *
+ * The expected number of rounds left uses the same recurrence:
+ *
+ *     E(a, b) = (1 + w * E(a + 1, b) + l * E(a, b + 1)) / (w + l)
+ *
+ * Points are whole numbers, as with the Classic rules. If no round can
+ * ever be decided (w + l = 0) the match never ends: both the win and the
+ * loss probability are 0 and the expected length is infinite.
+ */
+class MatchOdds {
+public:
+    MatchOdds(int targetScore, const Outcome& round);
+
+    double winProbability(int playerPoints, int dealerPoints) const;
+    double lossProbability(int playerPoints, int dealerPoints) const;
+    double expectedRounds(int playerPoints, int dealerPoints) const;
+
+    int getTargetScore() const { return targetScore; }
+    const Outcome& getRoundOdds() const { return round; }
+
+    // Round odds with best play on a fresh shoe, from the exact Solver
+    static Outcome roundOdds(const GameConfig& config);
+
+private:
+    int targetScore;
+    Outcome round;
+    std::vector<double> win;     // [playerPoints * targetScore + dealerPoints]
+    std::vector<double> rounds;  // Expected rounds left, same layout
+
+    int index(int playerPoints, int dealerPoints) const { return playerPoints * targetScore + dealerPoints; }
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef MCTSPOLICY_H
+#define MCTSPOLICY_H
+
+#include "GameConfig.h"
+#include "PlayerPolicy.h"
+#include "Rng.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+/*
+ * SEARCH BUDGET
+ * -------------
+ * A search stops at whichever limit is reached first.
+ */
+struct MctsOptions {
+    long long rollouts = 20000;   // Total rollouts per decision (all threads together)
+    long long timeMicros = 0;     // Time limit per decision, 0 = no time limit
+    int threads = 1;              // Independent search trees run in parallel
+    double exploration = 1.4;     // UCB1 exploration constant
+    uint64_t seed = 1;
+};
+
+// What a search found for one position
+struct MctsResult {
+    PlayerAction action = PlayerAction::Stand;
+    double value = 0.0;           // Estimated points for 'action' (stake 1)
+    long long rollouts = 0;       // Rollouts actually played
+};
+
+/*
+ * MCTS POLICY
+ * -----------
+ * A player that thinks by PLAYING THE HAND OUT many times
+ * (Monte Carlo Tree Search) instead of following a fixed table.
+ *
+ * ONE ROLLOUT:
+ * 1. Copy the shoe and the player's hand
+ * 2. At every decision pick Stand/Hit with UCB1: the action with the best
+ *    average so far, plus a bonus for actions that have been tried less
+ *        mean + c * sqrt(ln(visits) / actionVisits)
+ * 3. Let the dealer finish with the REAL dealer rules: the threshold of
+ *    the configured DrawStrategy (and hit soft 17 for the Vegas rules)
+ * 4. Score the round and add the result to every decision on the path
+ *
+ * The "tree" is a table of decision points keyed by (total, soft, cards),
+ * so identical hands reached by different cards share their statistics.
+ *
+ * ROOT PARALLELISM:
+ * With several threads, each thread grows its OWN tree from its own random
+ * stream on the ThreadPool. At the end the root counts are added together
+ * and the action with the best average wins - no locks during the search.
+ *
+ * The random streams come from the position itself, so with a rollout
+ * budget (no time limit) the same position always gets the same answer.
+ * Doubling is searched at the root when the rule set allows it.
+ */
+class MctsPolicy : public PlayerPolicy {
+public:
+    MctsPolicy(const GameConfig& config, const MctsOptions& options);
+
+    PlayerAction decide(const HandState& hand, int dealerUpcard, const ShoeState& shoe) const override;
+    uint64_t identity() const override;  // Search budget, threads, exploration and seed
+    MctsResult search(const HandState& hand, int dealerUpcard, const ShoeState& shoe) const;
+
+private:
+    static const int ROOT_ACTIONS = 3;  // Stand, Hit, Double
+
+    // Root statistics of one search tree
+    struct RootStats {
+        long long visits[ROOT_ACTIONS] = {};
+        double total[ROOT_ACTIONS] = {};
+        long long rollouts = 0;
+    };
+
+    typedef std::chrono::steady_clock Clock;
+
+    MctsOptions options;
+    int deckSize;
+    int dealerThreshold;
+    bool finiteShoe;
+    bool hitSoft17;
+    bool allowDouble;
+    std::unique_ptr<ThreadPool> pool;   // Only created for more than one thread
+
+    RootStats searchTree(const HandState& hand, int dealerUpcard, const ShoeState& shoe,
+                         Rng rng, long long rollouts, Clock::time_point deadline) const;
+    int drawRank(ShoeState& shoe, Rng& rng) const;
+};
+
+#endif
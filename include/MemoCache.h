@@ -0,0 +1,254 @@
+#ifndef MEMOCACHE_H
+#define MEMOCACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+/*
+ * MEMOCACHE CLASS TEMPLATE
+ * ------------------------
+ * A fixed-size hash table shared by many threads, used to remember the
+ * answers to solver subproblems (shoe composition + hands -> result).
+ *
+ * WHY NOT std::unordered_map + std::mutex:
+ * - Every lookup would take the lock, so threads queue up behind each other
+ * - The map grows without limit
+ *
+ * HOW IT WORKS:
+ * - READS NEVER LOCK. Each slot has a version number (a "seqlock"):
+ *   the reader copies the slot, then checks the version did not change
+ *   while it was copying. If it did, the read counts as a miss.
+ * - WRITES claim a slot by making its version odd with compare-and-swap.
+ *   If another thread is already writing that slot, the insert is simply
+ *   skipped - losing a cache entry is always safe.
+ * - BOUNDED MEMORY: the table never grows. Slots are grouped in buckets of
+ *   WAYS; when a bucket is full, the CLOCK ("second chance") policy evicts
+ *   a slot that has not been read since the hand last passed it.
+ *
+ * KEYS are 64-bit hashes (see ShoeState::hash). Key 0 marks an empty slot.
+ * Value must be trivially copyable; it is stored as 64-bit atomic words so
+ * the lock-free copy is well defined C++.
+ */
+
+struct MemoCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;
+
+    double hitRate() const {
+        uint64_t lookups = hits + misses;
+        return lookups > 0 ? static_cast<double>(hits) / lookups : 0.0;
+    }
+};
+
+template <typename Value>
+class MemoCache {
+    static_assert(std::is_trivially_copyable<Value>::value, "MemoCache values must be trivially copyable");
+
+public:
+    static const int WAYS = 4;  // Slots per bucket
+
+    // 'capacity' is rounded up to a power of two number of slots
+    explicit MemoCache(size_t capacity)
+        : bucketCount(roundUpBuckets(capacity)),
+          slots(allocateSlots(bucketCount * WAYS)),
+          hands(new std::atomic<uint32_t>[bucketCount]) {
+        for (size_t i = 0; i < bucketCount * WAYS; i++) {
+            new (&slots.get()[i]) Slot;
+            slots.get()[i].version.store(0, std::memory_order_relaxed);
+            slots.get()[i].key.store(0, std::memory_order_relaxed);
+            slots.get()[i].referenced.store(0, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < bucketCount; i++) {
+            hands[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    MemoCache(const MemoCache&) = delete;
+    MemoCache& operator=(const MemoCache&) = delete;
+
+    // Lock-free lookup. Returns true and fills 'out' on a hit.
+    bool find(uint64_t key, Value& out) {
+        key = normaliseKey(key);
+        Slot* bucket = &slots.get()[(key & (bucketCount - 1)) * WAYS];
+
+        for (int way = 0; way < WAYS; way++) {
+            Slot& slot = bucket[way];
+            uint64_t before = slot.version.load(std::memory_order_acquire);
+            if ((before & 1) != 0 || slot.key.load(std::memory_order_relaxed) != key) {
+                continue;
+            }
+
+            uint64_t words[WORDS];
+            for (int w = 0; w < WORDS; w++) {
+                words[w] = slot.words[w].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.version.load(std::memory_order_relaxed) == before) {
+                std::memcpy(&out, words, sizeof(Value));
+                slot.referenced.store(1, std::memory_order_relaxed);
+                hitCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        missCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Store a result. May silently drop it if the slot is busy.
+    void insert(uint64_t key, const Value& value) {
+        key = normaliseKey(key);
+        size_t bucketIndex = key & (bucketCount - 1);
+        Slot* bucket = &slots.get()[bucketIndex * WAYS];
+
+        int target = chooseSlot(bucketIndex, bucket, key);
+        Slot& slot = bucket[target];
+
+        // Claim the slot: even version -> odd version
+        uint64_t version = slot.version.load(std::memory_order_relaxed);
+        if ((version & 1) != 0 ||
+            !slot.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire)) {
+            return;  // Someone else is writing here - skip, it's only a cache
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint64_t oldKey = slot.key.load(std::memory_order_relaxed);
+        if (oldKey != 0 && oldKey != key) {
+            evictionCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint64_t words[WORDS] = {};
+        std::memcpy(words, &value, sizeof(Value));
+        slot.key.store(key, std::memory_order_relaxed);
+        for (int w = 0; w < WORDS; w++) {
+            slot.words[w].store(words[w], std::memory_order_relaxed);
+        }
+        slot.referenced.store(1, std::memory_order_relaxed);
+
+        // Publish: odd -> next even version
+        slot.version.store(version + 2, std::memory_order_release);
+        insertCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    MemoCacheStats getStats() const {
+        MemoCacheStats stats;
+        stats.hits = hitCount.load(std::memory_order_relaxed);
+        stats.misses = missCount.load(std::memory_order_relaxed);
+        stats.inserts = insertCount.load(std::memory_order_relaxed);
+        stats.evictions = evictionCount.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    size_t getCapacity() const { return bucketCount * WAYS; }
+
+    // Bytes used by the table (fixed for the cache's lifetime)
+    size_t getMemoryBytes() const { return bucketCount * (WAYS * sizeof(Slot) + sizeof(std::atomic<uint32_t>)); }
+
+private:
+    static const int WORDS = static_cast<int>((sizeof(Value) + 7) / 8);
+
+    // One cache line (or more) per slot so writers do not disturb neighbours
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> version;     // Odd while being written
+        std::atomic<uint64_t> key;         // 0 = empty
+        std::atomic<uint32_t> referenced;  // CLOCK "recently used" bit
+        std::atomic<uint64_t> words[WORDS];
+    };
+
+    static_assert(std::is_trivially_destructible<Slot>::value, "Slots are freed without destructors");
+
+    // C++14's new[] only promises alignof(std::max_align_t) (16 bytes), not
+    // alignas(64), so the slot array is allocated on a cache line by hand
+    struct SlotFree {
+        void operator()(Slot* memory) const {
+#if defined(_WIN32)
+            _aligned_free(memory);
+#else
+            std::free(memory);
+#endif
+        }
+    };
+
+    static Slot* allocateSlots(size_t count) {
+        void* memory = nullptr;
+#if defined(_WIN32)
+        memory = _aligned_malloc(count * sizeof(Slot), alignof(Slot));
+#else
+        if (posix_memalign(&memory, alignof(Slot), count * sizeof(Slot)) != 0) {
+            memory = nullptr;
+        }
+#endif
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<Slot*>(memory);
+    }
+
+    size_t bucketCount;
+    std::unique_ptr<Slot, SlotFree> slots;
+    std::unique_ptr<std::atomic<uint32_t>[]> hands;  // CLOCK hand per bucket
+
+    // Counters live on their own cache lines to avoid false sharing
+    alignas(64) std::atomic<uint64_t> hitCount{0};
+    alignas(64) std::atomic<uint64_t> missCount{0};
+    alignas(64) std::atomic<uint64_t> insertCount{0};
+    alignas(64) std::atomic<uint64_t> evictionCount{0};
+
+    static size_t roundUpBuckets(size_t capacity) {
+        size_t buckets = 1;
+        while (buckets * WAYS < capacity) {
+            buckets <<= 1;
+        }
+        return buckets;
+    }
+
+    static uint64_t normaliseKey(uint64_t key) {
+        return key == 0 ? 1 : key;  // 0 is reserved for "empty"
+    }
+
+    /*
+     * Pick where a key goes:
+     * 1. The slot already holding this key (update in place)
+     * 2. An empty slot
+     * 3. CLOCK eviction: move the hand round the bucket, clearing
+     *    "referenced" bits, and take the first slot not recently used
+     */
+    int chooseSlot(size_t bucketIndex, Slot* bucket, uint64_t key) {
+        int empty = -1;
+        for (int way = 0; way < WAYS; way++) {
+            uint64_t existing = bucket[way].key.load(std::memory_order_relaxed);
+            if (existing == key) {
+                return way;
+            }
+            if (existing == 0 && empty < 0) {
+                empty = way;
+            }
+        }
+        if (empty >= 0) {
+            return empty;
+        }
+
+        for (int step = 0; step < 2 * WAYS; step++) {
+            int way = static_cast<int>(hands[bucketIndex].fetch_add(1, std::memory_order_relaxed) % WAYS);
+            if (bucket[way].referenced.exchange(0, std::memory_order_relaxed) == 0) {
+                return way;
+            }
+        }
+        return static_cast<int>(hands[bucketIndex].load(std::memory_order_relaxed) % WAYS);
+    }
+};
+
+#endif
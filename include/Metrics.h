@@ -0,0 +1,135 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "LatencyHistogram.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * METRIC PHASE
+ * ------------
+ * What a latency measurement covers.
+ */
+enum class MetricPhase {
+    Deal,          // dealInitialCards
+    PlayerAction,  // Handling one player decision (after the input arrives)
+    DealerTurn,    // Dealer resolution
+    Scoring,       // determineWinner
+    Round,         // A whole round, including the time the player takes
+    COUNT
+};
+
+/*
+ * METRICSRECORDER CLASS
+ * ---------------------
+ * One thread's histograms and counters. Only that thread writes to it,
+ * so recording is lock-free and allocation-free (see LatencyHistogram).
+ */
+class MetricsRecorder {
+public:
+    static const int PHASES = static_cast<int>(MetricPhase::COUNT);
+
+    void recordLatency(MetricPhase phase, uint64_t nanos) {
+        histograms[static_cast<int>(phase)].record(nanos);
+    }
+    void countRound() { bump(rounds); }
+    void countReshuffle() { bump(reshuffles); }
+
+private:
+    friend class Metrics;
+
+    LatencyHistogram histograms[PHASES];
+    std::atomic<uint64_t> rounds{0};
+    std::atomic<uint64_t> reshuffles{0};
+
+    static void bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+/*
+ * METRICS CLASS
+ * -------------
+ * Collects the recorders of every thread and renders them in the
+ * Prometheus text format (served by MetricsServer).
+ *
+ * - threadRecorder() hands each thread its own MetricsRecorder. The first
+ *   call on a thread registers it (takes a lock, allocates); later calls
+ *   are a thread_local lookup. Fetch it on the thread that records - Game
+ *   does so every round, so a Game can move between threads (SessionStore)
+ * - prometheusText() copies all histograms, merges them per phase and
+ *   prints p50 / p99 / p999, sum and count for each phase, plus the
+ *   rounds and reshuffle counters, rounds per second since the previous
+ *   scrape, and the number of active sessions
+ *
+ * Metrics::global() is the process-wide instance Game records into.
+ */
+class Metrics {
+public:
+    Metrics();
+
+    static Metrics& global();
+    static const char* phaseName(MetricPhase phase);
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    MetricsRecorder& threadRecorder();
+    void sessionStarted() { activeSessions.fetch_add(1, std::memory_order_relaxed); }
+    void sessionEnded() { activeSessions.fetch_sub(1, std::memory_order_relaxed); }
+
+    std::string prometheusText();
+
+private:
+    std::mutex registryLock;
+    std::vector<std::unique_ptr<MetricsRecorder> > recorders;
+    std::atomic<long long> activeSessions;
+    uint64_t lastScrapeNanos;     // For rounds per second between scrapes
+    uint64_t lastScrapeRounds;
+};
+
+/*
+ * METRICSSESSION CLASS
+ * --------------------
+ * Counts as one active session while it exists (a member of Game).
+ */
+class MetricsSession {
+public:
+    explicit MetricsSession(Metrics& target) : metrics(target) { metrics.sessionStarted(); }
+    ~MetricsSession() { metrics.sessionEnded(); }
+
+    MetricsSession(const MetricsSession&) = delete;
+    MetricsSession& operator=(const MetricsSession&) = delete;
+
+private:
+    Metrics& metrics;
+};
+
+/*
+ * LATENCYTIMER CLASS
+ * ------------------
+ * Records the time from construction to destruction:
+ *     LatencyTimer timer(recorder, MetricPhase::Deal);
+ */
+class LatencyTimer {
+public:
+    LatencyTimer(MetricsRecorder& target, MetricPhase timedPhase)
+        : recorder(target), phase(timedPhase), start(Metrics::now()) {}
+    ~LatencyTimer() { recorder.recordLatency(phase, Metrics::now() - start); }
+
+    LatencyTimer(const LatencyTimer&) = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+
+private:
+    MetricsRecorder& recorder;
+    MetricPhase phase;
+    uint64_t start;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include "Metrics.h"
+#include <atomic>
+#include <thread>
+
+/*
+ * METRICSSERVER CLASS
+ * -------------------
+ * A tiny HTTP endpoint on 127.0.0.1 that answers "GET /metrics" with
+ * Metrics::prometheusText(), for a Prometheus scraper on the same host.
+ *
+ * - Listens on localhost only - nothing is exposed to the network
+ * - One background thread accepts and answers one request at a time
+ *   (scrapes are rare and small); the game threads are never involved
+ * - Port 0 picks a free port; getPort() tells which
+ *
+ * POSIX sockets only; on other systems start() returns false.
+ */
+class MetricsServer {
+public:
+    MetricsServer(Metrics& metrics, int port);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    bool start();   // false if the port cannot be opened
+    void stop();
+    int getPort() const { return port; }
+
+private:
+    Metrics& metrics;
+    int port;
+    int listenSocket;
+    std::atomic<bool> stopping;
+    std::thread server;
+
+    void serveLoop();
+    void answer(int client);
+};
+
+#endif
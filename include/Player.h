@@ -33,7 +33,12 @@ protected:
 public:
     Player();
     void addCard(Card* c);      // Takes ownership of the Card
+    Card* removeLastCard();     // Gives ownership of the last Card back (for splits)
     int getScore();             // Calculates score with Ace logic
+    bool isSoft();              // True if an Ace is being counted as 11
+    bool isPair();              // Two cards of the same value
+    int getCardCount() const;
+    const Card& getCard(int index) const;  // 0 = first card dealt
     void showHand();            // Displays all cards
     virtual ~Player();          // Virtual for proper inheritance cleanup
 };
@@ -0,0 +1,71 @@
+#ifndef PLAYERPOLICY_H
+#define PLAYERPOLICY_H
+
+#include "ShoeState.h"
+#include "TableState.h"
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * PLAYER POLICY INTERFACE
+ * -----------------------
+ * Strategy Pattern for the PLAYER side of a headless simulation
+ * (DrawStrategy plays the same role for the Dealer).
+ *
+ * A policy sees what a real player at the table could see:
+ * - its own hand
+ * - the dealer's upcard (rank 1-13)
+ * - the remaining shoe (only meaningful for a CompositionDeck shoe)
+ *
+ * decide() is const and must be safe to call from several simulation
+ * threads at once.
+ *
+ * identity() is a fingerprint of the policy: its kind, its parameters and
+ * the contents of any table it plays from. Two policies that could decide
+ * differently have different identities, so a simulation checkpoint
+ * refuses to be continued by another policy.
+ */
+class PlayerPolicy {
+public:
+    virtual PlayerAction decide(const HandState& hand, int dealerUpcard, const ShoeState& shoe) const = 0;
+    virtual uint64_t identity() const = 0;
+    virtual ~PlayerPolicy() = default;
+
+protected:
+    // FNV-1a, for building identities: start from hashBytes(IDENTITY_SEED, name)
+    static const uint64_t IDENTITY_SEED = 0xCBF29CE484222325ULL;
+    static uint64_t hashBytes(uint64_t hash, const void* data, size_t size);
+    static uint64_t hashName(const char* name);
+};
+
+/*
+ * THRESHOLD POLICY
+ * ----------------
+ * Hits until the score reaches a fixed value, like the dealer strategies.
+ * This is what GameConfig::playerStandThreshold describes.
+ */
+class ThresholdPolicy : public PlayerPolicy {
+private:
+    int standAt;
+
+public:
+    explicit ThresholdPolicy(int threshold);
+    PlayerAction decide(const HandState& hand, int dealerUpcard, const ShoeState& shoe) const override;
+    uint64_t identity() const override;
+};
+
+/*
+ * BASIC STRATEGY POLICY
+ * ---------------------
+ * A compact version of textbook Blackjack "basic strategy" (written for a
+ * dealer who stands on 17). It asks to double, split and surrender where
+ * the textbook does; the RoundEngine turns those into a plain Hit when
+ * the active rule set does not allow them.
+ */
+class BasicStrategyPolicy : public PlayerPolicy {
+public:
+    PlayerAction decide(const HandState& hand, int dealerUpcard, const ShoeState& shoe) const override;
+    uint64_t identity() const override;
+};
+
+#endif
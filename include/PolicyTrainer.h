@@ -0,0 +1,114 @@
+#ifndef POLICYTRAINER_H
+#define POLICYTRAINER_H
+
+#include "DecisionTable.h"
+#include "GameConfig.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ * TRAINING OPTIONS / PROGRESS
+ */
+struct TrainerOptions {
+    long long episodes = 50000000;       // Upper limit on rounds played
+    long long epochEpisodes = 2000000;   // Rounds between merges (all actors together)
+    int actors = 1;                      // Threads generating rounds
+    double epsilon = 0.2;                // Exploration rate in the first epoch...
+    double minEpsilon = 0.02;            // ...decaying towards this
+    int stableEpochs = 3;                // Stop after this many epochs with no policy change
+    double keepOld = 0.5;                // Weight of older epochs at each merge (1 = plain average)
+    uint64_t seed = 1;
+    std::string checkpointPath;          // Empty = no checkpoints
+};
+
+struct TrainingProgress {
+    int epoch = 0;
+    long long episodes = 0;       // Total rounds so far (including a resumed checkpoint)
+    int policyChanges = 0;        // Table entries whose best action flipped this epoch
+    double maxValueChange = 0.0;  // Largest change of any action value this epoch
+    double epsilon = 0.0;
+    double seconds = 0.0;
+    double roundsPerSecond = 0.0; // Rounds played by this train() call per second
+};
+
+/*
+ * POLICYTRAINER CLASS
+ * -------------------
+ * Learns a Hit/Stand table by playing headless rounds against the dealer
+ * (Monte Carlo control - reinforcement learning from whole rounds).
+ *
+ * HOW IT LEARNS:
+ * - Q(state, action) = average points won after taking 'action' in
+ *   'state' = (hard/soft, total, dealer upcard)
+ * - Each round the player follows the current best action, but with
+ *   probability epsilon tries a random one instead (exploration)
+ * - At the end of the round its result is added to every (state, action)
+ *   visited, so the averages converge to the real action values
+ *
+ * PARALLEL ACTORS WITH SHARDED TABLES:
+ * - Each epoch, every actor thread plays its share of rounds with its own
+ *   random stream and writes ONLY into its own shard of sums and counts
+ * - The best-action table the actors read is frozen during the epoch
+ * - At the end of the epoch the shards are added into the main table in
+ *   actor order (no locks, same result for the same seed and actor count)
+ * - Before adding, older results are scaled down by 'keepOld'. Early
+ *   rounds were played with a worse policy, and without fading they would
+ *   hold the values of later decisions back for a long time
+ *
+ * CONVERGENCE:
+ * After each merge the trainer counts how many best actions changed and
+ * the largest change in any action value. Training stops once the table
+ * has not changed for 'stableEpochs' epochs (or at the episode limit).
+ *
+ * CHECKPOINTS:
+ * With a checkpoint path, the sums and counts are written after every
+ * epoch (CheckpointWriter::writeAtomically: temporary file, fsync, rename),
+ * and resume() continues from such a file. The file carries a key of the
+ * rules, dealer threshold, shoe and epsilon schedule, and resume() refuses
+ * a checkpoint trained under different ones.
+ *
+ * The learned table is exported as a DecisionTable - the same format the
+ * simulator reads with --policy table.
+ */
+class PolicyTrainer {
+public:
+    typedef std::function<void(const TrainingProgress&)> ProgressCallback;
+
+    PolicyTrainer(const GameConfig& config, const TrainerOptions& options);
+
+    void resume(const std::string& checkpointPath);
+    TrainingProgress train(const ProgressCallback& onEpoch = ProgressCallback());
+    DecisionTable table() const;
+
+    void saveCheckpoint(const std::string& path) const;
+
+private:
+    static const int TOTALS = DecisionTable::MAX_TOTAL + 1;
+    static const int UPCARDS = DecisionTable::UPCARDS + 1;
+    static const int CELLS = 2 * TOTALS * UPCARDS * 2;  // [soft][total][upcard][action]
+
+    // Sums and counts of round results; one per actor plus the main one
+    struct Shard {
+        std::vector<double> sum;
+        std::vector<double> count;   // Weighted number of results
+        Shard() : sum(CELLS, 0.0), count(CELLS, 0.0) {}
+    };
+
+    GameConfig config;
+    TrainerOptions options;
+    Shard values;
+    long long episodesDone;
+    int epochsDone;
+
+    static int cell(bool soft, int total, int upcard, int action) {
+        return ((((soft ? 1 : 0) * TOTALS + total) * UPCARDS + upcard) * 2) + action;
+    }
+    double mean(int index) const;
+    uint64_t checkpointKey() const;  // Rules, dealer, shoe and exploration settings
+    void runActor(Shard& shard, const DecisionTable& greedy, uint64_t stream,
+                  long long episodes, double epsilon) const;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+/*
+ * RNG STRUCT
+ * ----------
+ * A small, fast pseudo-random number generator (SplitMix64) for the
+ * headless simulation code.
+ *
+ * WHY NOT rand():
+ * - rand() has one hidden global state, so threads cannot use it safely
+ * - Its quality and range are implementation defined (RAND_MAX may be 32767)
+ * - Its state cannot be copied, saved or restored
+ *
+ * WHY SPLITMIX64:
+ * - The whole state is ONE 64-bit integer, so an Rng is trivially copyable
+ *   and can be stored per simulation lane, saved in a checkpoint, etc.
+ * - Passes standard statistical test suites and is very cheap to step
+ * - Different seeds give independent-looking streams (see forStream)
+ */
+struct Rng {
+    uint64_t state;
+
+    explicit Rng(uint64_t seed = 0) : state(seed) {}
+
+    // Advance the generator and return 64 random bits
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /*
+     * Unbiased integer in [0, n) using Lemire's multiply-and-reject method.
+     * Unlike 'rand() % n', every result is exactly equally likely.
+     */
+    uint32_t below(uint32_t n) {
+        uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(next())) * n;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < n) {
+            uint32_t threshold = static_cast<uint32_t>(-n) % n;
+            while (low < threshold) {
+                m = static_cast<uint64_t>(static_cast<uint32_t>(next())) * n;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    // Uniform double in [0, 1) built from the top 53 bits
+    double uniform() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /*
+     * Independent generator for one numbered stream of a seed.
+     * Used to give every simulation lane / block / thread its own sequence
+     * while the whole run stays reproducible from a single seed.
+     */
+    static Rng forStream(uint64_t seed, uint64_t stream) {
+        Rng mixer(seed ^ (stream * 0xD1B54A32D192ED03ULL));
+        mixer.next();
+        return Rng(mixer.next());
+    }
+};
+
+#endif
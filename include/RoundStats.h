@@ -0,0 +1,103 @@
+#ifndef ROUNDSTATS_H
+#define ROUNDSTATS_H
+
+#include <cstdint>
+#include <string>
+
+/*
+ * ROUNDRECORD STRUCT
+ * ------------------
+ * What happened in one headless round (the same outcome rules as
+ * Game::determineWinner). With the Classic rules 'net' is always +1, -1
+ * or 0; other rule sets add doubles, splits, surrenders and natural payouts.
+ */
+struct RoundRecord {
+    double net = 0.0;         // Points won (+) or lost (-) by the player; 0 = tie
+    int playerScore = 0;
+    int dealerScore = 0;      // Dealer's final score (just the upcard if the player bust)
+    int dealerUpcard = 0;     // Rank 1-13 of the dealer's first card
+    int playerStart = 0;      // Player's two-card total before any decision
+    bool playerStartSoft = false;
+    int playerCards = 0;
+    int dealerCards = 0;
+    bool playerBust = false;
+    bool dealerBust = false;
+    bool playerSoft = false;  // Player's final hand counted an Ace as 11
+    bool doubled = false;     // Rule-set actions taken this round
+    bool split = false;
+    bool surrendered = false;
+};
+
+/*
+ * ROUNDSTATS CLASS
+ * ----------------
+ * Streaming statistics over many rounds - nothing is stored per round.
+ *
+ * WELFORD'S ALGORITHM:
+ * The mean and variance of net points are updated one round at a time:
+ *     delta = x - mean;  mean += delta / n;  M2 += delta * (x - mean)
+ * This is numerically stable even over billions of rounds, unlike
+ * keeping "sum of x" and "sum of x squared".
+ *
+ * MERGING (per-thread shards):
+ * Each thread fills its OWN RoundStats, so no locks are needed while
+ * simulating. Shards are combined afterwards with merge(), which uses
+ * the parallel form of Welford's update (Chan et al.).
+ *
+ * CONFIDENCE INTERVAL:
+ * The player edge is the mean net points per round. Its 95% confidence
+ * interval is mean +/- 1.96 * sqrt(variance / n).
+ *
+ * SAVING:
+ * toString() writes every field on one line, with the doubles in
+ * hexadecimal floating point ("%a") so fromString() gets back exactly the
+ * same bits. Shards from other processes then merge to the same result
+ * as shards computed in this one.
+ */
+class RoundStats {
+public:
+    static const int HISTOGRAM_SIZE = 23;  // Dealer final score 0-21, [22] = bust
+    static const int BUST_BUCKET = 22;
+
+    RoundStats();
+
+    void add(const RoundRecord& round);
+    void merge(const RoundStats& other);
+
+    long long getRounds() const { return rounds; }
+    long long getWins() const { return wins; }
+    long long getTies() const { return ties; }
+    long long getLosses() const { return losses; }
+    long long getPlayerBusts() const { return playerBusts; }
+    long long getDealerBusts() const { return dealerBusts; }
+    long long getDealerHistogram(int bucket) const { return dealerHistogram[bucket]; }
+
+    double winRate() const;
+    double tieRate() const;
+    double lossRate() const;
+    double playerBustRate() const;
+    double dealerBustRate() const;
+
+    double edge() const { return mean; }   // Mean net points per round
+    double variance() const;               // Sample variance of net points
+    double standardError() const;          // Standard error of the edge
+    double confidenceHalfWidth(double z = 1.96) const;
+    double confidenceWidth(double z = 1.96) const { return 2.0 * confidenceHalfWidth(z); }
+
+    std::string toString() const;
+    static bool fromString(const std::string& text, RoundStats& stats);
+
+private:
+    long long rounds;
+    double mean;
+    double m2;   // Sum of squared differences from the mean
+
+    long long wins;
+    long long ties;
+    long long losses;
+    long long playerBusts;
+    long long dealerBusts;
+    long long dealerHistogram[HISTOGRAM_SIZE];
+};
+
+#endif
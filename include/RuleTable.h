@@ -0,0 +1,109 @@
+#ifndef RULETABLE_H
+#define RULETABLE_H
+
+#include "PlayerPolicy.h"
+#include "Strategy.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/*
+ * RULETABLE CLASS
+ * ---------------
+ * A hit/stand behaviour written as short text rules and compiled into a
+ * flat table, so new dealer (or player) behaviour ships as a file instead
+ * of a new DrawStrategy subclass and a rebuild.
+ *
+ * RULE FORMAT (rules separated by ';' or new lines, '#' starts a comment):
+ *   soft 17: hit
+ *   hard >=17: stand
+ *   hard 12-16, count >= +2: stand
+ *   any <12: hit; any: hit
+ * Each rule is "conditions: hit|stand". The conditions (comma separated,
+ * all must hold) are:
+ *   soft | hard | any [TOTAL]   the hand, optionally with a total:
+ *                               17, >=15, <=16, >12, <12 or a range 12-16
+ *   count RANGE                 the Hi-Lo running count of the cards dealt
+ *                               from this shoe, e.g. count >= +2, count -1..1
+ * The FIRST rule that matches decides, as in a firewall.
+ *
+ * VALIDATION (RuleFormatException, with the rule number):
+ * - Syntax: unknown words, missing ':' or action, numbers out of range
+ *   (soft totals 11-21, hard 2-21, counts -COUNT_LIMIT..+COUNT_LIMIT)
+ * - Every hand (hard 2-21, soft 11-21) at every count must be decided
+ * - A rule that never decides anything (earlier rules cover all of its
+ *   cases) is an error too - it is almost always a typo
+ *
+ * THE COMPILED TABLE:
+ *   draw[count + COUNT_LIMIT][soft][total]  (21 x 2 x 32 bytes)
+ * Counts beyond +-COUNT_LIMIT use the last row, totals above 21 always
+ * stand. A decision is one load from a 1.3 KB table, whatever the rules.
+ */
+class RuleTable {
+public:
+    static const int COUNT_LIMIT = 10;
+    static const int COUNTS = 2 * COUNT_LIMIT + 1;
+    static const int TOTALS = 32;
+    static const int MIN_SOFT = 11;  // A lone Ace
+
+    static RuleTable compile(const std::string& text);
+    static RuleTable loadFile(const std::string& path);
+
+    bool shouldDraw(int total, bool soft, int runningCount) const {
+        int count = runningCount < -COUNT_LIMIT ? -COUNT_LIMIT : (runningCount > COUNT_LIMIT ? COUNT_LIMIT : runningCount);
+        return draw[count + COUNT_LIMIT][soft ? 1 : 0][total < TOTALS ? total : TOTALS - 1] != 0;
+    }
+
+    // Lowest hard total from which the rules always stand at count 0 -
+    // the nearest plain threshold, for code that only understands those
+    int nearestThreshold() const;
+
+    std::string describe() const;  // One line per hand, one H/S column per count
+    static const size_t CELLS = COUNTS * 2 * TOTALS;
+    const uint8_t* cells() const { return &draw[0][0][0]; }  // All CELLS entries, 1 = hit
+
+    // Hi-Lo tag of a card: 2-6 count +1, 7-9 count 0, tens and Aces count -1
+    static int hiLoTag(int value) { return value <= 6 ? 1 : (value >= 10 ? -1 : 0); }
+
+private:
+    RuleTable();
+
+    uint8_t draw[COUNTS][2][TOTALS];  // 1 = hit
+};
+
+/*
+ * RULESTRATEGY CLASS
+ * ------------------
+ * DrawStrategy backed by a compiled RuleTable. The table is shared, so the
+ * Game can hand every new Dealer its own strategy without recompiling.
+ */
+class RuleStrategy : public DrawStrategy {
+private:
+    std::shared_ptr<const RuleTable> rules;
+
+public:
+    explicit RuleStrategy(std::shared_ptr<const RuleTable> table);
+
+    bool shouldDraw(int score) override;  // Hard hand at count 0
+    bool shouldDrawHand(int score, bool soft, int runningCount) override;
+    int getThreshold() const override;
+};
+
+/*
+ * RULEPOLICY CLASS
+ * ----------------
+ * The same rules driving the headless player: hit or stand only, with the
+ * running count read from the ShoeState (cards gone from a full shoe).
+ */
+class RulePolicy : public PlayerPolicy {
+private:
+    RuleTable rules;
+    ShoeState full;  // A full shoe, to count the cards that are gone
+
+public:
+    RulePolicy(const RuleTable& table, int shoeSize);
+    PlayerAction decide(const HandState& hand, int dealerUpcard, const ShoeState& shoe) const override;
+    uint64_t identity() const override;  // Hash of the compiled rules
+};
+
+#endif
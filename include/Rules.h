@@ -0,0 +1,106 @@
+#ifndef RULES_H
+#define RULES_H
+
+/*
+ * RULE SETS (COMPILE-TIME POLICY TYPES)
+ * -------------------------------------
+ * Optional Blackjack rules, chosen at COMPILE TIME with templates.
+ *
+ * HOW IT WORKS:
+ * - A rule set is a type whose members are compile-time constants
+ * - Code that depends on the rules is a template: playRound<VegasRules>()
+ * - Inside it, "if (Rules::surrender)" is a constant condition, so the
+ *   compiler deletes the whole branch when the rule is switched off
+ *   (no run-time check per decision)
+ * - The common rule sets below are instantiated once, in advance, and
+ *   GameConfig::ruleVariant picks one of them once per round/block
+ *
+ * THE RULES:
+ * - hitSoft17   : dealer keeps drawing on a soft total of 17 or less
+ *                 (e.g. Ace + 6), even if the strategy would stand there
+ * - doubleDown  : on the first two cards, double the stake and take exactly
+ *                 one more card
+ * - split       : two cards of equal value become two separate hands
+ *                 (one split per round; split Aces get one card each)
+ * - surrender   : give up on the first two cards and lose half the stake
+ * - payNaturals : a two-card 21 ("natural") pays NaturalNum:NaturalDen and
+ *                 beats a dealer 21 made with more than two cards
+ *
+ * Points work like stakes: a hand won adds its payout to the player's
+ * points, a hand lost adds its stake to the dealer's points.
+ */
+template <bool HitSoft17, bool DoubleDown, bool Split, bool Surrender,
+          bool PayNaturals, int NaturalNum, int NaturalDen>
+struct RuleSet {
+    static const bool hitSoft17 = HitSoft17;
+    static const bool doubleDown = DoubleDown;
+    static const bool split = Split;
+    static const bool surrender = Surrender;
+    static const bool payNaturals = PayNaturals;
+
+    // Points for a winning natural with a stake of 1
+    static double naturalPayout() {
+        return static_cast<double>(NaturalNum) / NaturalDen;
+    }
+};
+
+// The original game: hit or stand only, every win is worth one point
+typedef RuleSet<false, false, false, false, false, 1, 1> ClassicRules;
+
+// Common casino rules: double, split, naturals pay 3:2, dealer stands on soft 17
+typedef RuleSet<false, true, true, false, true, 3, 2> StandardRules;
+
+// Las Vegas style: as Standard plus dealer hits soft 17 and late surrender
+typedef RuleSet<true, true, true, true, true, 3, 2> VegasRules;
+
+// Runtime name for each pre-built rule set (stored in GameConfig)
+enum class RuleVariant {
+    Classic,
+    Standard,
+    Vegas
+};
+
+/*
+ * SHARED RULE HELPERS
+ * -------------------
+ * Used by both Game and the headless RoundEngine so they always agree.
+ */
+
+// Does the dealer take another card?
+template <typename Rules>
+inline bool dealerDraws(int score, bool soft, int strategyThreshold) {
+    if (score < strategyThreshold) {
+        return true;
+    }
+    return Rules::hitSoft17 && soft && score <= 17;
+}
+
+/*
+ * Settle one hand. Returns the points won by the player
+ * (negative = points that go to the dealer).
+ */
+template <typename Rules>
+inline double settleHand(int playerScore, bool playerNatural, int dealerScore, bool dealerNatural,
+                         double stake, bool surrendered) {
+    if (Rules::surrender && surrendered) {
+        return -0.5 * stake;
+    }
+    if (playerScore > 21) {
+        return -stake;
+    }
+    if (Rules::payNaturals && playerNatural) {
+        return dealerNatural ? 0.0 : stake * Rules::naturalPayout();
+    }
+    if (Rules::payNaturals && dealerNatural) {
+        return -stake;  // A dealer natural beats any other 21
+    }
+    if (dealerScore > 21 || playerScore > dealerScore) {
+        return stake;
+    }
+    if (dealerScore > playerScore) {
+        return -stake;
+    }
+    return 0.0;
+}
+
+#endif
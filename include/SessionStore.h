@@ -0,0 +1,88 @@
+#ifndef SESSIONSTORE_H
+#define SESSIONSTORE_H
+
+#include "Game.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+ * SESSIONSTORE CLASS
+ * ------------------
+ * Hosts many tables (one Game each) while keeping only the most recently
+ * used ones in memory.
+ *
+ * WHY:
+ * A resident Game is far more than its state: hint caches and a
+ * ShoePipeline with its ready shoes (the strategy tables, match odds and
+ * the thread building the shoes are shared by every Game). Its actual state (Game::saveSession) is a few hundred bytes.
+ * Most tables of a busy host sit idle between a player's actions, so
+ * those are kept as bytes on disk and rebuilt when the player acts again.
+ *
+ * HOW:
+ * - get(table) moves the table to the front of a least-recently-used list
+ * - When more than 'maxResident' tables are in memory, the one at the back
+ *   is saved to "<directory>/table_<id>.session" (temporary file + rename,
+ *   see CheckpointWriter) and destroyed
+ * - get() on an evicted table loads it back transparently and deletes the
+ *   file, so a table lives in exactly one place at a time
+ * - If a table cannot be written out (full disk, no directory) it simply
+ *   stays in memory and getFailures() counts it - a table is never lost
+ * - The destructor saves every resident table (each one is tried; any that
+ *   cannot be written are reported on std::cerr). A later store on the same
+ *   directory adopts those files: get(), contains() and close() look for
+ *   "table_<id>.session" on disk when they do not know the table, so a
+ *   restarted host picks its tables up again instead of orphaning them
+ *
+ * Not thread-safe: one store belongs to one host loop. References returned
+ * by get() and open() stay valid until that table is evicted, i.e. until
+ * maxResident other tables have been used.
+ */
+class SessionStore {
+public:
+    SessionStore(const std::string& directory, size_t maxResident);
+    ~SessionStore();  // Evicts every resident table; a new store on the directory adopts them
+
+    SessionStore(const SessionStore&) = delete;
+    SessionStore& operator=(const SessionStore&) = delete;
+
+    Game& open(uint64_t table, const GameConfig& config);  // New table (replaces an old one)
+    Game& get(uint64_t table);     // Throws std::out_of_range if neither in memory nor on disk
+    bool contains(uint64_t table) const;
+    void close(uint64_t table);    // Forgets the table, in memory and on disk
+    size_t evictAll();             // Saves every resident table it can; returns how many failed
+
+    size_t getResident() const { return resident.size(); }
+    size_t getTables() const { return resident.size() + evicted.size(); }  // Not counting unadopted files
+    long long getEvictions() const { return evictions; }
+    long long getPageIns() const { return pageIns; }
+    long long getBytesWritten() const { return bytesWritten; }
+    long long getFailures() const { return failures; }
+
+    std::string pathOf(uint64_t table) const;
+
+private:
+    struct Entry {
+        std::unique_ptr<Game> game;
+        std::list<uint64_t>::iterator position;  // In 'recent'
+    };
+
+    std::string directory;
+    size_t maxResident;
+    std::unordered_map<uint64_t, Entry> resident;
+    std::list<uint64_t> recent;                  // Most recently used first
+    std::unordered_set<uint64_t> evicted;        // Tables that are only on disk
+    long long evictions;
+    long long pageIns;
+    long long bytesWritten;
+    long long failures;
+
+    Game& admit(uint64_t table, std::unique_ptr<Game> game);
+    bool evict(uint64_t table);
+    void shrink(uint64_t keep);                  // Evicts down to maxResident
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef SHARDCOORDINATOR_H
+#define SHARDCOORDINATOR_H
+
+#include "GameConfig.h"
+#include "RoundStats.h"
+#include "Simulator.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*
+ * COORDINATOR OPTIONS
+ */
+struct CoordinatorOptions {
+    int processes = 2;              // Worker processes running at the same time
+    long long blocksPerShard = 64;  // Blocks given to one worker process
+    int maxRetries = 3;             // Restarts allowed per shard before giving up
+    std::string shardDirectory;     // Where per-shard statistics files go (empty = none)
+    SimulationOptions simulation;   // Seed, block size and epoch length
+};
+
+/*
+ * SHARDCOORDINATOR CLASS
+ * ----------------------
+ * Runs one simulation across several WORKER PROCESSES on this machine.
+ *
+ * WHY PROCESSES INSTEAD OF THREADS:
+ * - A crash only kills one worker; its shard is simply run again
+ * - Memory growth ends when the worker exits
+ * - The operating system can place each worker on its own NUMA node
+ *
+ * HOW:
+ * - The run is cut into the same blocks as Simulator (block b always uses
+ *   random stream b), and consecutive blocks are grouped into SHARDS
+ * - Each shard is run by a child process started from 'workerCommand'
+ *   plus "--first-block A --blocks N". The child writes one line per block
+ *   to its stdout:  "block <index> <RoundStats::toString()>"
+ *   The coordinator reads all children through pipes (poll), so there is
+ *   no network and no shared memory
+ * - A child that exits with an error, is killed, or misses blocks is
+ *   started again, up to maxRetries times
+ * - Each finished shard is also saved as shard_<first block>.txt in
+ *   shardDirectory; shards already there are reused instead of re-run
+ * - With options.simulation.telemetry the shard queue, the blocks each
+ *   process slot has reported and the merged estimate after every wave
+ *   are published for blackjack_top (see Telemetry.h)
+ *
+ * SAME ANSWER AS ONE PROCESS:
+ * Block results are merged one by one in block order and the early-stop
+ * check happens at the same epoch boundaries as Simulator::run, so the
+ * result is bit-for-bit the one a single process gives with the same seed.
+ *
+ * Needs POSIX (fork/exec/pipes); on other systems run() throws.
+ */
+class ShardCoordinator {
+public:
+    ShardCoordinator(const GameConfig& config, const std::vector<std::string>& workerCommand,
+                     const CoordinatorOptions& options);
+
+    SimulationResult run();
+
+    int getRestarts() const { return restarts; }
+    int getShardsRun() const { return shardsRun; }
+
+    // Worker side: run blocks [firstBlock, firstBlock + blocks) and print them
+    static int runWorker(const Simulator& simulator, const GameConfig& config, const SimulationOptions& simulation,
+                         long long firstBlock, long long blocks, std::ostream& out);
+
+private:
+    struct Shard {
+        long long firstBlock;
+        long long blocks;
+        int attempts;
+    };
+
+    GameConfig config;
+    std::vector<std::string> workerCommand;
+    CoordinatorOptions options;
+    int restarts;
+    int shardsRun;
+
+    void runShards(std::vector<Shard> shards, std::vector<RoundStats>& blockStats, long long waveStart);
+    bool loadShardFile(const Shard& shard, std::vector<RoundStats>& blockStats, long long waveStart) const;
+    void saveShardFile(const Shard& shard, const std::vector<RoundStats>& blockStats, long long waveStart) const;
+};
+
+#endif
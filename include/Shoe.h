@@ -0,0 +1,52 @@
+#ifndef SHOE_H
+#define SHOE_H
+
+#include "ByteCodec.h"
+#include "Card.h"
+#include "GameConfig.h"
+#include <cstdint>
+#include <memory>
+
+/*
+ * SHOE INTERFACE
+ * --------------
+ * Abstract source of cards used by Game.
+ *
+ * WHY AN INTERFACE:
+ * - Game only needs "draw a card", "how many are left" and "is it empty"
+ * - Different storage strategies can sit behind the same interface:
+ *     Deck            - one heap-allocated Card object per card (Card**)
+ *     CompositionDeck - only 13 rank counts, constant memory for any size
+ * - Game does not change when a new backend is added (Open/Closed Principle)
+ */
+class Shoe {
+public:
+    virtual Card* drawCard() = 0;        // Returns ownership of card to caller
+    virtual int getSize() const = 0;     // Cards remaining
+    virtual bool isEmpty() const = 0;    // Check if shoe is empty
+
+    // Make this a full new shoe, exactly as if constructed with 'seed'
+    // (lets ShoePipeline reuse shoes instead of allocating new ones)
+    virtual void refill(uint64_t seed) = 0;
+
+    // Everything needed to carry on drawing the same cards later, in the
+    // backend's own compact form (for saved sessions, see SessionStore.h)
+    virtual void saveState(ByteWriter& out) const = 0;
+    virtual void loadState(ByteReader& in) = 0;  // Throws TableFormatException
+    virtual ~Shoe() = default;
+};
+
+/*
+ * SHOEFACTORY CLASS
+ * -----------------
+ * Factory Pattern again: picks the Shoe backend from the GameConfig,
+ * so Game never names a concrete class.
+ */
+class ShoeFactory {
+public:
+    static std::unique_ptr<Shoe> createShoe(const GameConfig& config);
+    static std::unique_ptr<Shoe> createShoe(const GameConfig& config, uint64_t seed);
+    static uint64_t seedFromRand();  // So srand() in main still controls every shoe
+};
+
+#endif
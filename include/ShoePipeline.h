@@ -0,0 +1,99 @@
+#ifndef SHOEPIPELINE_H
+#define SHOEPIPELINE_H
+
+#include "GameConfig.h"
+#include "Shoe.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * SHOEPRODUCER CLASS
+ * ------------------
+ * The background thread(s) that build shoes for every ShoePipeline in the
+ * process. A host with hundreds of tables still runs one producer: each
+ * table only owns a queue of ready shoes, and the producer serves the
+ * queues that are running low, one shoe per turn, round-robin.
+ *
+ * shared() is the producer every pipeline uses unless it is given another
+ * one. A producer must outlive the pipelines using it.
+ */
+class ShoeProducer {
+public:
+    explicit ShoeProducer(int threads = 1);
+    ~ShoeProducer();
+
+    ShoeProducer(const ShoeProducer&) = delete;
+    ShoeProducer& operator=(const ShoeProducer&) = delete;
+
+    static ShoeProducer& shared();               // One thread for the whole process
+
+    int getThreads() const { return static_cast<int>(workers.size()); }
+
+private:
+    friend class ShoePipeline;
+    struct Queue;                                // One pipeline's shoes (ShoePipeline.cpp)
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::deque<std::shared_ptr<Queue> > work;    // Queues waiting for their next shoe
+    bool stopping;
+    std::vector<std::thread> workers;
+
+    void schedule(std::shared_ptr<Queue> queue);
+    void run();
+};
+
+/*
+ * SHOEPIPELINE CLASS
+ * ------------------
+ * Builds the next shoes in the background, so replacing a shoe that ran
+ * low is a pointer swap instead of 'deckSize' Card allocations.
+ *
+ * THE PIPELINE:
+ *   producer:  spare shoe --refill(seed)--> ready queue
+ *   table:     take() <-- ready queue,  recycle(old shoe) --> spare
+ * - At most 'capacity' shoes wait in the ready queue. When take() leaves
+ *   half of them or fewer, the queue is handed to the ShoeProducer, which
+ *   fills it back up; a table costs no thread of its own
+ * - A shoe that is handed back is refilled in place (Shoe::refill keeps
+ *   its Card* array) rather than destroyed, so after warm-up the pool is a
+ *   fixed set of recycled shoes. Surplus shoes are destroyed on the
+ *   producer thread too - the table never pays for a shoe
+ * - take() and recycle() only move a pointer under a short lock, and the
+ *   destructor never waits: the producer drops a queue whose pipeline is
+ *   gone (the queue is shared, so a shoe being built is simply discarded)
+ *
+ * SAME SHOES AS BEFORE:
+ * Shoe k is always built from the k-th number of Rng(seed), whichever
+ * thread builds it, so a pipeline gives the same shoes in the same order
+ * as creating them on the spot. If take() finds the queue empty (shoes
+ * used up faster than they are built, or the producer busy with other
+ * tables) it waits for the shoe being built, or builds the next one
+ * itself; either way that take counts as a miss.
+ */
+class ShoePipeline {
+public:
+    ShoePipeline(const GameConfig& config, uint64_t seed, int capacity = 4,
+                 ShoeProducer& producer = ShoeProducer::shared());
+    ~ShoePipeline();
+
+    ShoePipeline(const ShoePipeline&) = delete;
+    ShoePipeline& operator=(const ShoePipeline&) = delete;
+
+    std::unique_ptr<Shoe> take();                // The next full shoe
+    void recycle(std::unique_ptr<Shoe> shoe);    // Hand a used shoe back
+
+    long long getTaken() const;
+    long long getMisses() const;                 // Takes that found no shoe ready
+
+private:
+    ShoeProducer& producer;
+    std::shared_ptr<ShoeProducer::Queue> queue;  // Shared with the producer while it builds
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef SHOESTATE_H
+#define SHOESTATE_H
+
+#include "Rng.h"
+#include <cstdint>
+
+/*
+ * SHOESTATE STRUCT
+ * ----------------
+ * The contents of a shoe stored as 13 rank counts instead of card objects.
+ *
+ * WHY COUNTS INSTEAD OF CARDS:
+ * - Memory is the same (56 bytes) whether the shoe holds 52 cards or 52 million
+ * - Building a shoe is 13 assignments, not 'deckSize' heap allocations
+ * - It is a plain value: copying it is a memcpy, so solvers can branch
+ *   ("what if I hit?") by copying the shoe instead of rebuilding Decks
+ *
+ * HOW DRAWING WORKS (weighted sampling without replacement):
+ * - Pick a random position 0..remaining-1
+ * - Walk the counts until the position falls inside a rank's block
+ * - Remove one card of that rank
+ * This gives every remaining card an equal chance, exactly like
+ * drawing from a physically shuffled shoe.
+ *
+ * Ranks are numbered like CardFactory: 1 = Ace, 2-10, 11 = Jack,
+ * 12 = Queen, 13 = King. Suits do not affect scoring, so they are not stored.
+ */
+struct ShoeState {
+    static const int RANKS = 13;
+
+    uint32_t counts[RANKS];  // counts[rank - 1] = cards of that rank left
+    uint32_t remaining;      // Sum of all counts
+
+    // Shoe of 'size' cards spread as evenly as possible over the 13 ranks
+    static ShoeState standard(int size);
+
+    int getCount(int rank) const { return static_cast<int>(counts[rank - 1]); }
+    int getSize() const { return static_cast<int>(remaining); }
+    bool isEmpty() const { return remaining == 0; }
+
+    // Draw a random card (caller must check isEmpty first)
+    int drawRank(Rng& rng) {
+        uint32_t position = rng.below(remaining);
+        int index = 0;
+        while (position >= counts[index]) {
+            position -= counts[index];
+            index++;
+        }
+        counts[index]--;
+        remaining--;
+        return index + 1;
+    }
+
+    // Take out / put back one specific card
+    void removeRank(int rank) {
+        counts[rank - 1]--;
+        remaining--;
+    }
+
+    void addRank(int rank) {
+        counts[rank - 1]++;
+        remaining++;
+    }
+
+    // Probability that the next card is 'rank'
+    double probability(int rank) const {
+        return remaining > 0 ? static_cast<double>(counts[rank - 1]) / remaining : 0.0;
+    }
+
+    /*
+     * Compact 64-bit fingerprint of the composition.
+     * Used as a cache key by the solver: equal shoes always give equal
+     * hashes, and different shoes collide with negligible probability.
+     */
+    uint64_t hash() const {
+        uint64_t h = 0x243F6A8885A308D3ULL;
+        for (int i = 0; i < RANKS; i++) {
+            h = (h ^ counts[i]) * 0x100000001B3ULL;
+            h ^= h >> 29;
+        }
+        h ^= h >> 32;
+        h *= 0xD6E8FEB86659FD93ULL;
+        return h ^ (h >> 32);
+    }
+};
+
+#endif
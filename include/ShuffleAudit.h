@@ -0,0 +1,103 @@
+#ifndef SHUFFLEAUDIT_H
+#define SHUFFLEAUDIT_H
+
+#include "Deck.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * AUDIT OPTIONS / RESULT
+ */
+struct AuditOptions {
+    long long shoes = 10000000;     // Shoes generated and tested
+    int shoeSize = 52;              // Cards per shoe (GameConfig::deckSize)
+    long long verifyShoes = 1000;   // Shoes also built as real Deck objects and compared
+    int threads = 1;
+    uint64_t seed = 1;
+};
+
+// One goodness-of-fit test: a chi-square statistic and its p-value
+struct AuditTest {
+    std::string name;
+    std::string description;
+    double statistic = 0.0;
+    long long degreesOfFreedom = 0;
+    double pValue = 1.0;
+};
+
+struct AuditResult {
+    long long shoes = 0;
+    long long cards = 0;
+    long long verifiedShoes = 0;    // Built through Deck's constructor and drawCard
+    long long mismatches = 0;       // Cards where Deck disagreed with the audit (must be 0)
+    std::vector<AuditTest> tests;
+    double seconds = 0.0;
+
+    double cardsPerSecond() const { return seconds > 0.0 ? cards / seconds : 0.0; }
+    double minPValue() const;
+};
+
+/*
+ * SHUFFLEAUDIT CLASS
+ * ------------------
+ * Evidence that Deck's cards are unbiased: generates many shoes exactly as
+ * Deck does and runs chi-square tests on the result.
+ *
+ * SAME CODE PATH, NO ALLOCATION:
+ * - Shoe s is seeded like the game seeds a Deck and its cards come from
+ *   Deck::randomCard(), the function Deck's constructor uses, so the audit
+ *   sees exactly the card sequence a Deck with that seed would hold
+ * - The first 'verifyShoes' shoes are ALSO built as real Deck objects and
+ *   drawn card by card; any difference from the audited sequence is
+ *   reported as a mismatch
+ * - Everything else is counters, so billions of shoes take minutes
+ *
+ * STREAMING AND PARALLEL:
+ * - Shoes are processed in blocks of BLOCK_SHOES; block b uses random
+ *   stream b. Threads claim blocks from an atomic counter and add into
+ *   their own count tables, which are summed at the end. Counts are
+ *   integers, so the report does not depend on the thread count
+ * - Memory is about 25 KB per thread, whatever the number of shoes
+ *
+ * TESTS (all against the exact uniform model: every card type 1/52):
+ *   rank, suit, card          - overall frequencies
+ *   rank-by-position,
+ *   suit-by-position          - frequencies at each of the first
+ *                               TRACKED_POSITIONS positions of a shoe
+ *   first-card                - the card at position 0
+ *   first-ace-position        - where a shoe's first ace appears
+ *                               (geometric with p = 1/13 if unbiased)
+ *   serial-pairs              - ranks of non-overlapping consecutive pairs
+ *                               (13 x 13; overlapping pairs are not
+ *                               independent, so no plain chi-square)
+ *   serial-correlation        - lag-1 correlation of ranks (z squared)
+ *
+ * p-values come from the chi-square distribution; a fair Deck gives
+ * p-values spread evenly over (0, 1), so one tiny p-value among many
+ * tests is expected now and then, while a real bias drives p towards 0
+ * as the number of shoes grows.
+ */
+class ShuffleAudit {
+public:
+    static const int BLOCK_SHOES = 65536;
+    static const int TRACKED_POSITIONS = 52;
+
+    explicit ShuffleAudit(const AuditOptions& options);
+
+    AuditResult run() const;
+
+    // P(X >= statistic) for a chi-square variable with 'degreesOfFreedom'
+    static double chiSquarePValue(double statistic, long long degreesOfFreedom);
+
+private:
+    struct Counts;
+
+    AuditOptions options;
+
+    void auditBlock(long long block, Counts& counts) const;
+    long long verifyDecks() const;
+    static uint64_t shoeSeed(Rng& blockRng) { return blockRng.next(); }
+};
+
+#endif
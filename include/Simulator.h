@@ -0,0 +1,181 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "GameConfig.h"
+#include "HandHistory.h"
+#include "PlayerPolicy.h"
+#include "RoundStats.h"
+#include "Rules.h"
+#include "Rng.h"
+#include "ShoeState.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * CARDSCRIPT STRUCT
+ * -----------------
+ * Pre-generated cards for RoundEngine::playScriptedRound, in dealing
+ * order: a whole shuffled shoe, or the first cards of one round. Several
+ * strategies can then play exactly the same cards (common random numbers,
+ * see StrategyComparison). Copies of a script deal the same cards.
+ */
+struct CardScript {
+    const uint8_t* ranks = nullptr;  // Ranks 1-13 in dealing order
+    int size = 0;                    // Cards in 'ranks'
+    int next = 0;                    // Next card to deal
+    Rng overflow;                    // Cards past 'size': independent random ranks (Deck shoes only)
+    bool finished = false;           // The shoe ran low and was replaced
+};
+
+/*
+ * ROUNDENGINE CLASS
+ * -----------------
+ * Plays one headless round with the same rules as Game:
+ *   deal (player, player, dealer) -> player turn -> dealer turn -> score
+ * and then, like Game::resetRound, replaces the shoe when it runs low.
+ *
+ * The shoe is a ShoeState:
+ * - useCompositionDeck = true : cards are drawn without replacement
+ * - useCompositionDeck = false: every card is an independent random rank,
+ *   exactly like Deck; only the number of cards left is tracked
+ *
+ * RULE SETS:
+ * playRoundWith<Rules>() is compiled separately for each rule set (see
+ * Rules.h), so rules that are switched off cost nothing. playRound()
+ * picks the version matching GameConfig::ruleVariant.
+ *
+ * SCRIPTED ROUNDS:
+ * playScriptedRound() deals from a CardScript instead of drawing random
+ * cards. The shoe is kept up to date the same way, and when it runs low
+ * the script is marked finished (the caller moves on to its next shoe).
+ */
+class RoundEngine {
+public:
+    explicit RoundEngine(const GameConfig& config);
+
+    ShoeState freshShoe() const;
+    int drawRank(ShoeState& shoe, Rng& rng) const;
+    RoundRecord playRound(ShoeState& shoe, Rng& rng, const PlayerPolicy& policy) const;
+
+    template <typename Rules>
+    RoundRecord playRoundWith(ShoeState& shoe, Rng& rng, const PlayerPolicy& policy) const;
+
+    RoundRecord playScriptedRound(ShoeState& shoe, CardScript& script, const PlayerPolicy& policy) const;
+
+    int getDealerThreshold() const { return dealerThreshold; }
+    RuleVariant getRuleVariant() const { return ruleVariant; }
+
+private:
+    int deckSize;
+    int reshuffleThreshold;
+    int dealerThreshold;
+    bool composition;
+    RuleVariant ruleVariant;
+
+    // The round itself; 'cards' deals (random or scripted)
+    template <typename Rules, typename Cards>
+    RoundRecord playRoundFrom(ShoeState& shoe, Cards& cards, const PlayerPolicy& policy) const;
+};
+
+// Pre-instantiated in Simulator.cpp for the common rule sets
+extern template RoundRecord RoundEngine::playRoundWith<ClassicRules>(ShoeState&, Rng&, const PlayerPolicy&) const;
+extern template RoundRecord RoundEngine::playRoundWith<StandardRules>(ShoeState&, Rng&, const PlayerPolicy&) const;
+extern template RoundRecord RoundEngine::playRoundWith<VegasRules>(ShoeState&, Rng&, const PlayerPolicy&) const;
+
+/*
+ * SIMULATION OPTIONS / RESULT
+ */
+class TelemetryPublisher;
+
+struct SimulationOptions {
+    uint64_t seed = 1;
+    int threads = 1;
+    long long blockRounds = 4096;  // Rounds per independent block
+    int blocksPerEpoch = 64;       // Blocks simulated between early-stop checks
+    std::string checkpointPath;    // Empty = no checkpoints
+    bool resume = false;           // Continue from checkpointPath if it exists
+    std::string historyPath;       // Append every round to this HandLog (empty = none)
+    TelemetryPublisher* telemetry = nullptr;  // Live progress for blackjack_top (not owned)
+};
+
+struct SimulationResult {
+    RoundStats stats;
+    bool reachedTarget = false;  // Stopped early because the CI was narrow enough
+    double seconds = 0.0;
+    long long resumedRounds = 0; // Rounds taken over from a checkpoint
+    int checkpointFailures = 0;  // Checkpoint writes that failed (the file keeps an older state)
+};
+
+/*
+ * SIMULATOR CLASS
+ * ---------------
+ * Runs many rounds across threads and stops as soon as the answer is
+ * precise enough.
+ *
+ * DETERMINISTIC BLOCKS:
+ * - The run is cut into fixed-size blocks. Block b always uses random
+ *   stream Rng::forStream(seed, b) and starts from a fresh shoe.
+ * - Threads grab block numbers from an atomic counter and write into their
+ *   own result slot (a per-block "shard") - no locks anywhere.
+ * - After each epoch the shards are merged IN BLOCK ORDER, so the result is
+ *   identical for any number of threads.
+ *
+ * EARLY STOP:
+ * After each epoch, if the 95% confidence interval on the player edge is
+ * narrower than GameConfig::targetEdgeCIWidth, the run stops. It never
+ * goes beyond GameConfig::maxSimulationRounds.
+ *
+ * CHECKPOINTS:
+ * Because every block starts from its own random stream and a fresh shoe,
+ * the whole state between epochs is just "next block + merged stats".
+ * With a checkpoint path that pair is handed to a CheckpointWriter after
+ * every epoch (written in the background, the round loop never waits).
+ * With 'resume' a run picks up from the file and finishes with exactly
+ * the numbers an uninterrupted run gives. The file also records the seed,
+ * block sizes, rules and the policy's identity (PlayerPolicy::identity:
+ * kind, parameters, table or rule file contents), and refuses to resume a
+ * different run. The file is written once before the first epoch, so a
+ * path that cannot be written throws TableFormatException up front; later
+ * failed writes are counted in SimulationResult::checkpointFailures.
+ *
+ * HAND HISTORY:
+ * With a history path every round is appended to a HandLog, block by
+ * block in block order after each epoch (so the log is the same for any
+ * thread count). HandIndex answers questions about it later. The
+ * checkpoint records the log's length; a resumed run cuts the log back to
+ * it, so epochs the checkpoint had not caught up with are not logged twice.
+ *
+ * LIVE TELEMETRY:
+ * With a TelemetryPublisher, worker thread t publishes its rounds and
+ * blocks in slot t after every block; the merged edge, CI width and the
+ * epoch's queue depth follow after each epoch (see Telemetry.h).
+ */
+class Simulator {
+public:
+    Simulator(const GameConfig& config, const PlayerPolicy& policy);
+
+    SimulationResult run(const SimulationOptions& options) const;
+
+    // One block on its own - the unit of work for threads and workers.
+    // With 'history', every round is also added to it as a HandRecord
+    RoundStats runBlock(uint64_t seed, long long blockIndex, long long rounds,
+                        std::vector<HandRecord>* history = nullptr) const;
+
+private:
+    GameConfig config;
+    const PlayerPolicy& policy;
+    RoundEngine engine;
+
+    template <typename Rules>
+    RoundStats runBlockWith(uint64_t seed, long long blockIndex, long long rounds,
+                            std::vector<HandRecord>* history) const;
+
+    uint64_t checkpointKey(const SimulationOptions& options) const;
+    bool loadCheckpoint(const SimulationOptions& options, long long& nextBlock, SimulationResult& result,
+                        long long& historyRecords) const;
+    std::string checkpointText(const SimulationOptions& options, long long nextBlock, const SimulationResult& result,
+                               long long historyRecords) const;
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "GameConfig.h"
+#include "MemoCache.h"
+#include "ShoeState.h"
+#include "TableState.h"
+
+/*
+ * SOLVER CLASS
+ * ------------
+ * Calculates EXACT probabilities for a round instead of simulating it.
+ *
+ * WHAT IT ANSWERS:
+ * - How does the dealer finish from a given hand?  (dealerDistribution)
+ * - For the player: what happens if I stand, what if I hit?  (actionValues)
+ * - For a whole round from the deal, with best play?  (roundOutcome)
+ *
+ * HOW:
+ * Recursion over "which card comes next", weighted by its probability:
+ * - Finite shoe (CompositionDeck): probability = count / remaining and
+ *   the card is removed from the shoe for the rest of that branch
+ * - Infinite shoe (Deck): every rank has probability 1/13 independently,
+ *   because Deck generates each card at random
+ *
+ * The dealer draws below its strategy threshold and, with rule sets that
+ * have hitSoft17 (Vegas), also on soft 17 - the same test as dealerDraws.
+ * Naturals, doubling, splitting and surrender are not modelled: every
+ * hand is worth one point.
+ *
+ * MEMOISATION:
+ * The same subproblem (shoe composition + hands) is reached by many
+ * different card orders. Results are stored in shared MemoCache tables,
+ * so several threads can use one Solver (or several) without locks.
+ * The caches are optional - pass nullptr to solve without memory.
+ */
+
+// Probabilities of winning and losing (tie = 1 - win - loss)
+struct Outcome {
+    double win = 0.0;
+    double loss = 0.0;
+
+    double tie() const { return 1.0 - win - loss; }
+
+    // Expected points per round (+1 win, -1 loss, 0 tie)
+    double value() const { return win - loss; }
+};
+
+// Where the dealer ends up: p[score] for 0-21, p[BUST] for over 21
+struct DealerDistribution {
+    static const int BUST = 22;
+    double p[24] = {};  // [23] is padding to keep the size a multiple of 8
+};
+
+// Result of each choice the player has in a position
+struct ActionValues {
+    Outcome stand;
+    Outcome hit;    // Equal to 'stand' when hitting is not allowed
+
+    PlayerAction best() const { return hit.value() > stand.value() ? PlayerAction::Hit : PlayerAction::Stand; }
+    const Outcome& bestOutcome() const { return hit.value() > stand.value() ? hit : stand; }
+};
+
+class Solver {
+public:
+    typedef MemoCache<DealerDistribution> DealerCache;
+    typedef MemoCache<ActionValues> PlayerCache;
+
+    Solver(const GameConfig& config, DealerCache* dealerCache = nullptr, PlayerCache* playerCache = nullptr);
+
+    DealerDistribution dealerDistribution(const ShoeState& shoe, const HandState& dealer);
+    Outcome standOutcome(const ShoeState& shoe, const HandState& player, const HandState& dealer);
+    ActionValues actionValues(const ShoeState& shoe, const HandState& player, const HandState& dealer);
+
+    // Whole round from the deal (player, player, dealer) with best play
+    Outcome roundOutcome(const ShoeState& shoe);
+
+    bool isInfiniteDeck() const { return infiniteDeck; }
+    int getDealerThreshold() const { return dealerThreshold; }
+    bool hitsSoft17() const { return hitSoft17; }
+
+private:
+    int dealerThreshold;
+    bool hitSoft17;
+    bool infiniteDeck;
+    DealerCache* dealerCache;
+    PlayerCache* playerCache;
+
+    double rankProbability(const ShoeState& shoe, int rank) const;
+    ShoeState without(const ShoeState& shoe, int rank) const;
+};
+
+#endif
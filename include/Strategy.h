@@ -1,6 +1,8 @@
 #ifndef STRATEGY_H
 #define STRATEGY_H
 
+#include <memory>
+
 /*
  * STRATEGY DESIGN PATTERN
  * -----------------------
@@ -28,6 +30,18 @@ public:
     // Pure virtual function - each strategy must implement this
     virtual bool shouldDraw(int score) = 0;
 
+    // The whole hand and the Hi-Lo running count of the shoe. Threshold
+    // strategies only look at the score; rule-driven ones (RuleTable.h)
+    // can also depend on soft hands and the count.
+    virtual bool shouldDrawHand(int score, bool, int) {
+        return shouldDraw(score);
+    }
+
+    // The score at which this strategy stops drawing.
+    // Exposed so batch simulators can apply the same rule as a
+    // branch-free comparison instead of a virtual call per card.
+    virtual int getThreshold() const = 0;
+
     // Virtual destructor for proper cleanup through base pointer
     virtual ~DrawStrategy() = default;
 };
@@ -40,7 +54,10 @@ public:
  */
 class ConservativeStrategy : public DrawStrategy {
 public:
+    static const int THRESHOLD = 15;
+
     bool shouldDraw(int score) override;
+    int getThreshold() const override;
 };
 
 /*
@@ -51,7 +68,18 @@ public:
  */
 class AggressiveStrategy : public DrawStrategy {
 public:
+    static const int THRESHOLD = 18;
+
     bool shouldDraw(int score) override;
+    int getThreshold() const override;
 };
 
+/*
+ * STRATEGY FACTORY
+ * ----------------
+ * Creates the dealer strategy chosen by GameConfig::useAggressiveDealer.
+ * Shared by the simulators and solvers so they always match the Game.
+ */
+std::unique_ptr<DrawStrategy> createDealerStrategy(bool aggressive);
+
 #endif
@@ -0,0 +1,139 @@
+#ifndef STRATEGYCOMPARISON_H
+#define STRATEGYCOMPARISON_H
+
+#include "GameConfig.h"
+#include "PlayerPolicy.h"
+#include "Simulator.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * CONTENDER
+ * ---------
+ * One strategy in a comparison: a dealer strategy (config.useAggressiveDealer)
+ * and a player policy. Shoe settings (deck size, reshuffle threshold,
+ * composition, rules) are taken from the FIRST contender for everyone,
+ * because all contenders play the same shoes.
+ */
+struct Contender {
+    std::string name;
+    GameConfig config;
+    const PlayerPolicy* policy = nullptr;
+};
+
+/*
+ * COMPARISON OPTIONS / RESULT
+ */
+struct ComparisonOptions {
+    uint64_t seed = 1;
+    int threads = 1;
+    int blockUnits = 4096;         // Rounds (Deck) or shoes (composition) generated together
+    int blocksPerEpoch = 16;       // Blocks between precision checks
+    bool antithetic = true;        // Also play the mirror image of every round / shoe
+    double targetHalfWidth = 0.0;  // Stop when every difference is this precise (0 = run to maxRounds)
+    long long maxRounds = 10000000; // Rounds of the first contender
+};
+
+struct ContenderResult {
+    std::string name;
+    long long rounds = 0;
+    double edge = 0.0;             // Net points per round
+    double halfWidth = 0.0;        // 95% confidence half-width
+};
+
+// Contender k compared with the first contender (the baseline)
+struct ContrastResult {
+    std::string name;
+    double difference = 0.0;           // edge(k) - edge(baseline)
+    double halfWidth = 0.0;            // 95% half-width from the paired shoes
+    double independentHalfWidth = 0.0; // What independent simulations of the same size would give
+    // Independent simulations would need this many times the rounds for the same precision
+    double roundsSaved() const {
+        return halfWidth > 0.0 ? (independentHalfWidth / halfWidth) * (independentHalfWidth / halfWidth) : 0.0;
+    }
+};
+
+struct ComparisonResult {
+    std::vector<ContenderResult> contenders;
+    std::vector<ContrastResult> contrasts;  // One per contender after the first
+    long long units = 0;                    // Rounds (Deck) or shoes (composition), mirrors included
+    bool antithetic = false;                // Mirrors were actually played
+    bool reachedTarget = false;
+    double seconds = 0.0;
+};
+
+/*
+ * STRATEGYCOMPARISON CLASS
+ * ------------------------
+ * Compares strategies on IDENTICAL cards, so luck cancels out of the
+ * difference and far fewer rounds are needed than with separate runs.
+ *
+ * COMMON RANDOM NUMBERS:
+ * The cards are generated up front, a block at a time (block b from random
+ * stream b), and every contender plays exactly those cards through
+ * RoundEngine::playScriptedRound. The UNIT of pairing depends on the shoe:
+ * - Deck shoes (every card an independent random rank): each ROUND gets
+ *   its own ROUND_CARDS pre-generated cards (plus an overflow stream for
+ *   the rare longer round), and round r of every contender starts from
+ *   them. The same hands meet the same dealer upcards, so the rounds are
+ *   paired one to one; each contender's shoe still only decides when it
+ *   is replaced, exactly as in the game
+ * - Composition shoes (--composition): cards are taken out, so rounds
+ *   cannot be re-dealt. Each contender plays a whole shuffled SHOE until
+ *   it runs low; strategies that use more cards play fewer rounds of it
+ *
+ * ANTITHETIC VARIATES:
+ * Each unit is also played as its mirror image, with small and big cards
+ * swapped (2<->A, 3<->K, 4<->Q, 5<->J, 6<->10, 7<->9, 8 stays). A rich deal
+ * and its poor mirror pull the results in opposite directions, so their
+ * sum is steadier. The mirror must be just as likely as the original, so
+ * a composition shoe whose rank counts are not all equal is not mirrored.
+ *
+ * ESTIMATES:
+ * The edge of a contender is (net over all units) / (rounds over all
+ * units). For each unit (with its mirror, if any) the per-unit
+ * net and round counts of all contenders are added into running first and
+ * second moments, so nothing is stored per shoe. Confidence intervals of
+ * the edges and of the paired differences come from the delta method on
+ * those moments. 'independentHalfWidth' is the same formula without the
+ * cross terms between contenders, i.e. what unpaired runs would give.
+ *
+ * Threads claim blocks; block sums are merged in block order after every
+ * epoch, so the result does not depend on the thread count.
+ */
+class StrategyComparison {
+public:
+    static const int ROUND_CARDS = 16;  // Pre-generated cards per round (Deck shoes)
+
+    explicit StrategyComparison(const std::vector<Contender>& contenders);
+
+    ComparisonResult run(const ComparisonOptions& options) const;
+
+    bool antitheticSupported() const;
+
+private:
+    struct Moments;
+
+    // One thread's buffers, reused for every block
+    struct Scratch {
+        std::vector<uint8_t> cards;           // Units, each followed by its mirror
+        std::vector<uint64_t> overflowSeeds;  // One per round (Deck shoes)
+        std::vector<ShoeState> shoes;         // One per contender (Deck shoes)
+        std::vector<double> totals;           // Net and rounds per contender for one unit
+    };
+
+    std::vector<Contender> contenders;
+    std::vector<RoundEngine> engines;  // One per contender (dealer strategies differ)
+    GameConfig shoeConfig;             // Shoe settings shared by everyone
+
+    int unitCards() const;
+    void fillShoe(Rng& rng, uint8_t* ranks) const;
+    void playShoe(const uint8_t* ranks, double* totals) const;
+    void playRound(const CardScript& script, std::vector<ShoeState>& shoes, double* totals) const;
+    void runBlock(const ComparisonOptions& options, long long block, bool antithetic, Scratch& scratch,
+                  Moments& moments) const;
+    ComparisonResult summarise(const Moments& moments, bool antithetic) const;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef STRATEGYTABLES_H
+#define STRATEGYTABLES_H
+
+#include "DecisionTable.h"
+#include "GameConfig.h"
+#include "Solver.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * TABLE FILE HEADER
+ * -----------------
+ * First bytes of a strategy table file. Every section after it is a plain
+ * array of trivially copyable structs at an 8-byte aligned offset, so the
+ * file can be used straight from memory without any parsing.
+ */
+struct TableFileHeader {
+    char magic[8];               // "BJTABLES"
+    uint32_t version;            // StrategyTables::VERSION
+    uint32_t headerSize;         // sizeof(TableFileHeader) when written
+    uint64_t configHash;         // StrategyTables::configHash() of the rules used
+    uint64_t fileSize;
+    uint64_t dealerOffset;       // DealerDistribution[UPCARDS + 1]
+    uint64_t actionOffset;       // ActionValues[2][TOTALS][UPCARDS + 1]
+    Outcome roundOutcome;        // Whole round from the deal, best play
+};
+
+/*
+ * STRATEGYTABLES CLASS
+ * --------------------
+ * Solver results saved ONCE to a binary file and then shared by every
+ * Game and simulator process: the dealer's final-score distribution for
+ * each upcard, the hit/stand values for every (hard/soft total, upcard),
+ * and the odds of a whole round (all for an infinite deck).
+ *
+ * WHY MEMORY-MAP:
+ * The file is mapped read-only into memory (mmap) instead of being read.
+ * Opening it is almost free, and every process that maps the same file
+ * shares the same physical pages - ten workers cost the memory of one.
+ *
+ * VERSIONED AND KEYED:
+ * The file name and header carry a hash of the rules that change the
+ * answers (dealer threshold, whether the dealer hits soft 17) plus the
+ * format version. Classic and Standard share a file: the solver only
+ * models hit and stand, and their dealers play alike.
+ * A missing file, a different version, a different hash or a wrong size
+ * all count as STALE: openOrBuild() then solves again and rewrites the
+ * file (to a temporary name, then renamed, so readers never see half a
+ * file). If the directory cannot be written, the tables simply live in
+ * memory for this run.
+ */
+class StrategyTables {
+public:
+    static const uint32_t VERSION = 2;  // 2: the dealer hits soft 17 under Vegas rules
+    static const int TOTALS = DecisionTable::MAX_TOTAL + 1;
+    static const int UPCARDS = DecisionTable::UPCARDS;
+
+    ~StrategyTables();
+    StrategyTables(const StrategyTables&) = delete;
+    StrategyTables& operator=(const StrategyTables&) = delete;
+
+    static uint64_t configHash(const GameConfig& config);
+    static std::string defaultPath(const GameConfig& config);
+
+    // nullptr if the file is missing or stale
+    static std::unique_ptr<StrategyTables> open(const std::string& path, const GameConfig& config);
+    static std::unique_ptr<StrategyTables> openOrBuild(const GameConfig& config, const std::string& path);
+    static std::unique_ptr<StrategyTables> openOrBuild(const GameConfig& config);
+
+    const DealerDistribution& dealerDistribution(int upcard) const;
+    const ActionValues& actionValues(bool soft, int total, int upcard) const;
+    const Outcome& roundOutcome() const { return header->roundOutcome; }
+    DecisionTable decisionTable() const;
+
+    bool isMapped() const { return mapping != nullptr; }  // false = private copy in memory
+    bool wasBuilt() const { return built; }                // Solved during this open
+
+private:
+    const TableFileHeader* header;
+    const DealerDistribution* dealer;
+    const ActionValues* actions;
+    void* mapping;               // mmap'ed region, if any
+    size_t mappingSize;
+    std::vector<uint64_t> owned; // In-memory copy when mapping is not possible
+    bool built;
+
+    StrategyTables();
+    bool attach(const char* data, size_t size, const GameConfig& config);
+    static std::vector<uint64_t> solve(const GameConfig& config);
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef SWEEPRUNNER_H
+#define SWEEPRUNNER_H
+
+#include "GameConfig.h"
+#include "RoundStats.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * SWEEP POINT / RESULT
+ * --------------------
+ * One GameConfig variant to simulate, and what came out of it.
+ */
+struct SweepPoint {
+    std::string label;
+    GameConfig config;
+};
+
+struct SweepResult {
+    SweepPoint point;
+    RoundStats stats;
+    bool reachedTarget = false;  // Stopped early: the edge CI was narrow enough
+
+    // Whole game (first to targetScore) from 0:0, from the measured round odds
+    double matchWin = 0.0;
+    double matchRounds = 0.0;    // Expected rounds per game
+};
+
+/*
+ * SWEEPGRID STRUCT
+ * ----------------
+ * Lists of values to try for each tunable setting. expand() builds every
+ * combination (the cartesian product), starting from a base config so
+ * settings that are not swept keep their preset values.
+ */
+struct SweepGrid {
+    std::vector<int> deckSizes;
+    std::vector<int> reshuffleThresholds;
+    std::vector<int> targetScores;
+    std::vector<bool> aggressiveDealers;
+    std::vector<int> playerStandThresholds;
+
+    std::vector<SweepPoint> expand(const GameConfig& base) const;
+};
+
+/*
+ * SWEEPRUNNER CLASS
+ * -----------------
+ * Simulates a list of GameConfig variants using every core.
+ *
+ * SCHEDULING:
+ * - Each point is split into sub-batches of Simulator blocks, and every
+ *   sub-batch is a separate task on a work-stealing ThreadPool
+ * - A slow point (big shoe, many rounds) is therefore spread over all
+ *   cores instead of keeping one core busy while the others sit idle
+ * - Block results are merged per point in block order, so the table is
+ *   the same for any number of threads
+ *
+ * EARLY STOP:
+ * Like Simulator::run, a point stops once the 95% CI on its edge is
+ * narrower than its GameConfig::targetEdgeCIWidth, and never runs more
+ * than maxSimulationRounds. The CI is checked on the blocks merged so far,
+ * in block order, at every sub-batch boundary - fixed places, so the stop
+ * (and the table) still does not depend on the thread count. Sub-batches
+ * past the stop are skipped, or thrown away if they already ran.
+ *
+ * Each point plays the ThresholdPolicy given by its playerStandThreshold.
+ * Per-round numbers do not depend on targetScore; the match columns do
+ * (MatchOdds over the measured win and loss rates).
+ */
+class SweepRunner {
+public:
+    SweepRunner(int threads, uint64_t seed);
+
+    void setBlockRounds(long long rounds);   // Rounds per block
+    void setBlocksPerTask(int blocks);       // Blocks per sub-batch task
+
+    std::vector<SweepResult> run(const std::vector<SweepPoint>& points) const;
+
+    static void writeCsv(std::ostream& out, const std::vector<SweepResult>& results);
+    static void writeJson(std::ostream& out, const std::vector<SweepResult>& results);
+
+private:
+    int threads;
+    uint64_t seed;
+    long long blockRounds;
+    int blocksPerTask;
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef TABLESTATE_H
+#define TABLESTATE_H
+
+#include "ShoeState.h"
+#include "Rng.h"
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * TABLE STATE FOR BRANCH EXPLORATION
+ * ----------------------------------
+ * Solvers and look-ahead AIs need to ask "what if I hit?" and "what if I
+ * stand?" from the SAME position. With Deck and Player that means deep
+ * copying Card** arrays and Card objects, which is slow and error-prone
+ * because ownership moves from Deck to Player.
+ *
+ * These types hold the same information as plain values:
+ * - HandState  : a hand as totals (no Card objects)
+ * - TableState : the shoe plus both hands (about 64 bytes)
+ * - DrawUndoLog: a fixed-size record of draws that can be undone one by one
+ *
+ * SNAPSHOT / RESTORE:
+ *   TableState saved = table;   // snapshot - a plain copy, no heap allocation
+ *   ... explore a branch ...
+ *   table = saved;              // restore
+ */
+
+// Which hand a card goes to
+enum class Seat : uint8_t {
+    Player = 0,
+    Dealer = 1
+};
+
+// A player decision (Double, Split and Surrender need a rule set that allows them)
+enum class PlayerAction : uint8_t {
+    Stand = 0,
+    Hit = 1,
+    Double = 2,
+    Split = 3,
+    Surrender = 4
+};
+
+/*
+ * HANDSTATE STRUCT
+ * ----------------
+ * Everything Player::getScore needs, without storing the cards.
+ * Aces are counted as 1 in 'total'; getScore adds 10 for one Ace when it fits.
+ */
+struct HandState {
+    uint8_t total = 0;   // Hard total with every Ace counted as 1
+    uint8_t aces = 0;    // Number of Aces in the hand
+    uint8_t cards = 0;   // Number of cards in the hand
+    uint8_t first = 0;   // Rank of the first card (to recognise pairs)
+
+    void addRank(int rank) {
+        if (cards == 0) {
+            first = static_cast<uint8_t>(rank);
+        }
+        total = static_cast<uint8_t>(total + (rank > 10 ? 10 : rank));
+        aces = static_cast<uint8_t>(aces + (rank == 1 ? 1 : 0));
+        cards++;
+    }
+
+    // Same Ace rule as Player::getScore
+    int getScore() const {
+        return (aces > 0 && total + 10 <= 21) ? total + 10 : total;
+    }
+
+    // True when an Ace is currently being counted as 11
+    bool isSoft() const { return aces > 0 && total + 10 <= 21; }
+
+    bool isBust() const { return total > 21; }
+
+    // Two-card 21
+    bool isNatural() const { return cards == 2 && getScore() == 21; }
+
+    // Two cards of the same value (10, Jack, Queen and King all count as 10)
+    bool isPair() const {
+        if (cards != 2) {
+            return false;
+        }
+        if (first == 1) {
+            return aces == 2;
+        }
+        int value = first > 10 ? 10 : first;
+        return aces == 0 && total == 2 * value;
+    }
+};
+
+/*
+ * TABLESTATE STRUCT
+ * -----------------
+ * The shoe and both hands. Trivially copyable, so a snapshot is a memcpy.
+ */
+struct TableState {
+    ShoeState shoe;
+    HandState player;
+    HandState dealer;
+
+    HandState& hand(Seat seat) { return seat == Seat::Player ? player : dealer; }
+    const HandState& hand(Seat seat) const { return seat == Seat::Player ? player : dealer; }
+
+    // Draw a random card from the shoe into a hand; returns its rank
+    int draw(Seat seat, Rng& rng) {
+        int rank = shoe.drawRank(rng);
+        hand(seat).addRank(rank);
+        return rank;
+    }
+
+    // Deal a known card (for example one the real Deck just produced)
+    void deal(Seat seat, int rank) {
+        shoe.removeRank(rank);
+        hand(seat).addRank(rank);
+    }
+};
+
+/*
+ * DRAWUNDOLOG CLASS
+ * -----------------
+ * Remembers recent draws so they can be taken back one at a time.
+ * Uses a fixed array (no heap) - a Blackjack branch never needs more than
+ * a handful of cards, and the oldest entries are dropped if it overflows.
+ */
+class DrawUndoLog {
+public:
+    static const int CAPACITY = 32;
+
+    DrawUndoLog();
+
+    // Draw through the log so the draw can be undone later
+    int draw(TableState& table, Seat seat, Rng& rng);
+    void deal(TableState& table, Seat seat, int rank);
+
+    // Take back the most recent draw; returns false if nothing to undo
+    bool undo(TableState& table);
+
+    int size() const;
+    void clear();
+
+private:
+    struct Entry {
+        uint8_t rank;
+        Seat seat;
+        HandState before;   // Hand exactly as it was before the card
+    };
+
+    Entry entries[CAPACITY];
+    int start;   // Index of the oldest entry (circular buffer)
+    int count;
+
+    void record(Seat seat, int rank, const HandState& before);
+};
+
+// Compile-time guarantees that branching really is cheap
+static_assert(std::is_trivially_copyable<HandState>::value, "HandState must be trivially copyable");
+static_assert(std::is_trivially_copyable<TableState>::value, "TableState must be trivially copyable");
+static_assert(sizeof(TableState) <= 256, "TableState snapshot should stay small");
+static_assert(std::is_trivially_copyable<DrawUndoLog>::value, "DrawUndoLog must be trivially copyable");
+
+#endif
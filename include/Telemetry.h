@@ -0,0 +1,155 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+ * TELEMETRY SEGMENT LAYOUT
+ * ------------------------
+ * What a running simulator publishes for blackjack_top, as a fixed-layout
+ * POSIX shared-memory segment named "/blackjack_sim.<pid>".
+ *
+ * - The header is written once, before anything else
+ * - Each worker thread (or, for distribute, each worker process slot) owns
+ *   ONE TelemetryWorker, a cache line of its own. After every block it
+ *   stores its counters with relaxed atomics: no locks, no read-modify-
+ *   write, no cache line shared with another worker
+ * - The run totals (rounds, edge, CI width, queue depths) are stored by
+ *   the one thread that merges the results, once per epoch or wave (or,
+ *   in a single-threaded distribute worker, once per block). Workers
+ *   never touch them, so each total has exactly one writer
+ * - Readers only load. Values can be a block apart from each other, which
+ *   is fine for a live view
+ *
+ * Times are steady-clock nanoseconds (CLOCK_MONOTONIC), which all
+ * processes on the machine share. Doubles are stored as their bits.
+ */
+struct alignas(64) TelemetryWorker {
+    std::atomic<uint64_t> rounds;        // Rounds finished
+    std::atomic<uint64_t> blocks;        // Blocks finished
+    std::atomic<uint64_t> startNanos;    // When the slot went live (0 = unused)
+    std::atomic<uint64_t> updatedNanos;  // When the last block finished
+};
+
+struct TelemetrySegment {
+    static const uint32_t MAGIC = 0x4D4C4542;  // "BELM"
+    static const uint32_t VERSION = 1;
+    static const int MAX_WORKERS = 64;
+
+    enum State : uint64_t { Running = 0, Finished = 1 };
+
+    // Header - written once
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;                       // sizeof(TelemetrySegment) of the writer
+    uint32_t workerSlots;                // Slots in use (at most MAX_WORKERS)
+    int64_t pid;
+    int64_t parentPid;                   // distribute workers point to their coordinator
+    uint64_t startNanos;
+    char role[32];                       // "simulate", "worker", "distribute"
+
+    // Run totals - written by the merging thread
+    alignas(64) std::atomic<uint64_t> state;
+    std::atomic<uint64_t> totalRounds;   // Merged into the estimate so far
+    std::atomic<uint64_t> maxRounds;
+    std::atomic<uint64_t> edgeBits;      // double: points per round
+    std::atomic<uint64_t> ciWidthBits;   // double: full width of the 95% CI
+    std::atomic<uint64_t> targetBits;    // double: CI width that stops the run (0 = none)
+    std::atomic<uint64_t> epochs;        // Merges so far
+    std::atomic<uint64_t> queued;        // Blocks (or shards) not started yet
+    std::atomic<uint64_t> inFlight;      // Blocks of the current epoch (or running shards)
+    std::atomic<uint64_t> updatedNanos;
+
+    TelemetryWorker workers[MAX_WORKERS];
+
+    static uint64_t toBits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+    static double fromBits(uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+/*
+ * TELEMETRYPUBLISHER CLASS
+ * ------------------------
+ * Creates this process's segment and removes it again in the destructor.
+ * If shared memory is not available the publisher is simply closed and
+ * every call does nothing, so a run never fails because of telemetry.
+ *
+ * Hot path: worker(slot) once per thread, then blockDone() per block.
+ */
+class TelemetryPublisher {
+public:
+    TelemetryPublisher(const std::string& role, int workerSlots);
+    ~TelemetryPublisher();
+
+    TelemetryPublisher(const TelemetryPublisher&) = delete;
+    TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
+
+    bool isOpen() const { return segment != nullptr; }
+    const std::string& getName() const { return name; }
+
+    // A worker's own slot (nullptr when closed or out of range); marks it live
+    TelemetryWorker* worker(int slot);
+
+    static void blockDone(TelemetryWorker* worker, uint64_t rounds) {
+        if (worker != nullptr) {
+            store(worker->rounds, worker->rounds.load(std::memory_order_relaxed) + rounds);
+            store(worker->blocks, worker->blocks.load(std::memory_order_relaxed) + 1);
+            store(worker->updatedNanos, nowNanos());
+        }
+    }
+
+    void setLimits(long long maxRounds, double targetWidth);
+    void setQueue(long long queued, long long inFlight);
+    void setEstimate(long long rounds, double edge, double ciWidth);
+    void finish();
+
+    static uint64_t nowNanos();
+    static const char* const PREFIX;  // "blackjack_sim."
+
+private:
+    std::string name;
+    TelemetrySegment* segment;
+
+    static void store(std::atomic<uint64_t>& field, uint64_t value) {
+        field.store(value, std::memory_order_relaxed);
+    }
+};
+
+/*
+ * TELEMETRYREADER CLASS
+ * ---------------------
+ * Read-only view of another process's segment (used by blackjack_top).
+ * Opening checks the magic, version and size, so a stranger's segment or
+ * an older layout is refused instead of misread.
+ */
+class TelemetryReader {
+public:
+    explicit TelemetryReader(const std::string& name);
+    ~TelemetryReader();
+
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+    bool isOpen() const { return segment != nullptr; }
+    const TelemetrySegment& get() const { return *segment; }
+    bool processAlive() const;
+
+    static std::vector<std::string> list();     // Names of all published segments
+    static bool remove(const std::string& name);
+
+private:
+    const TelemetrySegment* segment;
+};
+
+#endif
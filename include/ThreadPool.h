@@ -0,0 +1,67 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * THREADPOOL CLASS
+ * ----------------
+ * A fixed set of worker threads that run submitted tasks, with WORK STEALING.
+ *
+ * HOW WORK STEALING WORKS:
+ * - Every worker has its own queue (deque) of tasks
+ * - A worker takes tasks from the FRONT of its own queue
+ * - When its queue is empty it "steals" from the BACK of another
+ *   worker's queue instead of going to sleep
+ * So if one worker gets a slow task, the others pick up the rest of its
+ * queue and no core sits idle while there is still work to do.
+ *
+ * Each queue has its own small mutex, so workers almost never wait on
+ * each other (they only touch the same lock while stealing).
+ *
+ * USAGE:
+ *   ThreadPool pool(4);
+ *   pool.submit([]() { ... });
+ *   pool.wait();   // Blocks until every submitted task has finished
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    int getThreadCount() const;
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<std::function<void()> > tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue> > queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepLock;                 // Only used to sleep / wake workers
+    std::condition_variable workReady;
+    std::condition_variable allDone;
+    std::atomic<long long> pending;       // Submitted but not yet finished
+    std::atomic<unsigned> nextQueue;      // Round-robin target for submit()
+    bool stopping;
+
+    void workerLoop(int index);
+    bool takeTask(int index, std::function<void()>& task);
+};
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef BLACKJACK_C_API_H
+#define BLACKJACK_C_API_H
+
+/*
+ * LIBBLACKJACK C API
+ * ==================
+ * A stable C interface to the headless game engine (RoundEngine), for
+ * programs that want to run tables in-process instead of starting
+ * blackjack_sim. Link libblackjack.so / libblackjack.a (CMake targets
+ * blackjack_shared and blackjack_static) and include only this header.
+ *
+ * WHY BATCHES:
+ * One round takes well under a microsecond, so a call per round would be
+ * dominated by call and binding overhead (FFI, locks in the caller, ...).
+ * Every call here therefore does a batch of work:
+ * - bj_tables_create / bj_tables_destroy handle many tables at once
+ * - bj_tables_step plays one round on each of many tables
+ * - bj_table_simulate plays N rounds on one table
+ * Results go into buffers the caller owns; the library never allocates
+ * per round and never hands out memory the caller has to free.
+ *
+ * ABI RULES:
+ * - Only fixed-width integers, doubles and opaque pointers cross the
+ *   boundary; no C++ types, no exceptions (every error is a return code)
+ * - bj_config starts with its own size. Initialise it with
+ *   bj_config_init(); fields added in later versions go at the end, so a
+ *   program built against an older header keeps working
+ * - bj_round and bj_summary never change; new data gets new structs
+ * - BJ_ABI_VERSION changes only when an existing struct or function does
+ *
+ * DETERMINISM:
+ * A table created with (seed, stream) plays exactly the rounds that
+ * Simulator::runBlock(seed, stream, ...) plays: same random stream, same
+ * fresh shoe. bj_tables_create gives table i the stream 'stream + i'.
+ *
+ * THREADS:
+ * Tables are independent. Different threads may use different tables at
+ * the same time; one table must not be used by two threads at once.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(BLACKJACK_BUILDING_LIBRARY)
+#define BLACKJACK_API __declspec(dllexport)
+#elif defined(BLACKJACK_SHARED)
+#define BLACKJACK_API __declspec(dllimport)
+#else
+#define BLACKJACK_API
+#endif
+#else
+#define BLACKJACK_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BJ_ABI_VERSION 1
+
+/* Return codes */
+#define BJ_OK 0
+#define BJ_ERROR_INVALID_ARGUMENT (-1)
+#define BJ_ERROR_OUT_OF_MEMORY (-2)
+#define BJ_ERROR_INTERNAL (-3)
+
+/* bj_config.rules (see Rules.h) */
+#define BJ_RULES_CLASSIC 0    /* Hit and stand only */
+#define BJ_RULES_STANDARD 1   /* Plus double down and split */
+#define BJ_RULES_VEGAS 2      /* Plus late surrender */
+
+/* bj_config.policy: how the player decides */
+#define BJ_POLICY_THRESHOLD 0 /* Hit below player_stand_threshold */
+#define BJ_POLICY_BASIC 1     /* Textbook basic strategy */
+
+/* bj_round.flags */
+#define BJ_ROUND_PLAYER_BUST 0x01
+#define BJ_ROUND_DEALER_BUST 0x02
+#define BJ_ROUND_PLAYER_SOFT 0x04
+#define BJ_ROUND_DOUBLED 0x08
+#define BJ_ROUND_SPLIT 0x10
+#define BJ_ROUND_SURRENDERED 0x20
+
+/* The GameConfig settings a headless table uses */
+typedef struct bj_config {
+    uint32_t size;                   /* sizeof(bj_config); set by bj_config_init */
+    int32_t deck_size;               /* Cards in a fresh shoe */
+    int32_t reshuffle_threshold;     /* New shoe when fewer cards remain after a round */
+    int32_t composition_deck;        /* 1 = cards drawn without replacement, 0 = like Deck */
+    int32_t aggressive_dealer;       /* 1 = dealer draws below 18, 0 = below 15 */
+    int32_t rules;                   /* BJ_RULES_* */
+    int32_t policy;                  /* BJ_POLICY_* */
+    int32_t player_stand_threshold;  /* For BJ_POLICY_THRESHOLD */
+    uint64_t seed;
+    uint64_t stream;                 /* Random stream of the (first) table */
+} bj_config;
+
+/* One finished round (16 bytes) */
+typedef struct bj_round {
+    double net;              /* Points won (+) or lost (-) by the player */
+    int16_t player_score;
+    int16_t dealer_score;
+    uint8_t dealer_upcard;   /* Rank 1-13 */
+    uint8_t player_cards;
+    uint8_t dealer_cards;
+    uint8_t flags;           /* BJ_ROUND_* */
+} bj_round;
+
+/* Everything a table has played since it was created */
+typedef struct bj_summary {
+    uint64_t rounds;
+    uint64_t wins;
+    uint64_t ties;
+    uint64_t losses;
+    uint64_t player_busts;
+    uint64_t dealer_busts;
+    double edge;             /* Mean net points per round */
+    double edge_half_width;  /* 95% confidence half-width of the edge */
+} bj_summary;
+
+typedef struct bj_table bj_table;
+
+/* Version of the ABI the library was built with (compare with BJ_ABI_VERSION) */
+BLACKJACK_API uint32_t bj_abi_version(void);
+
+/* Message for the last error on the calling thread ("" if none) */
+BLACKJACK_API const char* bj_last_error(void);
+
+/* Fill 'config' with the library defaults (the Normal preset) */
+BLACKJACK_API void bj_config_init(bj_config* config);
+
+BLACKJACK_API int bj_table_create(const bj_config* config, bj_table** table);
+BLACKJACK_API void bj_table_destroy(bj_table* table);
+
+/* 'count' tables; table i uses stream config->stream + i. All or nothing */
+BLACKJACK_API int bj_tables_create(const bj_config* config, size_t count, bj_table** tables);
+BLACKJACK_API void bj_tables_destroy(bj_table** tables, size_t count);
+
+/* One round on each table; results[i] for tables[i] (results may be NULL) */
+BLACKJACK_API int bj_tables_step(bj_table* const* tables, size_t count, bj_round* results);
+
+/* 'rounds' rounds on one table into results[0..rounds) (results may be NULL) */
+BLACKJACK_API int bj_table_simulate(bj_table* table, uint64_t rounds, bj_round* results);
+
+BLACKJACK_API int bj_table_summary(const bj_table* table, bj_summary* summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,151 @@
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*
+ * ALLOCATIONTRACKER IMPLEMENTATION
+ * --------------------------------
+ */
+
+const char* AllocationTracker::phaseName(AllocationPhase phase) {
+    switch (phase) {
+    case AllocationPhase::Deal:
+        return "deal";
+    case AllocationPhase::PlayerTurn:
+        return "player turn";
+    case AllocationPhase::DealerTurn:
+        return "dealer turn";
+    case AllocationPhase::Settle:
+        return "settle";
+    case AllocationPhase::Reset:
+        return "reset";
+    case AllocationPhase::Other:
+    case AllocationPhase::COUNT:
+        break;
+    }
+    return "other";
+}
+
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+
+namespace {
+
+// Plain zero-initialised globals: ready before any constructor runs
+std::atomic<long long> allocationCount[AllocationTracker::PHASES];
+std::atomic<long long> freeCount[AllocationTracker::PHASES];
+std::atomic<long long> byteCount[AllocationTracker::PHASES];
+thread_local AllocationPhase threadPhase = AllocationPhase::Other;
+
+void* countedAllocate(std::size_t size) {
+    int index = static_cast<int>(threadPhase);
+    allocationCount[index].fetch_add(1, std::memory_order_relaxed);
+    byteCount[index].fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void countedFree(void* pointer) {
+    if (pointer != nullptr) {
+        freeCount[static_cast<int>(threadPhase)].fetch_add(1, std::memory_order_relaxed);
+        std::free(pointer);
+    }
+}
+
+} // namespace
+
+bool AllocationTracker::enabled() {
+    return true;
+}
+
+AllocationCounts AllocationTracker::phase(AllocationPhase phase) {
+    int index = static_cast<int>(phase);
+    AllocationCounts counts;
+    counts.allocations = allocationCount[index].load(std::memory_order_relaxed);
+    counts.frees = freeCount[index].load(std::memory_order_relaxed);
+    counts.bytes = byteCount[index].load(std::memory_order_relaxed);
+    return counts;
+}
+
+AllocationCounts AllocationTracker::total() {
+    AllocationCounts counts;
+    for (int i = 0; i < PHASES; i++) {
+        AllocationCounts part = phase(static_cast<AllocationPhase>(i));
+        counts.allocations += part.allocations;
+        counts.frees += part.frees;
+        counts.bytes += part.bytes;
+    }
+    return counts;
+}
+
+AllocationPhase AllocationTracker::currentPhase() {
+    return threadPhase;
+}
+
+void AllocationTracker::setPhase(AllocationPhase phase) {
+    threadPhase = phase;
+}
+
+// ============== GLOBAL OPERATOR REPLACEMENTS ==============
+void* operator new(std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer);
+}
+
+#else
+
+bool AllocationTracker::enabled() {
+    return false;
+}
+
+AllocationCounts AllocationTracker::phase(AllocationPhase) {
+    return AllocationCounts();
+}
+
+AllocationCounts AllocationTracker::total() {
+    return AllocationCounts();
+}
+
+#endif
@@ -0,0 +1,196 @@
+#include "BankrollSimulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+/*
+ * BANKROLLSIMULATOR IMPLEMENTATION
+ * --------------------------------
+ */
+
+namespace {
+
+// Totals of one lane group, merged in group order
+struct GroupTotals {
+    double wagered = 0.0;
+    double won = 0.0;
+    long long roundsPlayed = 0;
+    long long ruined = 0;
+    long long roundsToRuin = 0;
+};
+
+double percentile(const std::vector<float>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+} // namespace
+
+constexpr double BankrollSimulator::MIN_BET;
+
+BankrollSimulator::BankrollSimulator(const GameConfig& gameConfig, const PlayerPolicy& playerPolicy,
+                                     const BettingStrategy& bettingStrategy)
+    : config(gameConfig), policy(playerPolicy), betting(bettingStrategy), engine(gameConfig) {
+    // With independent cards a count-based bet would never change
+    if (betting.needsFiniteShoe() && !config.useCompositionDeck) {
+        throw std::invalid_argument(betting.describe() + " needs a finite shoe (GameConfig::useCompositionDeck)");
+    }
+}
+
+void BankrollSimulator::takeSnapshot(const LaneGroup& group, long long firstBankroll, int lanes, long long bankrolls,
+                                     size_t point, std::vector<float>& snapshots) const {
+    for (int lane = 0; lane < lanes; lane++) {
+        snapshots[point * static_cast<size_t>(bankrolls) + static_cast<size_t>(firstBankroll + lane)] =
+            static_cast<float>(group.bankroll[lane]);
+    }
+}
+
+void BankrollSimulator::playGroup(LaneGroup& group, long long firstBankroll, int lanes, const BankrollOptions& options,
+                                  const std::vector<long long>& snapshotRounds, std::vector<float>& snapshots) const {
+    for (int lane = 0; lane < lanes; lane++) {
+        group.rng[lane] = Rng::forStream(options.seed, static_cast<uint64_t>(firstBankroll + lane));
+        group.shoe[lane] = engine.freshShoe();
+        group.bankroll[lane] = options.startingUnits;
+        group.wagered[lane] = 0.0;
+        group.won[lane] = 0.0;
+        group.nextBet[lane] = betting.bet(group.shoe[lane], config.deckSize);
+        group.ruinedAt[lane] = group.bankroll[lane] < MIN_BET ? 0 : -1;
+    }
+
+    size_t point = 0;
+    for (long long r = 0; r < options.rounds; r++) {
+        // Lockstep: every lane in the group plays round r
+        int playing = 0;
+        for (int lane = 0; lane < lanes; lane++) {
+            if (group.ruinedAt[lane] >= 0) {
+                continue;
+            }
+            // A big bet the bankroll cannot cover is cut down to what is left
+            double stake = std::min(group.nextBet[lane], group.bankroll[lane]);
+            RoundRecord round = engine.playRound(group.shoe[lane], group.rng[lane], policy);
+            group.bankroll[lane] += stake * round.net;
+            group.wagered[lane] += stake;
+            group.won[lane] += stake * round.net;
+
+            // Ruined once not even the minimum bet can be covered
+            group.nextBet[lane] = betting.bet(group.shoe[lane], config.deckSize);
+            if (group.bankroll[lane] < MIN_BET) {
+                group.ruinedAt[lane] = r + 1;
+            } else {
+                playing++;
+            }
+        }
+        while (point < snapshotRounds.size() && snapshotRounds[point] == r + 1) {
+            takeSnapshot(group, firstBankroll, lanes, options.bankrolls, point++, snapshots);
+        }
+        if (playing == 0) {
+            break;  // Every lane is broke - the rest of the session is fixed
+        }
+    }
+    while (point < snapshotRounds.size()) {
+        takeSnapshot(group, firstBankroll, lanes, options.bankrolls, point++, snapshots);
+    }
+}
+
+BankrollResult BankrollSimulator::run(const BankrollOptions& options) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    BankrollResult result;
+
+    const long long bankrolls = std::max(1LL, options.bankrolls);
+    const long long groups = (bankrolls + LANE_WIDTH - 1) / LANE_WIDTH;
+    BankrollOptions run = options;
+    run.bankrolls = bankrolls;
+
+    // Evenly spaced snapshot rounds; the last one is the end of the session.
+    // No more points than rounds, so no snapshot lands on round 0 (or twice on one round).
+    const int points = static_cast<int>(std::max(1LL, std::min<long long>(options.trajectoryPoints, options.rounds)));
+    std::vector<long long> snapshotRounds;
+    for (int p = 1; p <= points; p++) {
+        snapshotRounds.push_back(options.rounds * p / points);
+    }
+    std::vector<float> snapshots(static_cast<size_t>(points) * static_cast<size_t>(bankrolls));
+    std::vector<long long> ruinedAt(static_cast<size_t>(bankrolls), -1);
+    std::vector<GroupTotals> totals(static_cast<size_t>(groups));
+    std::atomic<long long> claim(0);
+
+    auto worker = [&]() {
+        LaneGroup group;
+        for (long long g = claim.fetch_add(1); g < groups; g = claim.fetch_add(1)) {
+            long long first = g * LANE_WIDTH;
+            int lanes = static_cast<int>(std::min<long long>(LANE_WIDTH, bankrolls - first));
+            playGroup(group, first, lanes, run, snapshotRounds, snapshots);
+
+            GroupTotals& total = totals[static_cast<size_t>(g)];
+            for (int lane = 0; lane < lanes; lane++) {
+                total.wagered += group.wagered[lane];
+                total.won += group.won[lane];
+                ruinedAt[static_cast<size_t>(first + lane)] = group.ruinedAt[lane];
+                if (group.ruinedAt[lane] >= 0) {
+                    total.ruined++;
+                    total.roundsToRuin += group.ruinedAt[lane];
+                    total.roundsPlayed += group.ruinedAt[lane];
+                } else {
+                    total.roundsPlayed += options.rounds;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < options.threads; t++) {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    // Merge in group order - the same sums for any thread count
+    long long ruined = 0;
+    long long roundsToRuin = 0;
+    for (const GroupTotals& total : totals) {
+        result.wagered += total.wagered;
+        result.won += total.won;
+        result.roundsPlayed += total.roundsPlayed;
+        ruined += total.ruined;
+        roundsToRuin += total.roundsToRuin;
+    }
+    double n = static_cast<double>(bankrolls);
+    result.riskOfRuin = ruined / n;
+    result.riskOfRuinHalfWidth = 1.96 * std::sqrt(result.riskOfRuin * (1.0 - result.riskOfRuin) / n);
+    result.meanRoundsToRuin = ruined > 0 ? static_cast<double>(roundsToRuin) / ruined : 0.0;
+    result.meanBet = result.roundsPlayed > 0 ? result.wagered / result.roundsPlayed : 0.0;
+
+    std::vector<float> column(static_cast<size_t>(bankrolls));
+    for (int p = 0; p < points; p++) {
+        BankrollSnapshot snapshot;
+        snapshot.round = snapshotRounds[static_cast<size_t>(p)];
+        double sum = 0.0;
+        long long ruinedSoFar = 0;
+        for (long long b = 0; b < bankrolls; b++) {
+            column[static_cast<size_t>(b)] = snapshots[static_cast<size_t>(p) * static_cast<size_t>(bankrolls) +
+                                                       static_cast<size_t>(b)];
+            sum += column[static_cast<size_t>(b)];
+            long long at = ruinedAt[static_cast<size_t>(b)];
+            ruinedSoFar += (at >= 0 && at <= snapshot.round) ? 1 : 0;
+        }
+        std::sort(column.begin(), column.end());
+        snapshot.ruined = ruinedSoFar / n;
+        snapshot.mean = sum / n;
+        snapshot.p5 = percentile(column, 0.05);
+        snapshot.p25 = percentile(column, 0.25);
+        snapshot.median = percentile(column, 0.50);
+        snapshot.p75 = percentile(column, 0.75);
+        snapshot.p95 = percentile(column, 0.95);
+        result.trajectory.push_back(snapshot);
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,272 @@
+#include "BatchSimulator.h"
+#include "AllocationTracker.h"
+#include "Rng.h"
+#include "ShoePipeline.h"
+#include "Player.h"
+#include "Dealer.h"
+#include "Strategy.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+
+/*
+ * BATCHSIMULATOR IMPLEMENTATION
+ * -----------------------------
+ * Lockstep simulation of many independent rounds.
+ *
+ * ROUND PHASES (one card per step at most):
+ *   0, 1  = deal the player's two cards
+ *   2     = deal the dealer's card
+ *   3     = player turn (hit until playerStandThreshold)
+ *   4     = dealer turn (hit until the strategy threshold)
+ *   5     = round over - score it and refill the lane
+ *
+ * Every branch is written as "mask ? a : b" on plain integers so the
+ * compiler can turn each loop over a block into vector instructions.
+ */
+
+namespace {
+
+const int PHASE_PLAYER = 3;
+const int PHASE_DEALER = 4;
+const int PHASE_DONE = 5;
+
+// Same rule as Player::getScore - one Ace may count as 11 if it fits
+inline int32_t softScore(int32_t total, int32_t aces) {
+    return total + ((aces > 0 && total + 10 <= 21) ? 10 : 0);
+}
+
+// SplitMix64 step, written out so it inlines into the vector loop
+inline uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+BatchSimulator::BatchSimulator(const GameConfig& gameConfig, int lanes, uint64_t seed)
+    : config(gameConfig),
+      laneCount(lanes < 1 ? 1 : lanes) {
+    // Ask the real strategy for its rule so both engines always agree
+    dealerThreshold = createDealerStrategy(config.useAggressiveDealer)->getThreshold();
+
+    int blockCount = (laneCount + LANE_WIDTH - 1) / LANE_WIDTH;
+    blocks.resize(blockCount);
+
+    for (int b = 0; b < blockCount; b++) {
+        LaneBlock& block = blocks[b];
+        for (int i = 0; i < LANE_WIDTH; i++) {
+            block.rng[i] = Rng::forStream(seed, static_cast<uint64_t>(b) * LANE_WIDTH + i).state;
+            block.remaining[i] = config.deckSize;
+            block.phase[i] = 0;
+            block.playerTotal[i] = 0;
+            block.playerAces[i] = 0;
+            block.dealerTotal[i] = 0;
+            block.dealerAces[i] = 0;
+            block.quota[i] = 0;
+        }
+    }
+}
+
+int BatchSimulator::getLaneCount() const {
+    return laneCount;
+}
+
+BatchResult BatchSimulator::run(long long rounds) {
+    for (LaneBlock& block : blocks) {
+        for (int i = 0; i < LANE_WIDTH; i++) {
+            block.wins[i] = 0;
+            block.losses[i] = 0;
+            block.ties[i] = 0;
+            block.playerBusts[i] = 0;
+            block.dealerBusts[i] = 0;
+        }
+    }
+
+    /*
+     * Quotas stay 32-bit so the lane loop vectorises with the other int32
+     * fields; more than INT32_MAX rounds per lane are played in passes.
+     */
+    const long long maxPass = static_cast<long long>(laneCount) * std::numeric_limits<int32_t>::max();
+    for (long long left = std::max(0LL, rounds); left > 0;) {
+        long long pass = std::min(left, maxPass);
+        left -= pass;
+
+        // Share the rounds out as evenly as possible; padding lanes get none
+        for (int b = 0; b < static_cast<int>(blocks.size()); b++) {
+            LaneBlock& block = blocks[b];
+            for (int i = 0; i < LANE_WIDTH; i++) {
+                long long lane = static_cast<long long>(b) * LANE_WIDTH + i;
+                long long share = 0;
+                if (lane < laneCount) {
+                    share = pass / laneCount + (lane < pass % laneCount ? 1 : 0);
+                }
+                block.quota[i] = static_cast<int32_t>(share);
+            }
+        }
+
+        // Step every block until all lanes have used up their quota
+        for (LaneBlock& block : blocks) {
+            while (stepBlock(block) > 0) {
+            }
+        }
+    }
+
+    BatchResult result;
+    for (const LaneBlock& block : blocks) {
+        for (int i = 0; i < LANE_WIDTH; i++) {
+            result.playerWins += block.wins[i];
+            result.dealerWins += block.losses[i];
+            result.ties += block.ties[i];
+            result.playerBusts += block.playerBusts[i];
+            result.dealerBusts += block.dealerBusts[i];
+        }
+    }
+    result.rounds = result.playerWins + result.dealerWins + result.ties;
+    return result;
+}
+
+int BatchSimulator::stepBlock(LaneBlock& block) {
+    const int32_t playerThreshold = config.playerStandThreshold;
+    const int32_t deckSize = config.deckSize;
+    const int32_t reshuffleAt = config.reshuffleThreshold;
+    int active = 0;
+
+    /*
+     * Steps are run in small bursts between "are we finished?" checks,
+     * which keeps the inner loop free of any data-dependent exit.
+     */
+    for (int burst = 0; burst < 8; burst++) {
+        for (int i = 0; i < LANE_WIDTH; i++) {
+            const int32_t on = block.quota[i] > 0;
+            const int32_t phase = block.phase[i];
+            const int32_t playerScore = softScore(block.playerTotal[i], block.playerAces[i]);
+            const int32_t dealerScore = softScore(block.dealerTotal[i], block.dealerAces[i]);
+
+            // Draw one random rank 1-13 for every lane (wasted if unused)
+            const uint32_t bits = static_cast<uint32_t>(nextRandom(block.rng[i]) >> 32);
+            const int32_t rank = static_cast<int32_t>((static_cast<uint64_t>(bits) * 13) >> 32) + 1;
+            const int32_t value = rank > 10 ? 10 : rank;
+            const int32_t ace = rank == 1;
+
+            // Masks: who wants this card?
+            const int32_t wantsPlayer = on & ((phase < 2) | ((phase == PHASE_PLAYER) & (playerScore < playerThreshold) & (playerScore < 21)));
+            const int32_t wantsDealer = on & ((phase == 2) | ((phase == PHASE_DEALER) & (dealerScore < dealerThreshold)));
+            const int32_t hasCard = block.remaining[i] > 0;
+            const int32_t toPlayer = wantsPlayer & hasCard;
+            const int32_t toDealer = wantsDealer & hasCard;
+
+            block.playerTotal[i] += toPlayer ? value : 0;
+            block.playerAces[i] += toPlayer & ace;
+            block.dealerTotal[i] += toDealer ? value : 0;
+            block.dealerAces[i] += toDealer & ace;
+            block.remaining[i] -= toPlayer | toDealer;
+
+            // Phase transitions (a player bust skips the dealer turn)
+            int32_t next = phase;
+            next = (on & (phase < PHASE_PLAYER)) ? phase + 1 : next;
+            next = (on & (phase == PHASE_PLAYER) & !toPlayer) ? (playerScore > 21 ? PHASE_DONE : PHASE_DEALER) : next;
+            next = (on & (phase == PHASE_DEALER) & !toDealer) ? PHASE_DONE : next;
+
+            // Score finished rounds (uses the totals from before this step,
+            // which are final because nobody drew in the finishing step)
+            const int32_t done = on & (phase == PHASE_DONE);
+            const int32_t playerBust = playerScore > 21;
+            const int32_t dealerBust = (!playerBust) & (dealerScore > 21);
+            const int32_t win = dealerBust | ((!playerBust) & (!dealerBust) & (playerScore > dealerScore));
+            const int32_t loss = playerBust | ((!dealerBust) & (!playerBust) & (dealerScore > playerScore));
+            const int32_t tie = (!win) & (!loss);
+
+            block.wins[i] += done & win;
+            block.losses[i] += done & loss;
+            block.ties[i] += done & tie;
+            block.playerBusts[i] += done & playerBust;
+            block.dealerBusts[i] += done & dealerBust;
+            block.quota[i] -= done;
+
+            // Refill finished lanes with a fresh round (and shoe if needed)
+            block.playerTotal[i] = done ? 0 : block.playerTotal[i];
+            block.playerAces[i] = done ? 0 : block.playerAces[i];
+            block.dealerTotal[i] = done ? 0 : block.dealerTotal[i];
+            block.dealerAces[i] = done ? 0 : block.dealerAces[i];
+            block.remaining[i] = (done & (block.remaining[i] < reshuffleAt)) ? deckSize : block.remaining[i];
+            block.phase[i] = done ? 0 : next;
+        }
+    }
+
+    for (int i = 0; i < LANE_WIDTH; i++) {
+        active += block.quota[i] > 0;
+    }
+    return active;
+}
+
+BatchResult runScalarReference(const GameConfig& config, long long rounds, unsigned int seed) {
+    /*
+     * Mirrors Game::play round by round:
+     * dealInitialCards -> playerTurn -> dealerTurn -> determineWinner -> resetRound
+     * The "player" hits until config.playerStandThreshold.
+     */
+    // Decks are built ahead by the shared ShoeProducer, seeded from 'seed' in
+    // order, so the run is reproducible and a reshuffle costs no allocation
+    GameConfig deckConfig = config;
+    deckConfig.useCompositionDeck = false;
+    ShoePipeline shoes(deckConfig, seed);
+
+    BatchResult result;
+    std::unique_ptr<Shoe> deck = shoes.take();
+
+    for (long long r = 0; r < rounds; r++) {
+        // Phases as in Game (allocation tracking builds only); new Player/Dealer is resetRound's work
+        AllocationTracker::setPhase(AllocationPhase::Reset);
+        Player player;
+        Dealer dealer(createDealerStrategy(config.useAggressiveDealer));
+
+        AllocationTracker::setPhase(AllocationPhase::Deal);
+        player.addCard(deck->drawCard());
+        player.addCard(deck->drawCard());
+        dealer.addCard(deck->drawCard());
+
+        // Like playerTurn, 21 always ends the turn
+        AllocationTracker::setPhase(AllocationPhase::PlayerTurn);
+        while (player.getScore() < config.playerStandThreshold && player.getScore() < 21 && !deck->isEmpty()) {
+            player.addCard(deck->drawCard());
+        }
+
+        AllocationTracker::setPhase(AllocationPhase::DealerTurn);
+        int playerScore = player.getScore();
+        if (playerScore <= 21) {
+            while (dealer.shouldDraw() && !deck->isEmpty()) {
+                dealer.addCard(deck->drawCard());
+            }
+        }
+        int dealerScore = dealer.getScore();
+        AllocationTracker::setPhase(AllocationPhase::Settle);
+
+        if (playerScore > 21) {
+            result.dealerWins++;
+            result.playerBusts++;
+        } else if (dealerScore > 21) {
+            result.playerWins++;
+            result.dealerBusts++;
+        } else if (playerScore > dealerScore) {
+            result.playerWins++;
+        } else if (dealerScore > playerScore) {
+            result.dealerWins++;
+        } else {
+            result.ties++;
+        }
+        result.rounds++;
+
+        AllocationTracker::setPhase(AllocationPhase::Reset);
+        if (deck->getSize() < config.reshuffleThreshold) {
+            shoes.recycle(std::move(deck));
+            deck = shoes.take();
+        }
+    }
+    AllocationTracker::setPhase(AllocationPhase::Other);
+
+    return result;
+}
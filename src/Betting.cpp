@@ -0,0 +1,64 @@
+#include "Betting.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+/*
+ * BETTING IMPLEMENTATION
+ * ----------------------
+ */
+
+// ============== FLAT BETTING ==============
+FlatBetting::FlatBetting(double betUnits) : units(betUnits) {
+}
+
+double FlatBetting::bet(const ShoeState&, int) const {
+    return units;
+}
+
+std::string FlatBetting::describe() const {
+    std::ostringstream text;
+    text << "flat " << units << " unit(s)";
+    return text.str();
+}
+
+// ============== COUNT SPREAD BETTING ==============
+CountSpreadBetting::CountSpreadBetting(double maxBetUnits, double unitsPerCount)
+    : maxUnits(std::max(1.0, maxBetUnits)), ramp(unitsPerCount) {
+}
+
+double CountSpreadBetting::trueCount(const ShoeState& shoe, int fullShoe) {
+    // Hi-Lo tags by rank: Ace, 2..10, J, Q, K
+    static const int TAGS[ShoeState::RANKS] = {-1, 1, 1, 1, 1, 1, 0, 0, 0, -1, -1, -1, -1};
+    ShoeState full = ShoeState::standard(fullShoe);
+    int running = 0;
+    for (int rank = 1; rank <= ShoeState::RANKS; rank++) {
+        running += TAGS[rank - 1] * (full.getCount(rank) - shoe.getCount(rank));
+    }
+    double decksLeft = std::max(0.5, shoe.getSize() / 52.0);  // Never divide by (almost) nothing
+    return running / decksLeft;
+}
+
+double CountSpreadBetting::bet(const ShoeState& shoe, int fullShoe) const {
+    double count = trueCount(shoe, fullShoe);
+    if (count < 1.0) {
+        return 1.0;
+    }
+    return std::min(maxUnits, 1.0 + (count - 1.0) * ramp);
+}
+
+std::string CountSpreadBetting::describe() const {
+    std::ostringstream text;
+    text << "Hi-Lo spread 1-" << maxUnits << " units (" << ramp << " per true count)";
+    return text.str();
+}
+
+std::unique_ptr<BettingStrategy> createBettingStrategy(const std::string& name, double maxUnits, double ramp) {
+    if (name == "spread") {
+        return std::unique_ptr<BettingStrategy>(new CountSpreadBetting(maxUnits, ramp));
+    }
+    if (name == "flat") {
+        return std::unique_ptr<BettingStrategy>(new FlatBetting(1.0));
+    }
+    throw std::invalid_argument("Unknown betting strategy: " + name + " (use flat or spread)");
+}
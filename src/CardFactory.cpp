@@ -1,6 +1,11 @@
 #include "CardFactory.h"
+#include "GameException.h"
 #include <cstdlib>
 
+namespace {
+const string CODE_SUITS[] = {"Hearts", "Diamonds", "Clubs", "Spades"};
+}
+
 /*
  * CARDFACTORY IMPLEMENTATION
  * --------------------------
@@ -43,3 +48,43 @@ Card* CardFactory::createCard(int number, const string& suit) {
         return new FaceCard("King of " + suit);
     }
 }
+
+int CardFactory::rankOf(const Card& card) {
+    if (dynamic_cast<const AceCard*>(&card) != nullptr) {
+        return 1;
+    }
+    if (dynamic_cast<const FaceCard*>(&card) != nullptr) {
+        // Same numbering as createCard: 11 = Jack, 12 = Queen, 13 = King
+        string name = card.getName();
+        if (name.compare(0, 4, "Jack") == 0) {
+            return 11;
+        }
+        return name.compare(0, 5, "Queen") == 0 ? 12 : 13;
+    }
+    return card.getValue();
+}
+
+int CardFactory::codeOf(const Card& card) {
+    int rank = rankOf(card);
+    int suit = 0;
+    if (rank != 1) {
+        // The suit is the end of the name: "... of Clubs"
+        const string name = card.getName();
+        for (int s = 0; s < 4; s++) {
+            const string ending = " of " + CODE_SUITS[s];
+            if (name.size() >= ending.size() &&
+                name.compare(name.size() - ending.size(), ending.size(), ending) == 0) {
+                suit = s;
+                break;
+            }
+        }
+    }
+    return suit * 13 + rank - 1;
+}
+
+Card* CardFactory::createFromCode(int code) {
+    if (code < 0 || code >= CODES) {
+        throw TableFormatException("Bad card code in session data: " + to_string(code));
+    }
+    return createCard(code % 13 + 1, CODE_SUITS[code / 13]);
+}
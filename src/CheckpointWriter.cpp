@@ -0,0 +1,133 @@
+#include "CheckpointWriter.h"
+#include <cstdio>
+
+#if defined(_WIN32)
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+ * CHECKPOINTWRITER IMPLEMENTATION
+ * -------------------------------
+ */
+
+CheckpointWriter::CheckpointWriter(const std::string& checkpointPath)
+    : path(checkpointPath), hasPending(false), busy(false), stopping(false), writes(0), dropped(0), failures(0) {
+    writer = std::thread(&CheckpointWriter::writerLoop, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    flush();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    changed.notify_all();
+    writer.join();
+}
+
+void CheckpointWriter::submit(std::string contents) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (hasPending) {
+            dropped++;  // Never written - a newer state replaces it
+        }
+        pending.swap(contents);
+        hasPending = true;
+    }
+    changed.notify_all();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> guard(lock);
+    changed.wait(guard, [this]() { return !hasPending && !busy; });
+}
+
+int CheckpointWriter::getWrites() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return writes;
+}
+
+int CheckpointWriter::getDropped() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return dropped;
+}
+
+int CheckpointWriter::getFailures() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return failures;
+}
+
+void CheckpointWriter::writerLoop() {
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        changed.wait(guard, [this]() { return hasPending || stopping; });
+        if (!hasPending) {
+            return;  // Stopping and nothing left to write
+        }
+        writing.swap(pending);
+        hasPending = false;
+        busy = true;
+
+        // The slow part runs unlocked, so submit() can queue the next one
+        guard.unlock();
+        bool ok = writeAtomically(path, writing);
+        guard.lock();
+
+        busy = false;
+        if (ok) {
+            writes++;
+        } else {
+            failures++;
+        }
+        changed.notify_all();
+    }
+}
+
+bool CheckpointWriter::writeAtomically(const std::string& path, const std::string& contents) {
+    std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    // The data must be on disk BEFORE the rename, or a crash could leave
+    // an empty file under the final name
+    bool written = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size() &&
+                   std::fflush(file) == 0;
+#if defined(_WIN32)
+    written = written && _commit(_fileno(file)) == 0;
+#else
+    written = written && fsync(fileno(file)) == 0;
+#endif
+    written = std::fclose(file) == 0 && written;
+    if (!written) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    // Replacing the old file is one atomic step; if it fails the old
+    // checkpoint is still there, untouched
+#if defined(_WIN32)
+    if (!MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+#else
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    // Make the rename itself durable: sync the directory entry
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+#endif
+    return true;
+}
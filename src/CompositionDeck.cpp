@@ -0,0 +1,78 @@
+#include "CompositionDeck.h"
+#include "CardFactory.h"
+#include "GameException.h"  // For EmptyDeckException
+
+/*
+ * COMPOSITIONDECK IMPLEMENTATION
+ * ------------------------------
+ * Count-based shoe: a Card object is only created when it is drawn.
+ */
+
+namespace {
+const string COMPOSITION_SUITS[] = {"Hearts", "Diamonds", "Clubs", "Spades"};
+}
+
+CompositionDeck::CompositionDeck(int size, uint64_t seed)
+    : state(ShoeState::standard(size)), rng(seed), fullSize(size) {
+    // Nothing else to build - that's the point of this backend
+}
+
+Card* CompositionDeck::drawCard() {
+    if (state.isEmpty()) {
+        throw EmptyDeckException("Cannot draw - the deck has no cards left!");
+    }
+
+    // Card objects are only created when they leave the shoe
+    int rank = state.drawRank(rng);
+    const string& suit = COMPOSITION_SUITS[rng.below(4)];
+    return CardFactory::createCard(rank, suit);
+}
+
+void CompositionDeck::refill(uint64_t seed) {
+    state = ShoeState::standard(fullSize);
+    rng = Rng(seed);
+}
+
+void CompositionDeck::saveState(ByteWriter& out) const {
+    for (int rank = 1; rank <= ShoeState::RANKS; rank++) {
+        out.putSigned(state.getCount(rank));
+    }
+    out.putFixed64(rng.state);  // Same cards in the same order after loading
+}
+
+void CompositionDeck::loadState(ByteReader& in) {
+    ShoeState saved = ShoeState();
+    for (int rank = 1; rank <= ShoeState::RANKS; rank++) {
+        saved.counts[rank - 1] = static_cast<uint32_t>(in.getInt(0, fullSize));
+        saved.remaining += saved.counts[rank - 1];
+    }
+    if (saved.getSize() > fullSize) {
+        throw TableFormatException("Session shoe holds more cards than a new one");
+    }
+    state = saved;
+    rng.state = in.getFixed64();
+}
+
+int CompositionDeck::getSize() const {
+    return state.getSize();
+}
+
+bool CompositionDeck::isEmpty() const {
+    return state.isEmpty();
+}
+
+const ShoeState& CompositionDeck::getState() const {
+    return state;
+}
+
+CompositionDeck::Snapshot CompositionDeck::snapshot() const {
+    Snapshot saved;
+    saved.state = state;
+    saved.rng = rng;
+    return saved;
+}
+
+void CompositionDeck::restore(const Snapshot& saved) {
+    state = saved.state;
+    rng = saved.rng;
+}
@@ -19,7 +19,7 @@ Dealer::Dealer(std::unique_ptr<DrawStrategy> s)
      */
 }
 
-bool Dealer::shouldDraw() {
+bool Dealer::shouldDraw(int runningCount) {
     /*
      * STRATEGY PATTERN IN ACTION:
      * - Dealer doesn't know which strategy is being used
@@ -28,5 +28,5 @@ bool Dealer::shouldDraw() {
      *
      * This allows changing dealer behavior without modifying this code.
      */
-    return strategy->shouldDraw(getScore());
+    return strategy->shouldDrawHand(getScore(), isSoft(), runningCount);
 }
@@ -0,0 +1,114 @@
+#include "DecisionTable.h"
+#include "GameException.h"
+#include <fstream>
+#include <istream>
+#include <ostream>
+
+/*
+ * DECISIONTABLE IMPLEMENTATION
+ * ----------------------------
+ */
+
+const char* const DecisionTable::HEADER = "blackjack-decision-table";
+
+namespace {
+const int FIRST_HARD = 4;   // Lowest hard total with two cards (2 + 2)
+const int FIRST_SOFT = 12;  // Lowest soft total (Ace + Ace)
+}
+
+DecisionTable::DecisionTable() {
+    // Default: the player version of a dealer strategy, stand from 17
+    for (int soft = 0; soft < 2; soft++) {
+        for (int total = 0; total <= MAX_TOTAL; total++) {
+            for (int up = 0; up <= UPCARDS; up++) {
+                hit[soft][total][up] = total < 17 ? 1 : 0;
+            }
+        }
+    }
+}
+
+uint64_t DecisionTable::identity() const {
+    return hashBytes(hashName("table"), hit, sizeof(hit));
+}
+
+PlayerAction DecisionTable::decide(const HandState& hand, int dealerUpcard, const ShoeState&) const {
+    int score = hand.getScore();
+    if (score >= MAX_TOTAL) {
+        return PlayerAction::Stand;
+    }
+    int up = dealerUpcard < 1 ? UPCARDS : column(dealerUpcard);
+    return get(hand.isSoft(), score, up);
+}
+
+PlayerAction DecisionTable::get(bool soft, int total, int upcard) const {
+    if (total < 0 || total > MAX_TOTAL || upcard < 1 || upcard > UPCARDS) {
+        return PlayerAction::Stand;
+    }
+    return hit[soft ? 1 : 0][total][upcard] ? PlayerAction::Hit : PlayerAction::Stand;
+}
+
+void DecisionTable::set(bool soft, int total, int upcard, PlayerAction action) {
+    if (total < 0 || total > MAX_TOTAL || upcard < 1 || upcard > UPCARDS) {
+        return;
+    }
+    hit[soft ? 1 : 0][total][upcard] = action == PlayerAction::Hit ? 1 : 0;
+}
+
+void DecisionTable::save(std::ostream& out) const {
+    out << HEADER << " " << VERSION << "\n";
+    for (int soft = 0; soft < 2; soft++) {
+        for (int total = soft ? FIRST_SOFT : FIRST_HARD; total <= MAX_TOTAL; total++) {
+            out << (soft ? "soft " : "hard ") << total << " ";
+            for (int up = 1; up <= UPCARDS; up++) {
+                out << (hit[soft][total][up] ? 'H' : 'S');
+            }
+            out << "\n";
+        }
+    }
+}
+
+void DecisionTable::saveFile(const std::string& path) const {
+    std::ofstream file(path.c_str());
+    if (!file) {
+        throw TableFormatException("Cannot write decision table: " + path);
+    }
+    save(file);
+}
+
+DecisionTable DecisionTable::load(std::istream& in) {
+    std::string header;
+    int version = 0;
+    if (!(in >> header >> version) || header != HEADER) {
+        throw TableFormatException("Not a decision table (missing header)");
+    }
+    if (version != VERSION) {
+        throw TableFormatException("Unsupported decision table version " + std::to_string(version));
+    }
+
+    DecisionTable table;
+    std::string kind;
+    int total = 0;
+    std::string row;
+    while (in >> kind >> total >> row) {
+        if ((kind != "hard" && kind != "soft") || total < 0 || total > MAX_TOTAL ||
+            row.size() != static_cast<size_t>(UPCARDS)) {
+            throw TableFormatException("Bad decision table row: " + kind + " " + std::to_string(total) + " " + row);
+        }
+        for (int up = 1; up <= UPCARDS; up++) {
+            char c = row[static_cast<size_t>(up - 1)];
+            if (c != 'H' && c != 'S') {
+                throw TableFormatException("Bad action '" + std::string(1, c) + "' in decision table");
+            }
+            table.set(kind == "soft", total, up, c == 'H' ? PlayerAction::Hit : PlayerAction::Stand);
+        }
+    }
+    return table;
+}
+
+DecisionTable DecisionTable::loadFile(const std::string& path) {
+    std::ifstream file(path.c_str());
+    if (!file) {
+        throw TableFormatException("Cannot open decision table: " + path);
+    }
+    return load(file);
+}
@@ -1,6 +1,6 @@
 #include "Deck.h"
 #include "GameException.h"  // For EmptyDeckException
-#include <cstdlib>
+#include <vector>
 
 /*
  * DECK CLASS IMPLEMENTATION
@@ -21,17 +21,64 @@
 // Array of card suits for realistic deck creation
 const string SUITS[] = {"Hearts", "Diamonds", "Clubs", "Spades"};
 
-Deck::Deck(int s) : capacity(s), currentIndex(0) {
+const string& Deck::suitName(int suit) {
+    return SUITS[suit];
+}
+
+Deck::Deck(int s, uint64_t seed) : capacity(s), currentIndex(0) {
     // Dynamically allocate array of Card pointers on the heap
     // This allows the deck size to be determined at runtime
     cards = new Card*[capacity];
 
+    fill(seed);
+}
+
+void Deck::fill(uint64_t seed) {
     // Use Factory Pattern to create each card
     // The factory returns polymorphic Card* pointers
+    Rng rng(seed);
     for (int i = 0; i < capacity; i++) {
-        int number = (rand() % 13) + 1;  // Random card value 1-13
-        string suit = SUITS[rand() % 4]; // Random suit
-        cards[i] = CardFactory::createCard(number, suit);
+        int type = randomCard(rng);  // Unbiased: all 52 card types equally likely
+        cards[i] = CardFactory::createCard(type % 13 + 1, SUITS[type / 13]);
+    }
+    currentIndex = 0;
+}
+
+void Deck::refill(uint64_t seed) {
+    // Cards still in the deck are ours to delete; drawn ones belong to players
+    for (int i = currentIndex; i < capacity; i++) {
+        delete cards[i];
+    }
+    fill(seed);
+}
+
+void Deck::saveState(ByteWriter& out) const {
+    // Only the cards still to come matter, in the order they will be drawn
+    out.putSigned(getSize());
+    for (int i = currentIndex; i < capacity; i++) {
+        out.putByte(static_cast<uint8_t>(CardFactory::codeOf(*cards[i])));
+    }
+}
+
+void Deck::loadState(ByteReader& in) {
+    // Read and check every code before touching the deck, so a bad file
+    // leaves it as it was
+    int left = in.getInt(0, capacity);
+    std::vector<int> codes(left);
+    for (int& code : codes) {
+        code = in.getByte();
+        if (code >= CARD_TYPES) {
+            throw TableFormatException("Bad card code in session data: " + to_string(code));
+        }
+    }
+
+    for (int i = currentIndex; i < capacity; i++) {
+        delete cards[i];
+    }
+    // The saved cards go at the end, as if the others had been drawn
+    currentIndex = capacity - left;
+    for (int i = 0; i < left; i++) {
+        cards[currentIndex + i] = CardFactory::createFromCode(codes[i]);
     }
 }
 
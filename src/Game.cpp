@@ -1,7 +1,14 @@
 #include "Game.h"
+#include "AllocationTracker.h"
 #include "GameException.h"  // For custom exceptions
+#include "CardFactory.h"     // Card codes for saved sessions
+#include "CompositionDeck.h"  // Its composition seeds the hint engine after loading
 #include <iostream>
+#include <iomanip>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
 using namespace std;
 
 /*
@@ -15,6 +22,41 @@ using namespace std;
  * This makes it easy to customise the game without changing this code.
  */
 
+/*
+ * SHARED TABLES AND ODDS
+ * ----------------------
+ * The strategy tables and match odds depend only on the rules, never on
+ * the game being played, so every Game in the process with the same rules
+ * uses one copy. They are built the first time a Game needs them (under
+ * the lock, so two tables starting together still build once) and kept
+ * until the process exits: a host paging tables in and out only pays for
+ * a map lookup.
+ */
+namespace {
+std::mutex sharedMutex;
+std::map<uint64_t, std::shared_ptr<const StrategyTables>> sharedTableCache;  // By StrategyTables::configHash
+std::map<std::pair<uint64_t, int>, std::shared_ptr<const MatchOdds>> sharedOddsCache;  // + target score
+
+std::shared_ptr<const StrategyTables> sharedTables(const GameConfig& config) {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    std::shared_ptr<const StrategyTables>& tables = sharedTableCache[StrategyTables::configHash(config)];
+    if (!tables) {
+        tables = StrategyTables::openOrBuild(config);  // Solved once, then just mapped
+    }
+    return tables;
+}
+
+std::shared_ptr<const MatchOdds> sharedOdds(const GameConfig& config, const StrategyTables& tables) {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    std::shared_ptr<const MatchOdds>& odds =
+        sharedOddsCache[std::make_pair(StrategyTables::configHash(config), config.targetScore)];
+    if (!odds) {
+        odds = std::make_shared<const MatchOdds>(config.targetScore, tables.roundOutcome());
+    }
+    return odds;
+}
+}
+
 // Default constructor - uses default config
 Game::Game() : Game(GameConfig()) {
     // This calls the other constructor with a default GameConfig
@@ -24,8 +66,15 @@ Game::Game() : Game(GameConfig()) {
 // Constructor with custom config
 Game::Game(const GameConfig& gameConfig)
     : config(gameConfig),                    // Store the config
-      playerPoints(0),
-      dealerPoints(0) {
+      tables(sharedTables(gameConfig)),      // Shared by every Game with these rules
+      matchOdds(sharedOdds(gameConfig, *tables)),
+      session(Metrics::global()),
+      shoes(gameConfig, ShoeFactory::seedFromRand()),  // Starts building shoes right away
+      dealerRules(gameConfig.dealerRulesFile.empty()
+                      ? nullptr
+                      : std::make_shared<const RuleTable>(RuleTable::loadFile(gameConfig.dealerRulesFile))) {
+    // Members are initialised in the order Game.h declares them; the
+    // points and round state start from their defaults there
     /*
      * SMART POINTER CREATION WITH make_unique:
      *
@@ -36,17 +85,29 @@ Game::Game(const GameConfig& gameConfig)
      * - Exception-safe (won't leak memory if an exception is thrown)
      */
 
-    // Create deck using config setting
-    deck = make_unique<Deck>(config.deckSize);
+    // Create deck using config setting (ShoeFactory picks the backend,
+    // the shared ShoeProducer builds it in the background)
+    deck = shoes.take();
     player = make_unique<Player>();
+    if (config.showHints) {
+        hints = make_unique<HintEngine>(config, *tables);
+    }
 
     // Create Dealer with strategy based on config
     // This shows how config makes the game SCALABLE and CUSTOMISABLE
+    dealer = newDealer();
+}
+
+std::unique_ptr<Dealer> Game::newDealer() const {
+    // A rule file wins over the built-in strategies; its table is shared,
+    // so a new Dealer costs no recompiling
+    if (dealerRules) {
+        return make_unique<Dealer>(make_unique<RuleStrategy>(dealerRules));
+    }
     if (config.useAggressiveDealer) {
-        dealer = make_unique<Dealer>(make_unique<AggressiveStrategy>());
-    } else {
-        dealer = make_unique<Dealer>(make_unique<ConservativeStrategy>());
+        return make_unique<Dealer>(make_unique<AggressiveStrategy>());
     }
+    return make_unique<Dealer>(make_unique<ConservativeStrategy>());
 }
 
 /*
@@ -83,46 +144,149 @@ void Game::startRound() {
 
 void Game::dealInitialCards() {
     // Deal two cards to player, one to dealer (standard Blackjack opening)
-    player->addCard(deck->drawCard());
-    player->addCard(deck->drawCard());
-    dealer->addCard(deck->drawCard());
+    player->addCard(drawCard());
+    player->addCard(drawCard());
+    dealer->addCard(drawCard());
 }
 
-void Game::playerTurn() {
+template <typename Rules>
+void Game::playRound() {
+    // Each step is an allocation phase (counted only in tracking builds) and a latency phase.
+    // The recorder is the one of the thread playing this round, not the one that built the Game
+    MetricsRecorder& metrics = Metrics::global().threadRecorder();
+    LatencyTimer roundTimer(metrics, MetricPhase::Round);
+    {
+        AllocationScope phase(AllocationPhase::Deal);
+        LatencyTimer timer(metrics, MetricPhase::Deal);
+        dealInitialCards();
+    }
+    stakes[0] = 1.0;
+    stakes[1] = 1.0;
+    surrendered = false;
+    splitAces = false;
+
+    {
+        AllocationScope phase(AllocationPhase::PlayerTurn);
+        playerTurn<Rules>(*player, 0);
+        if (splitHand) {
+            playerTurn<Rules>(*splitHand, 1);
+        }
+    }
+
+    // Only do dealer's turn if a hand is still in play
+    bool handInPlay = player->getScore() <= 21 || (splitHand && splitHand->getScore() <= 21);
+    if (handInPlay && !surrendered) {
+        AllocationScope phase(AllocationPhase::DealerTurn);
+        LatencyTimer timer(metrics, MetricPhase::DealerTurn);
+        dealerTurn<Rules>();
+    }
+
+    AllocationScope phase(AllocationPhase::Settle);
+    {
+        LatencyTimer timer(metrics, MetricPhase::Scoring);
+        determineWinner<Rules>();
+    }
+    metrics.countRound();
+}
+
+template <typename Rules>
+void Game::playerTurn(Player& hand, int handIndex) {
     char choice;
+    bool opening = (handIndex == 0);  // Split and surrender: first decision only
+
+    if (handIndex == 1) {
+        // The split hand gets its second card now
+        cout << "\n-------- SECOND HAND --------" << endl;
+        try {
+            Card* newCard = drawCard();
+            cout << "Second hand receives: " << newCard->getName() << endl;
+            hand.addCard(newCard);
+        }
+        catch (const EmptyDeckException& e) {
+            cout << "Sorry! " << e.what() << endl;
+        }
+    }
 
     while (true) {
         cout << "\nYour ";
-        player->showHand();
+        hand.showHand();
 
         cout << "Dealer shows: ";
         dealer->showHand();
 
         // Check for bust
-        if (player->getScore() > 21) {
+        if (hand.getScore() > 21) {
             cout << "\n*** BUST! You went over 21! ***" << endl;
             return;
         }
 
         // Check for Blackjack (21 with 2 cards)
-        if (player->getScore() == 21) {
+        if (hand.getScore() == 21) {
             cout << "\n*** BLACKJACK! ***" << endl;
             return;
         }
 
-        cout << "\n[H]it or [S]tand? ";
-        cin >> choice;
+        if (Rules::split && splitAces) {
+            cout << "Split Aces receive one card each." << endl;
+            return;
+        }
+
+        // Only offer the moves this rule set allows (constants at compile time)
+        bool canDouble = Rules::doubleDown && hand.getCardCount() == 2;
+        bool canSplit = Rules::split && opening && !splitHand && hand.isPair();
+        bool canSurrender = Rules::surrender && opening && !splitHand;
+
+        if (hints) {
+            showHint(hand);
+        }
+
+        cout << "\n[H]it";
+        if (canDouble) cout << ", [D]ouble";
+        if (canSplit) cout << ", s[P]lit";
+        if (canSurrender) cout << ", s[U]rrender";
+        cout << " or [S]tand? ";
+        if (!(*input >> choice)) {
+            choice = 's';  // Out of answers (end of input or script): stand
+        }
+        opening = false;
+        LatencyTimer decision(Metrics::global().threadRecorder(), MetricPhase::PlayerAction);  // From the answer to the result
+
+        if (canSurrender && (choice == 'u' || choice == 'U')) {
+            surrendered = true;
+            cout << "You surrender. Half a point goes to the dealer." << endl;
+            return;
+        }
 
-        if (choice == 'h' || choice == 'H') {
+        if (canSplit && (choice == 'p' || choice == 'P')) {
+            // Move the second card into a new hand, then top up this one
+            Card* second = hand.removeLastCard();
+            splitAces = dynamic_cast<AceCard*>(second) != nullptr;
+            splitHand = make_unique<Player>();
+            splitHand->addCard(second);
+            cout << "You split your pair into two hands." << endl;
+            try {
+                Card* newCard = drawCard();
+                cout << "First hand receives: " << newCard->getName() << endl;
+                hand.addCard(newCard);
+            }
+            catch (const EmptyDeckException& e) {
+                cout << "Sorry! " << e.what() << endl;
+                break;
+            }
+            continue;
+        }
+
+        bool doubling = canDouble && (choice == 'd' || choice == 'D');
+        if (choice == 'h' || choice == 'H' || doubling) {
             /*
              * EXCEPTION HANDLING WITH TRY-CATCH:
              * We wrap the drawCard() call in a try block because it might throw
              * an EmptyDeckException. If it does, we catch it and handle it nicely.
              */
             try {
-                Card* newCard = deck->drawCard();  // This might throw an exception
+                Card* newCard = drawCard();  // This might throw an exception
                 cout << "You drew: " << newCard->getName() << endl;
-                player->addCard(newCard);
+                hand.addCard(newCard);
             }
             catch (const EmptyDeckException& e) {
                 // Catch the exception and display a friendly message
@@ -130,24 +294,39 @@ void Game::playerTurn() {
                 cout << "You must stand." << endl;
                 break;
             }
+
+            if (doubling) {
+                // Double down: twice the points, exactly one card
+                stakes[handIndex] *= 2.0;
+                cout << "You doubled down - this hand is worth " << stakes[handIndex] << " points." << endl;
+                cout << "Your ";
+                hand.showHand();
+                if (hand.getScore() > 21) {
+                    cout << "\n*** BUST! You went over 21! ***" << endl;
+                }
+                return;
+            }
         } else {
-            cout << "You stand with " << player->getScore() << "." << endl;
+            cout << "You stand with " << hand.getScore() << "." << endl;
             break;
         }
     }
 }
 
+template <typename Rules>
 void Game::dealerTurn() {
     cout << "\n-------- DEALER'S TURN --------" << endl;
 
-    while (dealer->shouldDraw() && !deck->isEmpty()) {
+    // With hitSoft17 the dealer also draws on soft 17 or less
+    while ((dealer->shouldDraw(runningCount) || (Rules::hitSoft17 && dealer->isSoft() && dealer->getScore() <= 17))
+           && !deck->isEmpty()) {
         /*
          * TRY-CATCH FOR DEALER'S DRAW:
          * Same exception handling as player's turn.
          * If deck is empty, dealer must stop drawing.
          */
         try {
-            Card* newCard = deck->drawCard();
+            Card* newCard = drawCard();
             cout << "Dealer draws: " << newCard->getName() << endl;
             dealer->addCard(newCard);
             dealer->showHand();
@@ -165,48 +344,78 @@ void Game::dealerTurn() {
     }
 }
 
+template <typename Rules>
 void Game::determineWinner() {
-    int playerScore = player->getScore();
     int dealerScore = dealer->getScore();
+    bool dealerNatural = dealer->getCardCount() == 2 && dealerScore == 21;
+    int handCount = splitHand ? 2 : 1;
 
     cout << "\n======== RESULTS ========" << endl;
-    cout << "Your Score:   " << playerScore << endl;
+    for (int h = 0; h < handCount; h++) {
+        Player& hand = (h == 0) ? *player : *splitHand;
+        if (handCount > 1) {
+            cout << "Hand " << (h + 1) << " Score: " << hand.getScore() << endl;
+        } else {
+            cout << "Your Score:   " << hand.getScore() << endl;
+        }
+    }
     cout << "Dealer Score: " << dealerScore << endl;
     cout << "=========================" << endl;
 
-    if (playerScore > 21) {
-        cout << "You busted. Dealer wins this round." << endl;
-    }
-    else if (dealerScore > 21) {
-        cout << "Dealer busted. You win this round." << endl;
-    }
-    else if (playerScore > dealerScore) {
-        cout << "You win this round." << endl;
-    }
-    else if (playerScore == dealerScore) {
-        cout << "It's a tie. No points awarded." << endl;
-    }
-    else {
-        cout << "Dealer wins this round." << endl;
-    }
+    for (int h = 0; h < handCount; h++) {
+        Player& hand = (h == 0) ? *player : *splitHand;
+        int playerScore = hand.getScore();
+        bool natural = !splitHand && hand.getCardCount() == 2 && playerScore == 21;
 
-    // Points update logic
-    if (playerScore > 21) {
-        dealerPoints++;
-    }
-    else if (dealerScore > 21) {
-        playerPoints++;
-    }
-    else if (playerScore > dealerScore) {
-        playerPoints++;
-    }
-    else if (dealerScore > playerScore) {
-        dealerPoints++;
+        if (handCount > 1) {
+            cout << "Hand " << (h + 1) << ": ";
+        }
+
+        if (Rules::surrender && surrendered) {
+            cout << "You surrendered. Dealer takes half a point." << endl;
+        }
+        else if (playerScore > 21) {
+            cout << "You busted. Dealer wins this round." << endl;
+        }
+        else if (Rules::payNaturals && natural && !dealerNatural) {
+            cout << "Natural Blackjack! You win " << Rules::naturalPayout() * stakes[h] << " points." << endl;
+        }
+        else if (Rules::payNaturals && dealerNatural && !natural) {
+            cout << "Dealer has a natural Blackjack. Dealer wins this round." << endl;
+        }
+        else if (dealerScore > 21) {
+            cout << "Dealer busted. You win this round." << endl;
+        }
+        else if (playerScore > dealerScore) {
+            cout << "You win this round." << endl;
+        }
+        else if (playerScore == dealerScore) {
+            cout << "It's a tie. No points awarded." << endl;
+        }
+        else {
+            cout << "Dealer wins this round." << endl;
+        }
+
+        // Points update logic (shared with the simulator - see Rules.h)
+        double won = settleHand<Rules>(playerScore, natural, dealerScore, dealerNatural, stakes[h], surrendered);
+        if (won > 0) {
+            playerPoints += won;
+        }
+        else if (won < 0) {
+            dealerPoints -= won;
+        }
+        // tie: no points
     }
-    // tie: no points
 
     cout << "Score -> You: " << playerPoints
          << " | Dealer: " << dealerPoints << endl;
+
+    // Match odds assume whole points, so only the Classic rules show them
+    bool gameOver = playerPoints >= config.targetScore || dealerPoints >= config.targetScore;
+    if (config.showDetailedScores && config.ruleVariant == RuleVariant::Classic && !gameOver) {
+        double chance = matchOdds->winProbability(static_cast<int>(playerPoints), static_cast<int>(dealerPoints));
+        cout << "Chance to win the game with best play: about " << static_cast<int>(chance * 100.0 + 0.5) << "%" << endl;
+    }
 }
 
 void Game::resetRound() {
@@ -220,21 +429,214 @@ void Game::resetRound() {
      *
      * This is much cleaner than manual delete + new!
      */
+    AllocationScope phase(AllocationPhase::Reset);
 
     // Reset player for new round
     player.reset(new Player());
+    splitHand.reset();  // No split hand until the player splits again
 
     // Reset dealer using config setting (SCALABILITY)
-    if (config.useAggressiveDealer) {
-        dealer.reset(new Dealer(make_unique<AggressiveStrategy>()));
-    } else {
-        dealer.reset(new Dealer(make_unique<ConservativeStrategy>()));
-    }
+    dealer = newDealer();
 
-    // Recreate deck if below threshold (using config)
+    // Swap in a ready shoe if below threshold (using config); the old one
+    // goes back to the pipeline to be refilled off this thread
     if (deck->getSize() < config.reshuffleThreshold) {
-        deck.reset(new Deck(config.deckSize));
+        shoes.recycle(std::move(deck));
+        deck = shoes.take();
+        runningCount = 0;
+        Metrics::global().threadRecorder().countReshuffle();
+        if (hints) {
+            hints->newShoe();
+        }
+    }
+}
+
+Card* Game::drawCard() {
+    Card* card = deck->drawCard();  // May throw EmptyDeckException
+    runningCount += RuleTable::hiLoTag(card->getValue());
+    if (hints) {
+        hints->cardDrawn(*card);    // Keep the hint engine's shoe in step
+    }
+    return card;
+}
+
+void Game::showHint(Player& hand) {
+    Hint hint = hints->hint(hand, *dealer);
+    cout << fixed << setprecision(3)
+         << "Hint: Stand " << hint.values.stand.value() << " | Hit " << hint.values.hit.value()
+         << " points expected -> " << (hint.values.best() == PlayerAction::Hit ? "Hit" : "Stand")
+         << (hint.exact ? "" : " (from table)") << endl;
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+/*
+ * SAVED SESSIONS
+ * --------------
+ * Layout (integers are zigzag varints, see ByteCodec.h):
+ *   "BJS" + version byte
+ *   config    - numbers, a flags byte, then the three strings
+ *   score     - playerPoints, dealerPoints, stakes[2] (8-byte doubles),
+ *               a flags byte (surrendered, split Aces, split hand), runningCount
+ *   hands     - player, split hand (only when there is one), dealer:
+ *               a card count, then one card code per byte
+ *   shoe      - the backend's own state (Shoe::saveState)
+ * A Normal-mode game with a full Deck of 52 comes to about 170 bytes, with
+ * a CompositionDeck (counts instead of cards) to about 130.
+ */
+
+namespace {
+const char SESSION_MAGIC[] = "BJS";
+const uint8_t SESSION_VERSION = 1;
+const int MAX_HAND_CARDS = 64;
+
+enum SessionFlags : uint8_t {
+    CompositionShoe = 1, AggressiveDealer = 2, DetailedScores = 4, Hints = 8,  // Config
+    Surrendered = 1, SplitAces = 2, HasSplitHand = 4                           // Round
+};
+}
+
+void Game::saveHand(ByteWriter& out, const Player& hand) {
+    out.putSigned(hand.getCardCount());
+    for (int i = 0; i < hand.getCardCount(); i++) {
+        out.putByte(static_cast<uint8_t>(CardFactory::codeOf(hand.getCard(i))));
+    }
+}
+
+void Game::loadHand(ByteReader& in, Player& hand) {
+    int count = in.getInt(0, MAX_HAND_CARDS);
+    for (int i = 0; i < count; i++) {
+        hand.addCard(CardFactory::createFromCode(in.getByte()));
+    }
+}
+
+void Game::saveSession(std::string& out) const {
+    ByteWriter writer(out);
+    for (int i = 0; i < 3; i++) {
+        writer.putByte(static_cast<uint8_t>(SESSION_MAGIC[i]));
     }
+    writer.putByte(SESSION_VERSION);
+
+    writer.putSigned(config.deckSize);
+    writer.putSigned(config.reshuffleThreshold);
+    writer.putSigned(config.targetScore);
+    writer.putSigned(static_cast<int>(config.ruleVariant));
+    writer.putSigned(config.playerStandThreshold);
+    writer.putDouble(config.targetEdgeCIWidth);
+    writer.putSigned(config.maxSimulationRounds);
+    writer.putSigned(config.hintBudgetMicros);
+    writer.putByte((config.useCompositionDeck ? CompositionShoe : 0) |
+                   (config.useAggressiveDealer ? AggressiveDealer : 0) |
+                   (config.showDetailedScores ? DetailedScores : 0) |
+                   (config.showHints ? Hints : 0));
+    writer.putString(config.dealerRulesFile);
+    writer.putString(config.tableDirectory);
+    writer.putString(config.welcomeMessage);
+
+    writer.putDouble(playerPoints);
+    writer.putDouble(dealerPoints);
+    writer.putDouble(stakes[0]);
+    writer.putDouble(stakes[1]);
+    writer.putByte((surrendered ? Surrendered : 0) | (splitAces ? SplitAces : 0) |
+                   (splitHand ? HasSplitHand : 0));
+    writer.putSigned(runningCount);
+
+    saveHand(writer, *player);
+    if (splitHand) {
+        saveHand(writer, *splitHand);
+    }
+    saveHand(writer, *dealer);
+    deck->saveState(writer);
+}
+
+std::unique_ptr<Game> Game::loadSession(const std::string& data) {
+    ByteReader reader(data);
+    for (int i = 0; i < 3; i++) {
+        if (reader.getByte() != static_cast<uint8_t>(SESSION_MAGIC[i])) {
+            throw TableFormatException("Not a saved session");
+        }
+    }
+    if (reader.getByte() != SESSION_VERSION) {
+        throw TableFormatException("Saved session is from another version");
+    }
+
+    GameConfig saved;
+    saved.deckSize = reader.getInt(1, numeric_limits<int>::max());
+    saved.reshuffleThreshold = reader.getInt(0, numeric_limits<int>::max());
+    saved.targetScore = reader.getInt(1, numeric_limits<int>::max());
+    saved.ruleVariant = static_cast<RuleVariant>(reader.getInt(0, static_cast<int>(RuleVariant::Vegas)));
+    saved.playerStandThreshold = reader.getInt(0, numeric_limits<int>::max());
+    saved.targetEdgeCIWidth = reader.getDouble();
+    saved.maxSimulationRounds = reader.getSigned();
+    saved.hintBudgetMicros = reader.getInt(0, numeric_limits<int>::max());
+    uint8_t options = reader.getByte();
+    saved.useCompositionDeck = (options & CompositionShoe) != 0;
+    saved.useAggressiveDealer = (options & AggressiveDealer) != 0;
+    saved.showDetailedScores = (options & DetailedScores) != 0;
+    saved.showHints = (options & Hints) != 0;
+    saved.dealerRulesFile = reader.getString();
+    saved.tableDirectory = reader.getString();
+    saved.welcomeMessage = reader.getString();
+
+    // Tables, odds, rule file and pipeline all come from the config
+    std::unique_ptr<Game> game = make_unique<Game>(saved);
+    game->playerPoints = reader.getDouble();
+    game->dealerPoints = reader.getDouble();
+    game->stakes[0] = reader.getDouble();
+    game->stakes[1] = reader.getDouble();
+    uint8_t round = reader.getByte();
+    game->surrendered = (round & Surrendered) != 0;
+    game->splitAces = (round & SplitAces) != 0;
+    game->runningCount = reader.getInt(numeric_limits<int>::min(), numeric_limits<int>::max());
+
+    loadHand(reader, *game->player);
+    if (round & HasSplitHand) {
+        game->splitHand = make_unique<Player>();
+        loadHand(reader, *game->splitHand);
+    }
+    loadHand(reader, *game->dealer);
+    game->deck->loadState(reader);
+    if (!reader.atEnd()) {
+        throw TableFormatException("Saved session has trailing data");
+    }
+
+    // A finite shoe's hints depend on what is left in it
+    const CompositionDeck* composition = dynamic_cast<const CompositionDeck*>(game->deck.get());
+    if (game->hints && composition != nullptr) {
+        game->hints->resumeShoe(composition->getState());
+    }
+    return game;
+}
+
+void Game::playRuleRound() {
+    // Pick the pre-built rule set once per round
+    switch (config.ruleVariant) {
+    case RuleVariant::Standard:
+        playRound<StandardRules>();
+        break;
+    case RuleVariant::Vegas:
+        playRound<VegasRules>();
+        break;
+    case RuleVariant::Classic:
+    default:
+        playRound<ClassicRules>();
+        break;
+    }
+}
+
+void Game::playScriptedRound(std::istream& answers) {
+    if (player->getCardCount() > 0) {
+        resetRound();  // The previous round's cards are still on the table
+    }
+    input = &answers;
+    try {
+        playRuleRound();
+    }
+    catch (...) {
+        input = &cin;
+        throw;
+    }
+    input = &cin;
 }
 
 void Game::play() {
@@ -251,15 +653,7 @@ void Game::play() {
         }
 
         startRound();
-        dealInitialCards();
-        playerTurn();
-
-        // Only do dealer's turn if player didn't bust
-        if (player->getScore() <= 21) {
-            dealerTurn();
-        }
-
-        determineWinner();
+        playRuleRound();
 
         if (playerPoints < config.targetScore && dealerPoints < config.targetScore) {
             cout << "\nPlay the next round? (y/n): ";
@@ -0,0 +1,185 @@
+#include "HandHistory.h"
+#include "GameException.h"
+#include <cmath>
+#include <cstring>
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/*
+ * HANDHISTORY IMPLEMENTATION
+ * --------------------------
+ */
+
+namespace {
+
+const char LOG_MAGIC[8] = {'B', 'J', 'H', 'A', 'N', 'D', 'S', '1'};
+
+uint8_t clampByte(int value) {
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+void writeHeader(std::ofstream& file) {
+    char header[HandLog::HEADER_BYTES];
+    std::memset(header, 0, sizeof(header));
+    std::memcpy(header, LOG_MAGIC, sizeof(LOG_MAGIC));
+    uint32_t version = HandLog::VERSION;
+    uint32_t recordSize = sizeof(HandRecord);
+    std::memcpy(header + 8, &version, sizeof(version));
+    std::memcpy(header + 12, &recordSize, sizeof(recordSize));
+    file.write(header, sizeof(header));
+}
+
+// Cuts a file down to 'bytes' long
+bool truncateFile(const std::string& path, long long bytes) {
+#if defined(_WIN32)
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) {
+        return false;
+    }
+    bool done = _chsize_s(fd, bytes) == 0;
+    return _close(fd) == 0 && done;
+#else
+    return ::truncate(path.c_str(), static_cast<off_t>(bytes)) == 0;
+#endif
+}
+
+} // namespace
+
+HandRecord HandRecord::fromRound(const RoundRecord& round) {
+    HandRecord record;
+    record.openingTotal = clampByte(round.playerStart);
+    record.playerScore = clampByte(round.playerScore);
+    record.dealerScore = clampByte(round.dealerScore);
+    record.dealerUpcard = clampByte(round.dealerUpcard);
+    record.playerCards = clampByte(round.playerCards);
+    record.dealerCards = clampByte(round.dealerCards);
+    record.flags = static_cast<uint8_t>((round.playerStartSoft ? OpeningSoft : 0) |
+                                        (round.playerBust ? PlayerBust : 0) |
+                                        (round.dealerBust ? DealerBust : 0) |
+                                        (round.playerSoft ? PlayerSoft : 0) |
+                                        (round.doubled ? Doubled : 0) |
+                                        (round.split ? Split : 0) |
+                                        (round.surrendered ? Surrendered : 0));
+    long halves = std::lround(round.net * 2.0);
+    record.netHalves = static_cast<int8_t>(halves < -128 ? -128 : (halves > 127 ? 127 : halves));
+    return record;
+}
+
+HandOutcome outcomeOf(const HandRecord& record) {
+    if (record.has(HandRecord::Surrendered)) {
+        return HandOutcome::Surrender;
+    }
+    if (record.has(HandRecord::PlayerBust)) {
+        return HandOutcome::PlayerBust;
+    }
+    if (record.has(HandRecord::DealerBust)) {
+        return HandOutcome::DealerBust;
+    }
+    if (record.netHalves > 0) {
+        return HandOutcome::Win;
+    }
+    return record.netHalves == 0 ? HandOutcome::Tie : HandOutcome::Loss;
+}
+
+const char* outcomeName(HandOutcome outcome) {
+    switch (outcome) {
+    case HandOutcome::PlayerBust:
+        return "player-bust";
+    case HandOutcome::DealerBust:
+        return "dealer-bust";
+    case HandOutcome::Win:
+        return "win";
+    case HandOutcome::Tie:
+        return "tie";
+    case HandOutcome::Loss:
+        return "loss";
+    case HandOutcome::Surrender:
+    case HandOutcome::COUNT:
+        break;
+    }
+    return "surrender";
+}
+
+// ============== HAND LOG ==============
+HandLog::HandLog(const std::string& logPath, long long keepRecords) : path(logPath) {
+    length = recordCount(logPath);  // Throws if the file exists but is not a hand log
+    if (keepRecords > length) {
+        throw TableFormatException("Hand history holds fewer rounds than the checkpoint: " + logPath);
+    }
+    if (keepRecords >= 0) {
+        length = keepRecords;
+    }
+    std::ifstream probe(logPath.c_str(), std::ios::binary | std::ios::ate);
+    long long size = probe ? static_cast<long long>(probe.tellg()) : 0;
+    bool fresh = size <= 0;
+    probe.close();
+
+    // Drop a record cut short by a crash (or records the checkpoint does not
+    // know about), or every later append would be out of step
+    long long complete = HEADER_BYTES + length * static_cast<long long>(sizeof(HandRecord));
+    if (!fresh && size > complete && !truncateFile(logPath, complete)) {
+        throw TableFormatException("Cannot trim hand history: " + logPath);
+    }
+
+    file.open(logPath.c_str(), std::ios::binary | std::ios::app);
+    if (!file) {
+        throw TableFormatException("Cannot write hand history: " + logPath);
+    }
+    if (fresh) {
+        writeHeader(file);
+    }
+}
+
+void HandLog::append(const std::vector<HandRecord>& records) {
+    if (records.empty()) {
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<std::streamsize>(records.size() * sizeof(HandRecord)));
+    if (!file) {
+        throw TableFormatException("Failed writing hand history: " + path);
+    }
+    length += static_cast<long long>(records.size());
+}
+
+void HandLog::flush() {
+    file.flush();
+}
+
+long long HandLog::recordCount(const std::string& logPath) {
+    std::ifstream file(logPath.c_str(), std::ios::binary | std::ios::ate);
+    if (!file) {
+        return 0;
+    }
+    long long size = static_cast<long long>(file.tellg());
+    if (size == 0) {
+        return 0;
+    }
+    char header[HEADER_BYTES];
+    file.seekg(0);
+    uint32_t version = 0;
+    uint32_t recordSize = 0;
+    if (size < HEADER_BYTES || !file.read(header, sizeof(header)) ||
+        std::memcmp(header, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0) {
+        throw TableFormatException("Not a hand history file: " + logPath);
+    }
+    std::memcpy(&version, header + 8, sizeof(version));
+    std::memcpy(&recordSize, header + 12, sizeof(recordSize));
+    if (version != VERSION || recordSize != sizeof(HandRecord)) {
+        throw TableFormatException("Hand history has a different version: " + logPath);
+    }
+    // A record cut short by a crash is ignored
+    return (size - HEADER_BYTES) / static_cast<long long>(sizeof(HandRecord));
+}
+
+bool HandLog::readRecords(std::ifstream& file, long long first, long long count, std::vector<HandRecord>& out) {
+    out.resize(static_cast<size_t>(count));
+    file.clear();
+    file.seekg(HEADER_BYTES + first * static_cast<long long>(sizeof(HandRecord)));
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(out.data()),
+                                       static_cast<std::streamsize>(count * sizeof(HandRecord))));
+}
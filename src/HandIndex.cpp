@@ -0,0 +1,301 @@
+#include "HandIndex.h"
+#include "GameException.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+/*
+ * HANDINDEX IMPLEMENTATION
+ * ------------------------
+ */
+
+static_assert(std::is_trivially_copyable<HandIndex::BlockSummary>::value, "BlockSummary is written as raw bytes");
+
+namespace {
+
+const char INDEX_MAGIC[8] = {'B', 'J', 'H', 'I', 'N', 'D', 'E', 'X'};
+
+struct IndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t summaryBytes;   // sizeof(BlockSummary) when written
+    uint64_t blockRecords;
+    uint64_t blocks;         // Summaries that are complete
+    uint64_t logIdentity;    // HandIndex::logIdentity() of the log it describes
+};
+
+const long long INDEX_HEADER_BYTES = sizeof(IndexHeader);
+
+IndexHeader makeHeader(uint64_t blocks, uint64_t logIdentity) {
+    IndexHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = HandIndex::VERSION;
+    header.summaryBytes = sizeof(HandIndex::BlockSummary);
+    header.blockRecords = HandIndex::BLOCK_RECORDS;
+    header.blocks = blocks;
+    header.logIdentity = logIdentity;
+    return header;
+}
+
+// Count the matching records of one stretch of the log
+void tally(const std::vector<HandRecord>& records, long long firstPosition, const HandQuery& query,
+           HandQueryResult& result) {
+    for (size_t i = 0; i < records.size(); i++) {
+        const HandRecord& record = records[i];
+        if (!query.matches(record)) {
+            continue;
+        }
+        result.rounds++;
+        result.outcomes[static_cast<int>(outcomeOf(record))]++;
+        result.netHalves += record.netHalves;
+        if (static_cast<int>(result.matches.size()) < query.show) {
+            HandMatch match = {firstPosition + static_cast<long long>(i), record};
+            result.matches.push_back(match);
+        }
+    }
+}
+
+} // namespace
+
+// ============== HAND QUERY ==============
+bool HandQuery::bucketsOnly() const {
+    return minDealerCards <= 0 && maxDealerCards >= 255 && minPlayerCards <= 0 && maxPlayerCards >= 255;
+}
+
+bool HandQuery::matchesBucket(int total, bool isSoft, int up, HandOutcome outcome) const {
+    return (openingTotal == 0 || total == openingTotal) &&
+           (soft < 0 || (soft == 1) == isSoft) &&
+           (upcard == 0 || up == upcard) &&
+           (outcomes & (1u << static_cast<int>(outcome))) != 0;
+}
+
+bool HandQuery::matches(const HandRecord& record) const {
+    return matchesBucket(record.openingTotal, record.has(HandRecord::OpeningSoft), record.upcardValue(),
+                         outcomeOf(record)) &&
+           record.dealerCards >= minDealerCards && record.dealerCards <= maxDealerCards &&
+           record.playerCards >= minPlayerCards && record.playerCards <= maxPlayerCards;
+}
+
+// ============== HAND INDEX ==============
+HandIndex::HandIndex(const std::string& log) : logPath(log), indexPath(log + ".idx"), indexedLog(0) {
+    load();
+}
+
+uint64_t HandIndex::logIdentity() const {
+    // FNV-1a over the log header and its first full block, which never
+    // change once written (logs only grow)
+    if (HandLog::recordCount(logPath) < BLOCK_RECORDS) {
+        return 0;
+    }
+    std::ifstream log(logPath.c_str(), std::ios::binary);
+    char header[HandLog::HEADER_BYTES];
+    std::vector<HandRecord> first;
+    if (!log.read(header, sizeof(header)) || !HandLog::readRecords(log, 0, BLOCK_RECORDS, first)) {
+        throw TableFormatException("Cannot read hand history: " + logPath);
+    }
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    auto mix = [&hash](const unsigned char* bytes, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+        }
+    };
+    mix(reinterpret_cast<const unsigned char*>(header), sizeof(header));
+    mix(reinterpret_cast<const unsigned char*>(first.data()), first.size() * sizeof(HandRecord));
+    return hash;
+}
+
+int HandIndex::bucketOf(int total, bool soft, int upcard, HandOutcome outcome) {
+    int clampedTotal = total < 0 ? 0 : (total >= TOTALS ? TOTALS - 1 : total);
+    int clampedUp = upcard < 0 ? 0 : (upcard >= UPCARDS ? UPCARDS - 1 : upcard);
+    return ((clampedTotal * 2 + (soft ? 1 : 0)) * UPCARDS + clampedUp) * OUTCOMES + static_cast<int>(outcome);
+}
+
+int HandIndex::bucketOf(const HandRecord& record) {
+    return bucketOf(record.openingTotal, record.has(HandRecord::OpeningSoft), record.upcardValue(), outcomeOf(record));
+}
+
+void HandIndex::load() {
+    blocks.clear();
+    std::ifstream file(indexPath.c_str(), std::ios::binary | std::ios::ate);
+    if (!file) {
+        return;  // Built on the first update()
+    }
+    long long size = static_cast<long long>(file.tellg());
+    IndexHeader header;
+    file.seekg(0);
+    if (size < INDEX_HEADER_BYTES || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+        header.version != VERSION || header.summaryBytes != sizeof(BlockSummary) ||
+        header.blockRecords != static_cast<uint64_t>(BLOCK_RECORDS)) {
+        return;  // Foreign or outdated - rebuilt on the next update()
+    }
+    long long stored = (size - INDEX_HEADER_BYTES) / static_cast<long long>(sizeof(BlockSummary));
+    long long count = std::min(stored, static_cast<long long>(header.blocks));
+    indexedLog = header.logIdentity;
+    blocks.resize(static_cast<size_t>(count));
+    if (count > 0 && !file.read(reinterpret_cast<char*>(blocks.data()),
+                                static_cast<std::streamsize>(count * sizeof(BlockSummary)))) {
+        blocks.clear();
+    }
+}
+
+void HandIndex::summarise(const std::vector<HandRecord>& records, BlockSummary& summary) {
+    std::memset(&summary, 0, sizeof(summary));
+    summary.minDealerCards = 255;
+    summary.minPlayerCards = 255;
+    for (const HandRecord& record : records) {
+        int bucket = bucketOf(record);
+        summary.counts[bucket]++;
+        summary.netHalves[bucket] += record.netHalves;
+        summary.minDealerCards = std::min(summary.minDealerCards, record.dealerCards);
+        summary.maxDealerCards = std::max(summary.maxDealerCards, record.dealerCards);
+        summary.minPlayerCards = std::min(summary.minPlayerCards, record.playerCards);
+        summary.maxPlayerCards = std::max(summary.maxPlayerCards, record.playerCards);
+    }
+}
+
+long long HandIndex::update() {
+    long long fullBlocks = HandLog::recordCount(logPath) / BLOCK_RECORDS;
+    uint64_t identity = logIdentity();
+    if (static_cast<long long>(blocks.size()) > fullBlocks || identity != indexedLog) {
+        blocks.clear();  // The log was replaced (by a shorter one, or a different one)
+    }
+    indexedLog = identity;
+    long long firstNew = static_cast<long long>(blocks.size());
+    if (firstNew == fullBlocks) {
+        return 0;
+    }
+
+    std::ios::openmode mode = std::ios::binary | std::ios::in | std::ios::out;
+    if (firstNew == 0) {
+        mode |= std::ios::trunc;  // Start a fresh file
+    }
+    std::fstream file(indexPath.c_str(), mode);
+    if (!file) {
+        throw TableFormatException("Cannot write hand index: " + indexPath);
+    }
+    IndexHeader header = makeHeader(static_cast<uint64_t>(firstNew), identity);
+    if (firstNew == 0) {
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    std::ifstream log(logPath.c_str(), std::ios::binary);
+    std::vector<HandRecord> records;
+    BlockSummary summary;
+    for (long long b = firstNew; b < fullBlocks; b++) {
+        if (!HandLog::readRecords(log, b * BLOCK_RECORDS, BLOCK_RECORDS, records)) {
+            throw TableFormatException("Cannot read hand history: " + logPath);
+        }
+        summarise(records, summary);
+        file.seekp(INDEX_HEADER_BYTES + b * static_cast<long long>(sizeof(BlockSummary)));
+        file.write(reinterpret_cast<const char*>(&summary), sizeof(summary));
+        blocks.push_back(summary);
+    }
+
+    // Summaries first, then the count that makes them visible
+    file.flush();
+    header.blocks = static_cast<uint64_t>(fullBlocks);
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!file) {
+        throw TableFormatException("Failed writing hand index: " + indexPath);
+    }
+    return fullBlocks - firstNew;
+}
+
+HandQueryResult HandIndex::query(const HandQuery& query, int threads) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    HandQueryResult result;
+
+    // The buckets this query can hit
+    std::vector<int> wanted;
+    std::vector<int> wantedOutcome;
+    for (int total = 0; total < TOTALS; total++) {
+        for (int soft = 0; soft < 2; soft++) {
+            for (int up = 0; up < UPCARDS; up++) {
+                for (int o = 0; o < OUTCOMES; o++) {
+                    if (query.matchesBucket(total, soft == 1, up, static_cast<HandOutcome>(o))) {
+                        wanted.push_back(bucketOf(total, soft == 1, up, static_cast<HandOutcome>(o)));
+                        wantedOutcome.push_back(o);
+                    }
+                }
+            }
+        }
+    }
+
+    long long logRecords = HandLog::recordCount(logPath);
+    long long indexed = std::min(static_cast<long long>(blocks.size()), logRecords / BLOCK_RECORDS);
+    bool indexOnly = query.bucketsOnly() && query.show == 0;
+
+    std::vector<long long> toScan;
+    for (long long b = 0; b < indexed; b++) {
+        const BlockSummary& summary = blocks[static_cast<size_t>(b)];
+        long long hits = 0;
+        for (int bucket : wanted) {
+            hits += summary.counts[bucket];
+        }
+        bool cardsPossible = query.minDealerCards <= summary.maxDealerCards &&
+                             query.maxDealerCards >= summary.minDealerCards &&
+                             query.minPlayerCards <= summary.maxPlayerCards &&
+                             query.maxPlayerCards >= summary.minPlayerCards;
+        if (hits == 0 || !cardsPossible) {
+            result.blocksSkipped++;
+        } else if (indexOnly) {
+            for (size_t i = 0; i < wanted.size(); i++) {
+                result.rounds += summary.counts[wanted[i]];
+                result.outcomes[wantedOutcome[i]] += summary.counts[wanted[i]];
+                result.netHalves += summary.netHalves[wanted[i]];
+            }
+            result.blocksFromIndex++;
+        } else {
+            toScan.push_back(b);
+        }
+    }
+
+    // Read the remaining blocks in parallel; each task owns its result slot
+    std::vector<HandQueryResult> parts(toScan.size());
+    if (!toScan.empty()) {
+        ThreadPool pool(std::max(1, std::min(threads, static_cast<int>(toScan.size()))));
+        for (size_t i = 0; i < toScan.size(); i++) {
+            pool.submit([this, &query, &toScan, &parts, i]() {
+                std::ifstream log(logPath.c_str(), std::ios::binary);
+                std::vector<HandRecord> records;
+                long long first = toScan[i] * BLOCK_RECORDS;
+                if (HandLog::readRecords(log, first, BLOCK_RECORDS, records)) {
+                    tally(records, first, query, parts[i]);
+                }
+            });
+        }
+        pool.wait();
+    }
+    for (const HandQueryResult& part : parts) {
+        result.rounds += part.rounds;
+        for (int o = 0; o < OUTCOMES; o++) {
+            result.outcomes[o] += part.outcomes[o];
+        }
+        result.netHalves += part.netHalves;
+        for (const HandMatch& match : part.matches) {
+            if (static_cast<int>(result.matches.size()) < query.show) {
+                result.matches.push_back(match);
+            }
+        }
+    }
+    result.blocksScanned = static_cast<long long>(toScan.size());
+
+    // Newest rounds that do not fill a block yet
+    result.tailRecords = logRecords - indexed * BLOCK_RECORDS;
+    if (result.tailRecords > 0) {
+        std::ifstream log(logPath.c_str(), std::ios::binary);
+        std::vector<HandRecord> records;
+        if (HandLog::readRecords(log, indexed * BLOCK_RECORDS, result.tailRecords, records)) {
+            tally(records, indexed * BLOCK_RECORDS, query, result);
+        }
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
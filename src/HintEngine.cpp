@@ -0,0 +1,93 @@
+#include "HintEngine.h"
+#include "CardFactory.h"
+#include <chrono>
+#include <string>
+
+/*
+ * HINTENGINE IMPLEMENTATION
+ * -------------------------
+ */
+
+namespace {
+const size_t HINT_CACHE_SLOTS = 1 << 16;
+}
+
+HintEngine::HintEngine(const GameConfig& gameConfig, const StrategyTables& strategyTables)
+    : config(gameConfig),
+      tables(strategyTables),
+      finiteShoe(gameConfig.useCompositionDeck),
+      budgetMicros(gameConfig.hintBudgetMicros),
+      shoe(ShoeState::standard(gameConfig.deckSize)),
+      dealerCache(HINT_CACHE_SLOTS),
+      playerCache(HINT_CACHE_SLOTS) {
+}
+
+void HintEngine::newShoe() {
+    shoe = ShoeState::standard(config.deckSize);
+}
+
+void HintEngine::cardDrawn(const Card& card) {
+    if (!finiteShoe) {
+        return;  // Deck cards are independent - nothing to track
+    }
+    int rank = rankOf(card);
+    if (shoe.getCount(rank) > 0) {
+        shoe.removeRank(rank);
+    }
+}
+
+int HintEngine::rankOf(const Card& card) {
+    return CardFactory::rankOf(card);
+}
+
+void HintEngine::resumeShoe(const ShoeState& remaining) {
+    if (finiteShoe) {
+        shoe = remaining;
+    }
+}
+
+HandState HintEngine::handOf(Player& hand) {
+    // The Solver only needs the hard total, whether an Ace can count as 11 and the card count
+    HandState state;
+    bool soft = hand.isSoft();
+    state.total = hand.getScore() - (soft ? 10 : 0);
+    state.aces = soft ? 1 : 0;
+    state.cards = hand.getCardCount();
+    return state;
+}
+
+Hint HintEngine::hint(Player& hand, Player& dealer) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Hint result;
+
+    HandState player = handOf(hand);
+    HandState up = handOf(dealer);
+    int score = player.getScore();
+    int upcard = up.total > UPCARDS ? UPCARDS : up.total;
+    result.values = tables.actionValues(player.isSoft(), score, upcard);
+
+    if (finiteShoe) {
+        // A solve from an earlier prompt may still be running - never queue a second one
+        bool busy = pending.valid() &&
+                    pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+        if (!busy) {
+            if (pending.valid()) {
+                pending.get();  // Finished earlier; its work lives on in the caches
+            }
+            ShoeState current = shoe;
+            pending = std::async(std::launch::async, [this, current, player, up]() {
+                Solver exact(config, &dealerCache, &playerCache);
+                return exact.actionValues(current, player, up);
+            });
+            if (pending.wait_for(std::chrono::microseconds(budgetMicros)) == std::future_status::ready) {
+                result.values = pending.get();
+                result.exact = true;
+            }
+        }
+    } else {
+        result.exact = true;  // Infinite deck: the table is the exact answer
+    }
+
+    result.micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
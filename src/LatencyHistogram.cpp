@@ -0,0 +1,82 @@
+#include "LatencyHistogram.h"
+
+/*
+ * LATENCYHISTOGRAM IMPLEMENTATION
+ * -------------------------------
+ */
+
+LatencyHistogram::LatencyHistogram() {
+    for (int i = 0; i < BUCKETS; i++) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+}
+
+int LatencyHistogram::bucketOf(uint64_t value) {
+    if (value < static_cast<uint64_t>(LINEAR)) {
+        return static_cast<int>(value);
+    }
+    int highest = 63;
+    while ((value >> highest) == 0) {
+        highest--;
+    }
+    if (highest > MAX_BIT) {
+        return BUCKETS - 1;
+    }
+    int shift = highest - (SUB_BITS - 1);               // >= 1
+    int sub = static_cast<int>(value >> shift) - HALF;   // 0..HALF-1
+    return LINEAR + (shift - 1) * HALF + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int bucket) {
+    if (bucket < LINEAR) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int shift = (bucket - LINEAR) / HALF + 1;
+    uint64_t sub = static_cast<uint64_t>((bucket - LINEAR) % HALF + HALF);
+    return ((sub + 1) << shift) - 1;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot copy;
+    for (int i = 0; i < BUCKETS; i++) {
+        copy.counts[i] = counts[i].load(std::memory_order_relaxed);
+    }
+    copy.count = count.load(std::memory_order_relaxed);
+    copy.sum = sum.load(std::memory_order_relaxed);
+    return copy;
+}
+
+LatencyHistogram::Snapshot::Snapshot() : count(0), sum(0) {
+    for (int i = 0; i < BUCKETS; i++) {
+        counts[i] = 0;
+    }
+}
+
+void LatencyHistogram::Snapshot::merge(const Snapshot& other) {
+    for (int i = 0; i < BUCKETS; i++) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sum += other.sum;
+}
+
+uint64_t LatencyHistogram::Snapshot::quantile(double q) const {
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        total += counts[i];  // Buckets, not 'count': a concurrent copy may be a few records apart
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(BUCKETS - 1);
+}
@@ -0,0 +1,73 @@
+#include "MatchOdds.h"
+#include <limits>
+
+/*
+ * MATCHODDS IMPLEMENTATION
+ * ------------------------
+ */
+
+MatchOdds::MatchOdds(int target, const Outcome& roundOutcome)
+    : targetScore(target < 1 ? 1 : target),
+      round(roundOutcome),
+      win(static_cast<size_t>(targetScore) * targetScore, 0.0),
+      rounds(static_cast<size_t>(targetScore) * targetScore, 0.0) {
+    const double decisive = round.win + round.loss;
+    if (decisive <= 0.0) {
+        // Every round is a tie - nobody ever reaches the target
+        for (double& r : rounds) {
+            r = std::numeric_limits<double>::infinity();
+        }
+        return;
+    }
+
+    // Work backwards from the states next to the target
+    for (int a = targetScore - 1; a >= 0; a--) {
+        for (int b = targetScore - 1; b >= 0; b--) {
+            double winNext = (a + 1 < targetScore) ? win[index(a + 1, b)] : 1.0;
+            double lossNext = (b + 1 < targetScore) ? win[index(a, b + 1)] : 0.0;
+            win[index(a, b)] = (round.win * winNext + round.loss * lossNext) / decisive;
+
+            double roundsWin = (a + 1 < targetScore) ? rounds[index(a + 1, b)] : 0.0;
+            double roundsLoss = (b + 1 < targetScore) ? rounds[index(a, b + 1)] : 0.0;
+            rounds[index(a, b)] = (1.0 + round.win * roundsWin + round.loss * roundsLoss) / decisive;
+        }
+    }
+}
+
+double MatchOdds::winProbability(int playerPoints, int dealerPoints) const {
+    if (playerPoints >= targetScore) {
+        return 1.0;
+    }
+    if (dealerPoints >= targetScore) {
+        return 0.0;
+    }
+    return win[index(playerPoints < 0 ? 0 : playerPoints, dealerPoints < 0 ? 0 : dealerPoints)];
+}
+
+double MatchOdds::lossProbability(int playerPoints, int dealerPoints) const {
+    if (playerPoints >= targetScore) {
+        return 0.0;
+    }
+    if (dealerPoints >= targetScore) {
+        return 1.0;
+    }
+    if (round.win + round.loss <= 0.0) {
+        return 0.0;
+    }
+    return 1.0 - winProbability(playerPoints, dealerPoints);
+}
+
+double MatchOdds::expectedRounds(int playerPoints, int dealerPoints) const {
+    if (playerPoints >= targetScore || dealerPoints >= targetScore) {
+        return 0.0;
+    }
+    return rounds[index(playerPoints < 0 ? 0 : playerPoints, dealerPoints < 0 ? 0 : dealerPoints)];
+}
+
+Outcome MatchOdds::roundOdds(const GameConfig& config) {
+    // Small private caches - the round recursion revisits the same hands constantly
+    Solver::DealerCache dealerCache(1 << 12);
+    Solver::PlayerCache playerCache(1 << 12);
+    Solver solver(config, &dealerCache, &playerCache);
+    return solver.roundOutcome(ShoeState::standard(config.deckSize));
+}
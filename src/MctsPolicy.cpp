@@ -0,0 +1,220 @@
+#include "MctsPolicy.h"
+#include "Rules.h"
+#include "Strategy.h"
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+/*
+ * MCTS POLICY IMPLEMENTATION
+ * --------------------------
+ */
+
+namespace {
+
+const int STAND = 0;
+const int HIT = 1;
+const int DOUBLE = 2;
+const int TIME_CHECK_INTERVAL = 64;  // Rollouts between clock reads
+
+/*
+ * UCB1 choice between the first 'count' actions. Untried actions go
+ * first; after that the best average plus an exploration bonus.
+ */
+int chooseUcb(const long long* visits, const double* total, int count, double exploration) {
+    long long parentVisits = 0;
+    for (int a = 0; a < count; a++) {
+        if (visits[a] == 0) {
+            return a;
+        }
+        parentVisits += visits[a];
+    }
+    double logParent = std::log(static_cast<double>(parentVisits));
+    int best = 0;
+    double bestScore = -1e300;
+    for (int a = 0; a < count; a++) {
+        double n = static_cast<double>(visits[a]);
+        double score = total[a] / n + exploration * std::sqrt(logParent / n);
+        if (score > bestScore) {
+            bestScore = score;
+            best = a;
+        }
+    }
+    return best;
+}
+
+// Decision point below the root: hard total x soft, Stand/Hit statistics
+struct Node {
+    long long visits[2] = {};
+    double total[2] = {};
+};
+
+} // namespace
+
+MctsPolicy::MctsPolicy(const GameConfig& config, const MctsOptions& searchOptions)
+    : options(searchOptions),
+      deckSize(config.deckSize),
+      dealerThreshold(createDealerStrategy(config.useAggressiveDealer)->getThreshold()),
+      finiteShoe(config.useCompositionDeck),
+      hitSoft17(config.ruleVariant == RuleVariant::Vegas),
+      allowDouble(config.ruleVariant != RuleVariant::Classic) {
+    if (options.threads > 1) {
+        pool.reset(new ThreadPool(options.threads - 1));  // The caller runs one tree itself
+    }
+}
+
+PlayerAction MctsPolicy::decide(const HandState& hand, int dealerUpcard, const ShoeState& shoe) const {
+    return search(hand, dealerUpcard, shoe).action;
+}
+
+uint64_t MctsPolicy::identity() const {
+    // The rules it plays under come from the GameConfig, which the caller keys on already
+    uint64_t hash = hashName("mcts");
+    hash = hashBytes(hash, &options.rollouts, sizeof(options.rollouts));
+    hash = hashBytes(hash, &options.timeMicros, sizeof(options.timeMicros));
+    hash = hashBytes(hash, &options.threads, sizeof(options.threads));
+    hash = hashBytes(hash, &options.exploration, sizeof(options.exploration));
+    return hashBytes(hash, &options.seed, sizeof(options.seed));
+}
+
+int MctsPolicy::drawRank(ShoeState& shoe, Rng& rng) const {
+    if (!finiteShoe) {
+        return static_cast<int>(rng.below(ShoeState::RANKS)) + 1;  // Same as Deck
+    }
+    if (shoe.isEmpty()) {
+        shoe = ShoeState::standard(deckSize);  // Like Game: a fresh deck when it runs out
+    }
+    return shoe.drawRank(rng);
+}
+
+MctsPolicy::RootStats MctsPolicy::searchTree(const HandState& hand, int dealerUpcard, const ShoeState& shoe,
+                                             Rng rng, long long rollouts, Clock::time_point deadline) const {
+    RootStats root;
+    Node nodes[22][2];   // [hard total][soft]
+    const int rootActions = (allowDouble && hand.cards == 2) ? 3 : 2;
+    const bool timed = options.timeMicros > 0;
+
+    for (long long r = 0; r < rollouts; r++) {
+        if (timed && r % TIME_CHECK_INTERVAL == 0 && r > 0 && Clock::now() >= deadline) {
+            break;
+        }
+
+        ShoeState cards = shoe;
+        HandState player = hand;
+        Node* path[22];
+        int pathActions[22];
+        int depth = 0;
+        double stake = 1.0;
+
+        // Selection and expansion: play the hand out with UCB1 at each decision
+        int rootAction = chooseUcb(root.visits, root.total, rootActions, options.exploration);
+        if (rootAction != STAND) {
+            player.addRank(drawRank(cards, rng));
+            if (rootAction == DOUBLE) {
+                stake = 2.0;  // One card only
+            } else {
+                while (!player.isBust() && player.getScore() < 21) {
+                    Node& node = nodes[player.total][player.isSoft() ? 1 : 0];
+                    int action = chooseUcb(node.visits, node.total, 2, options.exploration);
+                    path[depth] = &node;
+                    pathActions[depth] = action;
+                    depth++;
+                    if (action == STAND) {
+                        break;
+                    }
+                    player.addRank(drawRank(cards, rng));
+                }
+            }
+        }
+
+        // The dealer plays only if the player is still in (as in Game)
+        HandState dealer;
+        if (dealerUpcard > 0) {
+            dealer.addRank(dealerUpcard);
+        }
+        if (!player.isBust()) {
+            while (dealer.getScore() < dealerThreshold || (hitSoft17 && dealer.isSoft() && dealer.getScore() <= 17)) {
+                dealer.addRank(drawRank(cards, rng));
+            }
+        }
+        double reward = settleHand<ClassicRules>(player.getScore(), false, dealer.getScore(), false, stake, false);
+
+        // Backpropagation
+        root.visits[rootAction]++;
+        root.total[rootAction] += reward;
+        for (int d = 0; d < depth; d++) {
+            path[d]->visits[pathActions[d]]++;
+            path[d]->total[pathActions[d]] += reward;
+        }
+        root.rollouts++;
+    }
+    return root;
+}
+
+MctsResult MctsPolicy::search(const HandState& hand, int dealerUpcard, const ShoeState& shoe) const {
+    MctsResult result;
+    if (hand.isBust() || hand.getScore() >= 21) {
+        return result;  // Nothing to decide
+    }
+
+    const int trees = options.threads > 1 ? options.threads : 1;
+    const long long perTree = (options.rollouts + trees - 1) / trees;
+    const Clock::time_point deadline = Clock::now() + std::chrono::microseconds(options.timeMicros);
+
+    // Random streams depend on the position, so answers are repeatable
+    uint64_t position = shoe.hash() ^ (static_cast<uint64_t>(hand.total) |
+                                       static_cast<uint64_t>(hand.aces) << 8 |
+                                       static_cast<uint64_t>(hand.cards) << 16 |
+                                       static_cast<uint64_t>(dealerUpcard) << 24);
+    uint64_t seed = Rng::forStream(options.seed, position).next();
+
+    std::vector<RootStats> results(static_cast<size_t>(trees));
+    if (pool) {
+        // Trees 1..n-1 on the pool, tree 0 on this thread, then wait for our own tasks
+        std::mutex doneLock;
+        std::condition_variable doneSignal;
+        int remaining = trees - 1;
+        for (int t = 1; t < trees; t++) {
+            pool->submit([&, t]() {
+                results[static_cast<size_t>(t)] =
+                    searchTree(hand, dealerUpcard, shoe, Rng::forStream(seed, t), perTree, deadline);
+                std::lock_guard<std::mutex> guard(doneLock);
+                if (--remaining == 0) {
+                    doneSignal.notify_one();
+                }
+            });
+        }
+        results[0] = searchTree(hand, dealerUpcard, shoe, Rng::forStream(seed, 0), perTree, deadline);
+        std::unique_lock<std::mutex> guard(doneLock);
+        doneSignal.wait(guard, [&]() { return remaining == 0; });
+    } else {
+        results[0] = searchTree(hand, dealerUpcard, shoe, Rng::forStream(seed, 0), perTree, deadline);
+    }
+
+    // Merge the roots and pick the best average
+    RootStats merged;
+    for (const RootStats& tree : results) {
+        for (int a = 0; a < ROOT_ACTIONS; a++) {
+            merged.visits[a] += tree.visits[a];
+            merged.total[a] += tree.total[a];
+        }
+        merged.rollouts += tree.rollouts;
+    }
+
+    static const PlayerAction ACTIONS[ROOT_ACTIONS] = {PlayerAction::Stand, PlayerAction::Hit, PlayerAction::Double};
+    double bestValue = -1e300;
+    for (int a = 0; a < ROOT_ACTIONS; a++) {
+        if (merged.visits[a] == 0) {
+            continue;
+        }
+        double value = merged.total[a] / static_cast<double>(merged.visits[a]);
+        if (value > bestValue) {
+            bestValue = value;
+            result.action = ACTIONS[a];
+        }
+    }
+    result.value = merged.rollouts > 0 ? bestValue : 0.0;
+    result.rollouts = merged.rollouts;
+    return result;
+}
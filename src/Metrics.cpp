@@ -0,0 +1,99 @@
+#include "Metrics.h"
+#include <sstream>
+
+/*
+ * METRICS IMPLEMENTATION
+ * ----------------------
+ */
+
+Metrics::Metrics() : activeSessions(0), lastScrapeNanos(now()), lastScrapeRounds(0) {
+}
+
+Metrics& Metrics::global() {
+    static Metrics metrics;
+    return metrics;
+}
+
+const char* Metrics::phaseName(MetricPhase phase) {
+    switch (phase) {
+    case MetricPhase::Deal:
+        return "deal";
+    case MetricPhase::PlayerAction:
+        return "player_action";
+    case MetricPhase::DealerTurn:
+        return "dealer";
+    case MetricPhase::Scoring:
+        return "scoring";
+    case MetricPhase::Round:
+    case MetricPhase::COUNT:
+        break;
+    }
+    return "round";
+}
+
+MetricsRecorder& Metrics::threadRecorder() {
+    // Cached per thread, so only the first call on a thread takes the lock
+    thread_local Metrics* owner = nullptr;
+    thread_local MetricsRecorder* recorder = nullptr;
+    if (owner != this) {
+        std::lock_guard<std::mutex> guard(registryLock);
+        recorders.push_back(std::unique_ptr<MetricsRecorder>(new MetricsRecorder()));
+        recorder = recorders.back().get();
+        owner = this;
+    }
+    return *recorder;
+}
+
+std::string Metrics::prometheusText() {
+    const double NANOS = 1e-9;
+    LatencyHistogram::Snapshot phases[MetricsRecorder::PHASES];
+    uint64_t rounds = 0;
+    uint64_t reshuffles = 0;
+    uint64_t scrapeNanos = 0;
+    uint64_t previousNanos = 0;
+    uint64_t previousRounds = 0;
+    {
+        std::lock_guard<std::mutex> guard(registryLock);
+        for (const std::unique_ptr<MetricsRecorder>& recorder : recorders) {
+            for (int p = 0; p < MetricsRecorder::PHASES; p++) {
+                phases[p].merge(recorder->histograms[p].snapshot());
+            }
+            rounds += recorder->rounds.load(std::memory_order_relaxed);
+            reshuffles += recorder->reshuffles.load(std::memory_order_relaxed);
+        }
+        scrapeNanos = now();
+        previousNanos = lastScrapeNanos;
+        previousRounds = lastScrapeRounds;
+        lastScrapeNanos = scrapeNanos;
+        lastScrapeRounds = rounds;
+    }
+
+    std::ostringstream text;
+    text << "# HELP blackjack_latency_seconds Time spent in each part of a round.\n";
+    text << "# TYPE blackjack_latency_seconds summary\n";
+    const double QUANTILES[] = {0.5, 0.99, 0.999};
+    for (int p = 0; p < MetricsRecorder::PHASES; p++) {
+        const char* name = phaseName(static_cast<MetricPhase>(p));
+        for (double q : QUANTILES) {
+            text << "blackjack_latency_seconds{phase=\"" << name << "\",quantile=\"" << q << "\"} "
+                 << phases[p].quantile(q) * NANOS << "\n";
+        }
+        text << "blackjack_latency_seconds_sum{phase=\"" << name << "\"} " << phases[p].sum * NANOS << "\n";
+        text << "blackjack_latency_seconds_count{phase=\"" << name << "\"} " << phases[p].count << "\n";
+    }
+
+    double elapsed = (scrapeNanos - previousNanos) * NANOS;
+    text << "# HELP blackjack_rounds_total Rounds finished.\n";
+    text << "# TYPE blackjack_rounds_total counter\n";
+    text << "blackjack_rounds_total " << rounds << "\n";
+    text << "# HELP blackjack_rounds_per_second Rounds finished per second since the previous scrape.\n";
+    text << "# TYPE blackjack_rounds_per_second gauge\n";
+    text << "blackjack_rounds_per_second " << (elapsed > 0.0 ? (rounds - previousRounds) / elapsed : 0.0) << "\n";
+    text << "# HELP blackjack_reshuffles_total Shoes replaced because they ran low.\n";
+    text << "# TYPE blackjack_reshuffles_total counter\n";
+    text << "blackjack_reshuffles_total " << reshuffles << "\n";
+    text << "# HELP blackjack_active_sessions Games currently running.\n";
+    text << "# TYPE blackjack_active_sessions gauge\n";
+    text << "blackjack_active_sessions " << activeSessions.load(std::memory_order_relaxed) << "\n";
+    return text.str();
+}
@@ -0,0 +1,139 @@
+#include "MetricsServer.h"
+#include <cstring>
+#include <string>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // Not on every system; a closed scraper then only fails that send
+#endif
+#endif
+
+/*
+ * METRICSSERVER IMPLEMENTATION
+ * ----------------------------
+ */
+
+MetricsServer::MetricsServer(Metrics& source, int listenPort)
+    : metrics(source), port(listenPort), listenSocket(-1), stopping(false) {
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+#if defined(_WIN32)
+
+bool MetricsServer::start() {
+    return false;
+}
+
+void MetricsServer::stop() {
+}
+
+void MetricsServer::serveLoop() {
+}
+
+void MetricsServer::answer(int) {
+}
+
+#else
+
+bool MetricsServer::start() {
+    if (listenSocket >= 0) {
+        return true;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    int yes = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  // Localhost only
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    socklen_t length = sizeof(address);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 8) != 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        close(fd);
+        return false;
+    }
+    port = ntohs(address.sin_port);
+    listenSocket = fd;
+    stopping = false;
+    server = std::thread(&MetricsServer::serveLoop, this);
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (listenSocket < 0) {
+        return;
+    }
+    stopping = true;
+    server.join();
+    close(listenSocket);
+    listenSocket = -1;
+}
+
+void MetricsServer::serveLoop() {
+    while (!stopping) {
+        // Wake up regularly to notice stop()
+        pollfd watch;
+        watch.fd = listenSocket;
+        watch.events = POLLIN;
+        watch.revents = 0;
+        if (poll(&watch, 1, 200) <= 0) {
+            continue;
+        }
+        int client = accept(listenSocket, nullptr, nullptr);
+        if (client >= 0) {
+            answer(client);
+            close(client);
+        }
+    }
+}
+
+void MetricsServer::answer(int client) {
+    // Read the request head (a scrape is a single small GET)
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        pollfd watch;
+        watch.fd = client;
+        watch.events = POLLIN;
+        watch.revents = 0;
+        if (poll(&watch, 1, 1000) <= 0) {
+            return;  // Slow or silent client
+        }
+        ssize_t got = recv(client, buffer, sizeof(buffer), 0);
+        if (got <= 0) {
+            return;
+        }
+        request.append(buffer, static_cast<size_t>(got));
+    }
+
+    bool scrape = request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 14, "GET /metrics?") == 0;
+    std::string body = scrape ? metrics.prometheusText() : std::string("Not found. Try /metrics\n");
+    std::string response = std::string(scrape ? "HTTP/1.1 200 OK\r\n" : "HTTP/1.1 404 Not Found\r\n") +
+                           "Content-Type: text/plain; version=0.0.4\r\n"
+                           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                           "Connection: close\r\n\r\n" + body;
+
+    size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t wrote = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (wrote <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(wrote);
+    }
+}
+
+#endif
@@ -56,6 +56,45 @@ void Player::addCard(Card* c) {
     hand[cardCount++] = c;  // Store the card pointer
 }
 
+Card* Player::removeLastCard() {
+    /*
+     * OWNERSHIP TRANSFER BACK OUT:
+     * Used when a pair is split - the second card moves to a new hand.
+     * The caller becomes responsible for the returned Card.
+     */
+    if (cardCount == 0) {
+        return nullptr;
+    }
+
+    Card* last = hand[--cardCount];
+    if (dynamic_cast<AceCard*>(last) != nullptr) {
+        aceCount--;
+    }
+    return last;
+}
+
+int Player::getCardCount() const {
+    return cardCount;
+}
+
+const Card& Player::getCard(int index) const {
+    return *hand[index];
+}
+
+bool Player::isPair() {
+    return cardCount == 2 && hand[0]->getValue() == hand[1]->getValue();
+}
+
+bool Player::isSoft() {
+    // Soft when counting every Ace as 1 leaves room for one Ace as 11
+    int hardTotal = 0;
+    for (int i = 0; i < cardCount; i++) {
+        hardTotal += hand[i]->getValue();
+    }
+    hardTotal -= 10 * aceCount;
+    return aceCount > 0 && hardTotal + 10 <= 21;
+}
+
 int Player::getScore() {
     /*
      * ACE HANDLING LOGIC:
@@ -0,0 +1,71 @@
+#include "PlayerPolicy.h"
+#include <cstring>
+
+/*
+ * PLAYER POLICY IMPLEMENTATIONS
+ * -----------------------------
+ */
+
+const uint64_t PlayerPolicy::IDENTITY_SEED;
+
+uint64_t PlayerPolicy::hashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+uint64_t PlayerPolicy::hashName(const char* name) {
+    return hashBytes(IDENTITY_SEED, name, std::strlen(name));
+}
+
+ThresholdPolicy::ThresholdPolicy(int threshold) : standAt(threshold) {
+}
+
+uint64_t ThresholdPolicy::identity() const {
+    return hashBytes(hashName("threshold"), &standAt, sizeof(standAt));
+}
+
+uint64_t BasicStrategyPolicy::identity() const {
+    return hashName("basic");
+}
+
+PlayerAction ThresholdPolicy::decide(const HandState& hand, int, const ShoeState&) const {
+    return hand.getScore() < standAt ? PlayerAction::Hit : PlayerAction::Stand;
+}
+
+PlayerAction BasicStrategyPolicy::decide(const HandState& hand, int dealerUpcard, const ShoeState&) const {
+    // Dealer upcard as a value 2-11 (Ace = 11)
+    int up = dealerUpcard == 1 ? 11 : (dealerUpcard > 10 ? 10 : dealerUpcard);
+    int score = hand.getScore();
+    bool twoCards = hand.cards == 2;
+
+    if (twoCards && hand.isPair()) {
+        int pair = hand.first == 1 ? 11 : (hand.first > 10 ? 10 : hand.first);
+        if (pair == 11 || pair == 8) return PlayerAction::Split;
+        if (pair == 9 && up != 7 && up <= 9) return PlayerAction::Split;
+        if ((pair == 2 || pair == 3 || pair == 7) && up <= 7) return PlayerAction::Split;
+        if (pair == 6 && up <= 6) return PlayerAction::Split;
+    }
+
+    if (hand.isSoft()) {
+        if (twoCards && score >= 13 && score <= 18 && up >= 5 && up <= 6) return PlayerAction::Double;
+        if (score >= 19) return PlayerAction::Stand;
+        if (score == 18) return up <= 8 ? PlayerAction::Stand : PlayerAction::Hit;
+        return PlayerAction::Hit;
+    }
+
+    if (twoCards) {
+        if (score == 16 && up >= 9) return PlayerAction::Surrender;
+        if (score == 15 && up == 10) return PlayerAction::Surrender;
+        if (score == 11 && up <= 10) return PlayerAction::Double;
+        if (score == 10 && up <= 9) return PlayerAction::Double;
+        if (score == 9 && up >= 3 && up <= 6) return PlayerAction::Double;
+    }
+
+    if (score >= 17) return PlayerAction::Stand;
+    if (score >= 13) return up <= 6 ? PlayerAction::Stand : PlayerAction::Hit;
+    if (score == 12) return (up >= 4 && up <= 6) ? PlayerAction::Stand : PlayerAction::Hit;
+    return PlayerAction::Hit;
+}
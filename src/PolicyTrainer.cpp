@@ -0,0 +1,255 @@
+#include "PolicyTrainer.h"
+#include "CheckpointWriter.h"  // For writeAtomically
+#include "GameException.h"
+#include "Rng.h"
+#include "Rules.h"
+#include "Simulator.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+/*
+ * POLICYTRAINER IMPLEMENTATION
+ * ----------------------------
+ */
+
+namespace {
+const char* const CHECKPOINT_HEADER = "blackjack-trainer-checkpoint";
+const int CHECKPOINT_VERSION = 2;  // 2: config key
+const int STAND = 0;
+const int HIT = 1;
+}
+
+PolicyTrainer::PolicyTrainer(const GameConfig& gameConfig, const TrainerOptions& trainerOptions)
+    : config(gameConfig), options(trainerOptions), episodesDone(0), epochsDone(0) {
+    options.actors = std::max(1, options.actors);
+    options.epochEpisodes = std::max(1LL, options.epochEpisodes);
+}
+
+double PolicyTrainer::mean(int index) const {
+    double n = values.count[static_cast<size_t>(index)];
+    return n > 0.0 ? values.sum[static_cast<size_t>(index)] / n : 0.0;
+}
+
+DecisionTable PolicyTrainer::table() const {
+    DecisionTable result;
+    for (int soft = 0; soft < 2; soft++) {
+        for (int total = 0; total < TOTALS; total++) {
+            for (int up = 1; up < UPCARDS; up++) {
+                int stand = cell(soft == 1, total, up, STAND);
+                int hit = cell(soft == 1, total, up, HIT);
+                // Keep the default until both actions have been tried
+                if (values.count[static_cast<size_t>(stand)] == 0.0 || values.count[static_cast<size_t>(hit)] == 0.0) {
+                    continue;
+                }
+                result.set(soft == 1, total, up, mean(hit) > mean(stand) ? PlayerAction::Hit : PlayerAction::Stand);
+            }
+        }
+    }
+    return result;
+}
+
+void PolicyTrainer::runActor(Shard& shard, const DecisionTable& greedy, uint64_t stream,
+                             long long episodes, double epsilon) const {
+    RoundEngine engine(config);
+    Rng rng = Rng::forStream(options.seed, stream);
+    ShoeState shoe = engine.freshShoe();
+    const int dealerThreshold = engine.getDealerThreshold();
+    int path[DecisionTable::MAX_TOTAL + 1];
+
+    for (long long e = 0; e < episodes; e++) {
+        // Same round as RoundEngine with the Classic rules, recording each decision
+        HandState hand;
+        HandState dealer;
+        int upcard = 0;
+        if (!shoe.isEmpty()) hand.addRank(engine.drawRank(shoe, rng));
+        if (!shoe.isEmpty()) hand.addRank(engine.drawRank(shoe, rng));
+        if (!shoe.isEmpty()) {
+            upcard = engine.drawRank(shoe, rng);
+            dealer.addRank(upcard);
+        }
+        int up = upcard < 1 ? DecisionTable::UPCARDS : DecisionTable::column(upcard);
+
+        int steps = 0;
+        while (hand.getScore() < 21 && !shoe.isEmpty()) {
+            bool soft = hand.isSoft();
+            int total = hand.getScore();
+            int action = greedy.get(soft, total, up) == PlayerAction::Hit ? HIT : STAND;
+            if (rng.uniform() < epsilon) {
+                action = static_cast<int>(rng.below(2));  // Explore
+            }
+            path[steps++] = cell(soft, total, up, action);
+            if (action == STAND) {
+                break;
+            }
+            hand.addRank(engine.drawRank(shoe, rng));
+        }
+
+        if (!hand.isBust()) {
+            while (dealerDraws<ClassicRules>(dealer.getScore(), dealer.isSoft(), dealerThreshold) && !shoe.isEmpty()) {
+                dealer.addRank(engine.drawRank(shoe, rng));
+            }
+        }
+        double net = settleHand<ClassicRules>(hand.getScore(), false, dealer.getScore(), false, 1.0, false);
+
+        for (int s = 0; s < steps; s++) {
+            shard.sum[static_cast<size_t>(path[s])] += net;
+            shard.count[static_cast<size_t>(path[s])] += 1.0;
+        }
+
+        if (shoe.getSize() < config.reshuffleThreshold) {
+            shoe = engine.freshShoe();
+        }
+    }
+}
+
+TrainingProgress PolicyTrainer::train(const ProgressCallback& onEpoch) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ThreadPool pool(options.actors);
+    TrainingProgress progress;
+    const long long startEpisodes = episodesDone;
+    int quietEpochs = 0;
+
+    while (episodesDone < options.episodes) {
+        long long epochEpisodes = std::min(options.epochEpisodes, options.episodes - episodesDone);
+        double epsilon = std::max(options.minEpsilon, options.epsilon / (1.0 + epochsDone));
+        DecisionTable greedy = table();  // Frozen for the whole epoch
+        std::vector<double> before(CELLS);
+        for (int i = 0; i < CELLS; i++) {
+            before[static_cast<size_t>(i)] = mean(i);
+        }
+
+        // Every actor fills its own shard
+        std::vector<Shard> shards(static_cast<size_t>(options.actors));
+        for (int a = 0; a < options.actors; a++) {
+            long long share = epochEpisodes / options.actors + (a < epochEpisodes % options.actors ? 1 : 0);
+            uint64_t stream = static_cast<uint64_t>(epochsDone) * static_cast<uint64_t>(options.actors) + a;
+            Shard* shard = &shards[static_cast<size_t>(a)];
+            pool.submit([this, shard, &greedy, stream, share, epsilon]() {
+                runActor(*shard, greedy, stream, share, epsilon);
+            });
+        }
+        pool.wait();
+
+        // Fade out older results, then merge in actor order
+        for (int i = 0; i < CELLS; i++) {
+            values.sum[static_cast<size_t>(i)] *= options.keepOld;
+            values.count[static_cast<size_t>(i)] *= options.keepOld;
+        }
+        for (const Shard& shard : shards) {
+            for (int i = 0; i < CELLS; i++) {
+                values.sum[static_cast<size_t>(i)] += shard.sum[static_cast<size_t>(i)];
+                values.count[static_cast<size_t>(i)] += shard.count[static_cast<size_t>(i)];
+            }
+        }
+        episodesDone += epochEpisodes;
+        epochsDone++;
+
+        // Convergence metrics
+        DecisionTable learned = table();
+        progress.policyChanges = 0;
+        for (int soft = 0; soft < 2; soft++) {
+            for (int total = 0; total < TOTALS; total++) {
+                for (int up = 1; up < UPCARDS; up++) {
+                    if (learned.get(soft == 1, total, up) != greedy.get(soft == 1, total, up)) {
+                        progress.policyChanges++;
+                    }
+                }
+            }
+        }
+        progress.maxValueChange = 0.0;
+        for (int i = 0; i < CELLS; i++) {
+            progress.maxValueChange = std::max(progress.maxValueChange, std::fabs(mean(i) - before[static_cast<size_t>(i)]));
+        }
+        progress.epoch = epochsDone;
+        progress.episodes = episodesDone;
+        progress.epsilon = epsilon;
+        progress.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        progress.roundsPerSecond = static_cast<double>(episodesDone - startEpisodes) / std::max(progress.seconds, 1e-9);
+
+        if (!options.checkpointPath.empty()) {
+            saveCheckpoint(options.checkpointPath);
+        }
+        if (onEpoch) {
+            onEpoch(progress);
+        }
+
+        quietEpochs = progress.policyChanges == 0 ? quietEpochs + 1 : 0;
+        if (options.stableEpochs > 0 && quietEpochs >= options.stableEpochs) {
+            break;
+        }
+    }
+    return progress;
+}
+
+uint64_t PolicyTrainer::checkpointKey() const {
+    // Everything that decides what the sums and counts mean. Seed, actors
+    // and epoch size only pick the rounds, so a run may resume with others
+    const double parts[] = {
+        static_cast<double>(config.ruleVariant), static_cast<double>(RoundEngine(config).getDealerThreshold()),
+        static_cast<double>(config.deckSize), static_cast<double>(config.reshuffleThreshold),
+        config.useCompositionDeck ? 1.0 : 0.0, options.epsilon, options.minEpsilon, options.keepOld};
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (double part : parts) {
+        uint64_t bits;
+        std::memcpy(&bits, &part, sizeof(bits));
+        hash = (hash ^ bits) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+void PolicyTrainer::saveCheckpoint(const std::string& path) const {
+    std::ostringstream text;
+    text << CHECKPOINT_HEADER << " " << CHECKPOINT_VERSION << "\n";
+    text << "key " << std::hex << checkpointKey() << std::dec << "\n";
+    text << "episodes " << episodesDone << "\n";
+    text << "epochs " << epochsDone << "\n";
+    text << "cells " << CELLS << "\n";
+    text << std::setprecision(17);
+    for (int i = 0; i < CELLS; i++) {
+        text << values.sum[static_cast<size_t>(i)] << " " << values.count[static_cast<size_t>(i)] << "\n";
+    }
+    // Temporary file, fsync and rename: a crash leaves the old checkpoint or the new one
+    if (!CheckpointWriter::writeAtomically(path, text.str())) {
+        throw TableFormatException("Cannot write checkpoint: " + path);
+    }
+}
+
+void PolicyTrainer::resume(const std::string& path) {
+    std::ifstream file(path.c_str());
+    if (!file) {
+        throw TableFormatException("Cannot open checkpoint: " + path);
+    }
+    std::string header, label;
+    int version = 0;
+    int cells = 0;
+    uint64_t key = 0;
+    Shard loaded;
+    long long episodes = 0;
+    int epochs = 0;
+    if (!(file >> header >> version) || header != CHECKPOINT_HEADER || version != CHECKPOINT_VERSION) {
+        throw TableFormatException("Not a trainer checkpoint (or wrong version): " + path);
+    }
+    if (!(file >> label >> std::hex >> key >> std::dec) || label != "key" ||
+        !(file >> label >> episodes) || label != "episodes" ||
+        !(file >> label >> epochs) || label != "epochs" ||
+        !(file >> label >> cells) || label != "cells" || cells != CELLS) {
+        throw TableFormatException("Bad checkpoint header: " + path);
+    }
+    if (key != checkpointKey()) {
+        throw TableFormatException("Checkpoint was trained with different rules or settings: " + path);
+    }
+    for (int i = 0; i < CELLS; i++) {
+        if (!(file >> loaded.sum[static_cast<size_t>(i)] >> loaded.count[static_cast<size_t>(i)])) {
+            throw TableFormatException("Checkpoint is truncated: " + path);
+        }
+    }
+    values = loaded;
+    episodesDone = episodes;
+    epochsDone = epochs;
+}
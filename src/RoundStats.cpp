@@ -0,0 +1,139 @@
+#include "RoundStats.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+/*
+ * ROUNDSTATS IMPLEMENTATION
+ * -------------------------
+ */
+
+RoundStats::RoundStats()
+    : rounds(0), mean(0.0), m2(0.0),
+      wins(0), ties(0), losses(0), playerBusts(0), dealerBusts(0) {
+    for (int i = 0; i < HISTOGRAM_SIZE; i++) {
+        dealerHistogram[i] = 0;
+    }
+}
+
+void RoundStats::add(const RoundRecord& round) {
+    // Welford update of mean and M2
+    rounds++;
+    double x = round.net;
+    double delta = x - mean;
+    mean += delta / static_cast<double>(rounds);
+    m2 += delta * (x - mean);
+
+    if (round.net > 0) {
+        wins++;
+    } else if (round.net < 0) {
+        losses++;
+    } else {
+        ties++;
+    }
+    if (round.playerBust) {
+        playerBusts++;
+    }
+    if (round.dealerBust) {
+        dealerBusts++;
+    }
+
+    // Only count the dealer's final total when the dealer actually played
+    if (!round.playerBust) {
+        int bucket = round.dealerScore > 21 ? BUST_BUCKET : round.dealerScore;
+        dealerHistogram[bucket]++;
+    }
+}
+
+void RoundStats::merge(const RoundStats& other) {
+    if (other.rounds == 0) {
+        return;
+    }
+    if (rounds == 0) {
+        *this = other;
+        return;
+    }
+
+    // Chan et al. pairwise combination of two Welford accumulators
+    double total = static_cast<double>(rounds + other.rounds);
+    double delta = other.mean - mean;
+    mean += delta * static_cast<double>(other.rounds) / total;
+    m2 += other.m2 + delta * delta * static_cast<double>(rounds) * static_cast<double>(other.rounds) / total;
+    rounds += other.rounds;
+
+    wins += other.wins;
+    ties += other.ties;
+    losses += other.losses;
+    playerBusts += other.playerBusts;
+    dealerBusts += other.dealerBusts;
+    for (int i = 0; i < HISTOGRAM_SIZE; i++) {
+        dealerHistogram[i] += other.dealerHistogram[i];
+    }
+}
+
+namespace {
+double rate(long long count, long long rounds) {
+    return rounds > 0 ? static_cast<double>(count) / rounds : 0.0;
+}
+}
+
+double RoundStats::winRate() const { return rate(wins, rounds); }
+double RoundStats::tieRate() const { return rate(ties, rounds); }
+double RoundStats::lossRate() const { return rate(losses, rounds); }
+double RoundStats::playerBustRate() const { return rate(playerBusts, rounds); }
+double RoundStats::dealerBustRate() const { return rate(dealerBusts, rounds); }
+
+double RoundStats::variance() const {
+    return rounds > 1 ? m2 / static_cast<double>(rounds - 1) : 0.0;
+}
+
+double RoundStats::standardError() const {
+    return rounds > 1 ? std::sqrt(variance() / static_cast<double>(rounds)) : 0.0;
+}
+
+double RoundStats::confidenceHalfWidth(double z) const {
+    return z * standardError();
+}
+
+std::string RoundStats::toString() const {
+    std::ostringstream out;
+    char number[40];
+    out << rounds;
+    std::snprintf(number, sizeof(number), " %a", mean);
+    out << number;
+    std::snprintf(number, sizeof(number), " %a", m2);
+    out << number;
+    out << " " << wins << " " << ties << " " << losses << " " << playerBusts << " " << dealerBusts;
+    for (int i = 0; i < HISTOGRAM_SIZE; i++) {
+        out << " " << dealerHistogram[i];
+    }
+    return out.str();
+}
+
+bool RoundStats::fromString(const std::string& text, RoundStats& stats) {
+    std::istringstream in(text);
+    std::string meanText, m2Text;
+    RoundStats loaded;
+    if (!(in >> loaded.rounds >> meanText >> m2Text >> loaded.wins >> loaded.ties >> loaded.losses
+             >> loaded.playerBusts >> loaded.dealerBusts)) {
+        return false;
+    }
+    for (int i = 0; i < HISTOGRAM_SIZE; i++) {
+        if (!(in >> loaded.dealerHistogram[i])) {
+            return false;
+        }
+    }
+    // strtod reads the hexadecimal form exactly (operator>> does not)
+    char* end = nullptr;
+    loaded.mean = std::strtod(meanText.c_str(), &end);
+    if (end == meanText.c_str()) {
+        return false;
+    }
+    loaded.m2 = std::strtod(m2Text.c_str(), &end);
+    if (end == m2Text.c_str()) {
+        return false;
+    }
+    stats = loaded;
+    return true;
+}
@@ -0,0 +1,390 @@
+#include "RuleTable.h"
+#include "GameException.h"
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+/*
+ * RULETABLE IMPLEMENTATION
+ * ------------------------
+ * compile() parses every rule into ranges (hands, totals, counts), then
+ * paints the table first rule first: a cell keeps the first decision it
+ * gets. Everything is checked before a table is handed out, so a bad file
+ * fails at startup, never in the middle of a round.
+ */
+
+namespace {
+
+const int MAX_TOTAL = 21;
+const int MIN_HARD = 2;
+const int HARD = 1;  // Hand mask bits
+const int SOFT = 2;
+
+struct Rule {
+    int hands = HARD | SOFT;
+    int lowTotal = INT_MIN;
+    int highTotal = INT_MAX;
+    int lowCount = INT_MIN;
+    int highCount = INT_MAX;
+    bool hit = false;
+};
+
+std::string trim(const std::string& text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(start, end - start + 1);
+}
+
+std::string lower(std::string text) {
+    for (char& c : text) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return text;
+}
+
+// Reads one condition, left to right
+class Cursor {
+public:
+    explicit Cursor(const std::string& condition) : text(condition), at(0) {}
+
+    void skipSpace() {
+        while (at < text.size() && std::isspace(static_cast<unsigned char>(text[at]))) {
+            at++;
+        }
+    }
+
+    bool done() {
+        skipSpace();
+        return at >= text.size();
+    }
+
+    std::string word() {
+        skipSpace();
+        size_t start = at;
+        while (at < text.size() && std::isalpha(static_cast<unsigned char>(text[at]))) {
+            at++;
+        }
+        return lower(text.substr(start, at - start));
+    }
+
+    bool accept(const char* token) {
+        skipSpace();
+        size_t length = std::strlen(token);
+        if (text.compare(at, length, token) == 0) {
+            at += length;
+            return true;
+        }
+        return false;
+    }
+
+    // An integer with an optional sign: 17, +2, -3
+    int number() {
+        skipSpace();
+        size_t start = at;
+        if (at < text.size() && (text[at] == '+' || text[at] == '-')) {
+            at++;
+        }
+        size_t digits = at;
+        while (at < text.size() && std::isdigit(static_cast<unsigned char>(text[at]))) {
+            at++;
+        }
+        if (at == digits || at - digits > 4) {
+            throw RuleFormatException("expected a number at '" + text.substr(start) + "'");
+        }
+        return std::atoi(text.substr(start, at - start).c_str());
+    }
+
+    // N, =N, >=N, <=N, >N, <N, N-M or N..M, each number inside [low, high]
+    void range(const char* what, int low, int high, int& from, int& to) {
+        int value = 0;
+        if (accept(">=")) {
+            value = checked(what, low, high);
+            from = value;
+            to = INT_MAX;
+        } else if (accept("<=")) {
+            value = checked(what, low, high);
+            from = INT_MIN;
+            to = value;
+        } else if (accept(">")) {
+            value = checked(what, low, high);
+            from = value + 1;
+            to = INT_MAX;
+        } else if (accept("<")) {
+            value = checked(what, low, high);
+            from = INT_MIN;
+            to = value - 1;
+        } else {
+            accept("=");
+            from = checked(what, low, high);
+            to = from;
+            if (accept("..") || accept("-")) {
+                to = checked(what, low, high);
+                if (to < from) {
+                    throw RuleFormatException(std::string(what) + " range is backwards");
+                }
+            }
+        }
+        if (!done()) {
+            throw RuleFormatException("unexpected '" + text.substr(at) + "'");
+        }
+    }
+
+private:
+    std::string text;
+    size_t at;
+
+    int checked(const char* what, int low, int high) {
+        int value = number();
+        if (value < low || value > high) {
+            std::ostringstream message;
+            message << what << " " << value << " is out of range (" << low << " to " << high << ")";
+            throw RuleFormatException(message.str());
+        }
+        return value;
+    }
+};
+
+void parseCondition(const std::string& condition, Rule& rule, bool& handGiven, bool& countGiven) {
+    Cursor cursor(condition);
+    std::string name = cursor.word();
+    if (name == "soft" || name == "hard" || name == "any") {
+        if (handGiven) {
+            throw RuleFormatException("the hand is given twice");
+        }
+        handGiven = true;
+        rule.hands = name == "soft" ? SOFT : (name == "hard" ? HARD : HARD | SOFT);
+        if (!cursor.done()) {
+            int low = name == "soft" ? RuleTable::MIN_SOFT : MIN_HARD;
+            cursor.range((name + " total").c_str(), low, MAX_TOTAL, rule.lowTotal, rule.highTotal);
+        }
+    } else if (name == "count") {
+        if (countGiven) {
+            throw RuleFormatException("the count is given twice");
+        }
+        countGiven = true;
+        if (cursor.done()) {
+            throw RuleFormatException("count needs a value, e.g. count >= +2");
+        }
+        cursor.range("count", -RuleTable::COUNT_LIMIT, RuleTable::COUNT_LIMIT, rule.lowCount, rule.highCount);
+    } else {
+        throw RuleFormatException("unknown condition '" + trim(condition) + "' (use soft, hard, any or count)");
+    }
+}
+
+Rule parseRule(const std::string& text) {
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) {
+        throw RuleFormatException("missing ':' before the action");
+    }
+    Rule rule;
+    std::string action = lower(trim(text.substr(colon + 1)));
+    if (action == "hit") {
+        rule.hit = true;
+    } else if (action != "stand") {
+        throw RuleFormatException("unknown action '" + action + "' (use hit or stand)");
+    }
+
+    bool handGiven = false;
+    bool countGiven = false;
+    std::stringstream conditions(text.substr(0, colon));
+    std::string condition;
+    while (std::getline(conditions, condition, ',')) {
+        if (trim(condition).empty()) {
+            throw RuleFormatException("empty condition");
+        }
+        parseCondition(condition, rule, handGiven, countGiven);
+    }
+    if (!handGiven && !countGiven) {
+        throw RuleFormatException("no conditions (use 'any: ...' for a catch-all)");
+    }
+    return rule;
+}
+
+// The rules one by one: comments removed, split at ';' and new lines
+std::vector<std::string> splitRules(const std::string& text) {
+    std::vector<std::string> rules;
+    std::string current;
+    bool comment = false;
+    for (char c : text) {
+        if (c == '\n' || (c == ';' && !comment)) {
+            if (!trim(current).empty()) {
+                rules.push_back(trim(current));
+            }
+            current.clear();
+            comment = false;
+        } else if (c == '#') {
+            comment = true;
+        } else if (!comment) {
+            current += c;
+        }
+    }
+    if (!trim(current).empty()) {
+        rules.push_back(trim(current));
+    }
+    return rules;
+}
+
+int lowestTotal(int soft) {
+    return soft ? RuleTable::MIN_SOFT : MIN_HARD;
+}
+
+std::string handName(int soft, int total) {
+    return std::string(soft ? "soft " : "hard ") + std::to_string(total);
+}
+
+std::string countName(int count) {
+    return (count > 0 ? "+" : "") + std::to_string(count);
+}
+
+} // namespace
+
+RuleTable::RuleTable() {
+    std::memset(draw, 0, sizeof(draw));  // Unreachable cells and totals above 21 stand
+}
+
+RuleTable RuleTable::compile(const std::string& text) {
+    std::vector<std::string> lines = splitRules(text);
+    if (lines.empty()) {
+        throw RuleFormatException("No rules given");
+    }
+
+    RuleTable table;
+    bool decided[COUNTS][2][TOTALS] = {};
+    for (size_t r = 0; r < lines.size(); r++) {
+        std::string where = "Rule " + std::to_string(r + 1) + " (\"" + lines[r] + "\"): ";
+        Rule rule;
+        try {
+            rule = parseRule(lines[r]);
+        }
+        catch (const RuleFormatException& e) {
+            throw RuleFormatException(where + e.what());
+        }
+
+        int cells = 0;
+        for (int count = -COUNT_LIMIT; count <= COUNT_LIMIT; count++) {
+            if (count < rule.lowCount || count > rule.highCount) {
+                continue;
+            }
+            for (int soft = 0; soft < 2; soft++) {
+                if (!(rule.hands & (soft ? SOFT : HARD))) {
+                    continue;
+                }
+                for (int total = lowestTotal(soft); total <= MAX_TOTAL; total++) {
+                    if (total < rule.lowTotal || total > rule.highTotal) {
+                        continue;
+                    }
+                    bool& done = decided[count + COUNT_LIMIT][soft][total];
+                    if (!done) {
+                        done = true;
+                        table.draw[count + COUNT_LIMIT][soft][total] = rule.hit ? 1 : 0;
+                        cells++;
+                    }
+                }
+            }
+        }
+        if (cells == 0) {
+            throw RuleFormatException(where + "never applies (it matches no hand, or earlier rules decide all of them)");
+        }
+    }
+
+    // Every hand the dealer can hold must have an answer at every count
+    for (int count = -COUNT_LIMIT; count <= COUNT_LIMIT; count++) {
+        for (int soft = 0; soft < 2; soft++) {
+            for (int total = lowestTotal(soft); total <= MAX_TOTAL; total++) {
+                if (!decided[count + COUNT_LIMIT][soft][total]) {
+                    throw RuleFormatException("No rule decides " + handName(soft, total) + " at count " +
+                                              countName(count) + " (add a catch-all such as 'any: stand')");
+                }
+            }
+        }
+    }
+    return table;
+}
+
+RuleTable RuleTable::loadFile(const std::string& path) {
+    std::ifstream file(path.c_str());
+    if (!file) {
+        throw RuleFormatException("Cannot open rule file: " + path);
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    try {
+        return compile(text.str());
+    }
+    catch (const RuleFormatException& e) {
+        throw RuleFormatException(path + ": " + e.what());
+    }
+}
+
+int RuleTable::nearestThreshold() const {
+    int threshold = MAX_TOTAL + 1;
+    while (threshold > MIN_HARD && !draw[COUNT_LIMIT][0][threshold - 1]) {
+        threshold--;
+    }
+    return threshold;
+}
+
+std::string RuleTable::describe() const {
+    std::ostringstream out;
+    out << "          count " << countName(-COUNT_LIMIT) << " .. " << countName(COUNT_LIMIT)
+        << " (H = hit, S = stand, | = count 0)" << std::endl;
+    for (int soft = 0; soft < 2; soft++) {
+        for (int total = lowestTotal(soft); total <= MAX_TOTAL; total++) {
+            std::string name = handName(soft, total);
+            out << name << std::string(10 - name.size(), ' ');
+            for (int count = -COUNT_LIMIT; count <= COUNT_LIMIT; count++) {
+                out << (count == 0 ? "|" : "") << (draw[count + COUNT_LIMIT][soft][total] ? 'H' : 'S')
+                    << (count == 0 ? "|" : "");
+            }
+            out << std::endl;
+        }
+    }
+    return out.str();
+}
+
+/*
+ * RULESTRATEGY / RULEPOLICY
+ */
+
+RuleStrategy::RuleStrategy(std::shared_ptr<const RuleTable> table)
+    : rules(std::move(table)) {
+}
+
+bool RuleStrategy::shouldDraw(int score) {
+    return rules->shouldDraw(score, false, 0);
+}
+
+bool RuleStrategy::shouldDrawHand(int score, bool soft, int runningCount) {
+    return rules->shouldDraw(score, soft, runningCount);
+}
+
+int RuleStrategy::getThreshold() const {
+    return rules->nearestThreshold();
+}
+
+RulePolicy::RulePolicy(const RuleTable& table, int shoeSize)
+    : rules(table),
+      full(ShoeState::standard(shoeSize)) {
+}
+
+uint64_t RulePolicy::identity() const {
+    uint64_t hash = hashBytes(hashName("rules"), rules.cells(), RuleTable::CELLS);
+    int shoeSize = full.getSize();
+    return hashBytes(hash, &shoeSize, sizeof(shoeSize));
+}
+
+PlayerAction RulePolicy::decide(const HandState& hand, int, const ShoeState& shoe) const {
+    // Running count of the cards already gone from a full shoe
+    int running = 0;
+    for (int rank = 1; rank <= ShoeState::RANKS; rank++) {
+        running += RuleTable::hiLoTag(rank == 1 ? 11 : (rank > 10 ? 10 : rank)) * (full.getCount(rank) - shoe.getCount(rank));
+    }
+    return rules.shouldDraw(hand.getScore(), hand.isSoft(), running) ? PlayerAction::Hit : PlayerAction::Stand;
+}
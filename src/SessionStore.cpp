@@ -0,0 +1,131 @@
+#include "SessionStore.h"
+#include "CheckpointWriter.h"  // For writeAtomically
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+/*
+ * SESSIONSTORE IMPLEMENTATION
+ * ---------------------------
+ */
+
+SessionStore::SessionStore(const std::string& dir, size_t maxTables)
+    : directory(dir.empty() ? "." : dir),
+      maxResident(maxTables > 0 ? maxTables : 1),
+      evictions(0),
+      pageIns(0),
+      bytesWritten(0),
+      failures(0) {
+}
+
+SessionStore::~SessionStore() {
+    size_t failed = evictAll();
+    if (failed > 0) {
+        // Nobody is left to hand the tables to: say which data is gone
+        std::cerr << "SessionStore: " << failed << " tables could not be saved to " << directory << std::endl;
+    }
+}
+
+std::string SessionStore::pathOf(uint64_t table) const {
+    return directory + "/table_" + std::to_string(table) + ".session";
+}
+
+Game& SessionStore::open(uint64_t table, const GameConfig& config) {
+    close(table);
+    return admit(table, std::unique_ptr<Game>(new Game(config)));
+}
+
+Game& SessionStore::get(uint64_t table) {
+    auto found = resident.find(table);
+    if (found != resident.end()) {
+        // Already in memory: just move it to the front
+        recent.splice(recent.begin(), recent, found->second.position);
+        return *found->second.game;
+    }
+
+    // Page in: read the bytes back and rebuild the Game around them. A file
+    // this store never wrote was left by an earlier store and is adopted
+    const std::string path = pathOf(table);
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        if (evicted.count(table) == 0) {
+            throw std::out_of_range("Unknown table " + std::to_string(table));
+        }
+        throw TableFormatException("Cannot open saved session: " + path);
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    file.close();
+    std::unique_ptr<Game> game = Game::loadSession(contents.str());
+
+    evicted.erase(table);
+    std::remove(path.c_str());
+    pageIns++;
+    return admit(table, std::move(game));
+}
+
+bool SessionStore::contains(uint64_t table) const {
+    if (resident.count(table) > 0 || evicted.count(table) > 0) {
+        return true;
+    }
+    std::ifstream file(pathOf(table).c_str(), std::ios::binary);
+    return static_cast<bool>(file);  // Saved by an earlier store
+}
+
+void SessionStore::close(uint64_t table) {
+    auto found = resident.find(table);
+    if (found != resident.end()) {
+        recent.erase(found->second.position);
+        resident.erase(found);
+    }
+    evicted.erase(table);
+    std::remove(pathOf(table).c_str());  // Also one an earlier store left behind
+}
+
+size_t SessionStore::evictAll() {
+    // Every table gets its try; one that cannot be written (counted in
+    // 'failures' by evict) does not stop the others from being saved
+    std::vector<uint64_t> oldestFirst(recent.rbegin(), recent.rend());
+    size_t failed = 0;
+    for (uint64_t table : oldestFirst) {
+        failed += evict(table) ? 0 : 1;
+    }
+    return failed;
+}
+
+Game& SessionStore::admit(uint64_t table, std::unique_ptr<Game> game) {
+    recent.push_front(table);
+    Entry& entry = resident[table];
+    entry.game = std::move(game);
+    entry.position = recent.begin();
+    shrink(table);
+    return *entry.game;
+}
+
+bool SessionStore::evict(uint64_t table) {
+    auto found = resident.find(table);
+    std::string bytes;
+    found->second.game->saveSession(bytes);
+    if (!CheckpointWriter::writeAtomically(pathOf(table), bytes)) {
+        failures++;
+        return false;  // Stays in memory
+    }
+    bytesWritten += static_cast<long long>(bytes.size());
+    evictions++;
+    recent.erase(found->second.position);
+    resident.erase(found);
+    evicted.insert(table);
+    return true;
+}
+
+void SessionStore::shrink(uint64_t keep) {
+    // Oldest first; the table just used is never the one to go
+    while (resident.size() > maxResident && recent.back() != keep) {
+        if (!evict(recent.back())) {
+            break;
+        }
+    }
+}
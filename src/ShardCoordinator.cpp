@@ -0,0 +1,343 @@
+#include "ShardCoordinator.h"
+#include "CheckpointWriter.h"  // For writeAtomically
+#include "GameException.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/*
+ * SHARDCOORDINATOR IMPLEMENTATION
+ * -------------------------------
+ */
+
+namespace {
+
+// Fingerprint of the worker command line, so shard files from other settings are not reused
+uint64_t commandHash(const std::vector<std::string>& command) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 1; i < command.size(); i++) {  // argv[0] may differ between runs
+        for (char c : command[i]) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+        }
+        hash = (hash ^ 0xFF) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// "block <index> <stats>" -> index and stats
+bool parseBlockLine(const std::string& line, long long& index, RoundStats& stats) {
+    std::istringstream in(line);
+    std::string word;
+    if (!(in >> word >> index) || word != "block") {
+        return false;
+    }
+    std::string rest;
+    std::getline(in, rest);
+    return RoundStats::fromString(rest, stats);
+}
+
+} // namespace
+
+ShardCoordinator::ShardCoordinator(const GameConfig& gameConfig, const std::vector<std::string>& command,
+                                   const CoordinatorOptions& coordinatorOptions)
+    : config(gameConfig), workerCommand(command), options(coordinatorOptions), restarts(0), shardsRun(0) {
+    options.processes = std::max(1, options.processes);
+    options.blocksPerShard = std::max(1LL, options.blocksPerShard);
+    options.simulation.blockRounds = std::max(1LL, options.simulation.blockRounds);
+    options.simulation.blocksPerEpoch = std::max(1, options.simulation.blocksPerEpoch);
+}
+
+int ShardCoordinator::runWorker(const Simulator& simulator, const GameConfig& config, const SimulationOptions& simulation,
+                                long long firstBlock, long long blocks, std::ostream& out) {
+    const long long blockRounds = std::max(1LL, simulation.blockRounds);
+    TelemetryWorker* live = simulation.telemetry ? simulation.telemetry->worker(0) : nullptr;
+    for (long long b = firstBlock; b < firstBlock + blocks; b++) {
+        long long rounds = std::min(blockRounds, config.maxSimulationRounds - b * blockRounds);
+        if (rounds <= 0) {
+            break;
+        }
+        if (simulation.telemetry) {
+            simulation.telemetry->setQueue(firstBlock + blocks - b - 1, 1);
+        }
+        out << "block " << b << " " << simulator.runBlock(simulation.seed, b, rounds).toString() << "\n";
+        out.flush();  // Let the coordinator see progress block by block
+        TelemetryPublisher::blockDone(live, static_cast<uint64_t>(rounds));
+    }
+    if (simulation.telemetry) {
+        simulation.telemetry->finish();
+    }
+    return out ? 0 : 1;
+}
+
+bool ShardCoordinator::loadShardFile(const Shard& shard, std::vector<RoundStats>& blockStats, long long waveStart) const {
+    if (options.shardDirectory.empty()) {
+        return false;
+    }
+    std::ifstream file((options.shardDirectory + "/shard_" + std::to_string(shard.firstBlock) + ".txt").c_str());
+    if (!file) {
+        return false;
+    }
+    std::string label;
+    uint64_t hash = 0;
+    long long blocks = 0;
+    if (!(file >> label >> std::hex >> hash >> std::dec) || label != "command" || hash != commandHash(workerCommand) ||
+        !(file >> label >> blocks) || label != "blocks" || blocks != shard.blocks) {
+        return false;  // Written by a different run
+    }
+    std::string line;
+    std::getline(file, line);
+    std::vector<RoundStats> loaded(static_cast<size_t>(shard.blocks));
+    for (long long i = 0; i < shard.blocks; i++) {
+        long long index = 0;
+        if (!std::getline(file, line) || !parseBlockLine(line, index, loaded[static_cast<size_t>(i)]) ||
+            index != shard.firstBlock + i) {
+            return false;  // Incomplete file
+        }
+    }
+    for (long long i = 0; i < shard.blocks; i++) {
+        blockStats[static_cast<size_t>(shard.firstBlock + i - waveStart)] = loaded[static_cast<size_t>(i)];
+    }
+    return true;
+}
+
+void ShardCoordinator::saveShardFile(const Shard& shard, const std::vector<RoundStats>& blockStats, long long waveStart) const {
+    if (options.shardDirectory.empty()) {
+        return;
+    }
+    std::string path = options.shardDirectory + "/shard_" + std::to_string(shard.firstBlock) + ".txt";
+    std::ostringstream text;
+    text << "command " << std::hex << commandHash(workerCommand) << std::dec << "\n";
+    text << "blocks " << shard.blocks << "\n";
+    for (long long i = 0; i < shard.blocks; i++) {
+        text << "block " << (shard.firstBlock + i) << " "
+             << blockStats[static_cast<size_t>(shard.firstBlock + i - waveStart)].toString() << "\n";
+    }
+    // Checked write, temporary file removed on failure: a short write never
+    // becomes a shard file. Shard files are a convenience - the run goes on
+    // without them
+    CheckpointWriter::writeAtomically(path, text.str());
+}
+
+#if defined(_WIN32)
+
+void ShardCoordinator::runShards(std::vector<Shard>, std::vector<RoundStats>&, long long) {
+    throw ShardFailedException("Worker processes need a POSIX system (fork/exec/pipes)");
+}
+
+#else
+
+void ShardCoordinator::runShards(std::vector<Shard> shards, std::vector<RoundStats>& blockStats, long long waveStart) {
+    struct Running {
+        pid_t pid;
+        int fd;
+        Shard shard;
+        std::string pending;     // Partial line read so far
+        long long received;      // Blocks reported
+        int slot;                // Telemetry slot of this process
+    };
+
+    std::deque<Shard> queue(shards.begin(), shards.end());
+    std::vector<Running> running;
+
+    // Telemetry: one worker slot per process that can run at once
+    TelemetryPublisher* telemetry = options.simulation.telemetry;
+    std::vector<bool> slotUsed(static_cast<size_t>(options.processes), false);
+    auto publishQueue = [&]() {
+        if (telemetry) {
+            telemetry->setQueue(static_cast<long long>(queue.size()), static_cast<long long>(running.size()));
+        }
+    };
+
+    auto start = [&](const Shard& shard) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            throw ShardFailedException("Cannot create a pipe for a worker");
+        }
+        std::vector<std::string> args = workerCommand;
+        args.push_back("--first-block");
+        args.push_back(std::to_string(shard.firstBlock));
+        args.push_back("--blocks");
+        args.push_back(std::to_string(shard.blocks));
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            throw ShardFailedException("Cannot start a worker process");
+        }
+        if (pid == 0) {
+            // Child: stdout goes into the pipe, then become the worker
+            dup2(fds[1], STDOUT_FILENO);
+            close(fds[0]);
+            close(fds[1]);
+            std::vector<char*> argv;
+            for (std::string& arg : args) {
+                argv.push_back(&arg[0]);
+            }
+            argv.push_back(nullptr);
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+        close(fds[1]);
+        int slot = static_cast<int>(std::find(slotUsed.begin(), slotUsed.end(), false) - slotUsed.begin());
+        slotUsed[static_cast<size_t>(slot)] = true;
+        Running child = {pid, fds[0], shard, std::string(), 0, slot};
+        running.push_back(child);
+    };
+
+    auto stopAll = [&]() {
+        for (Running& child : running) {
+            kill(child.pid, SIGKILL);
+            close(child.fd);
+            waitpid(child.pid, nullptr, 0);
+        }
+        running.clear();
+    };
+
+    while (!queue.empty() || !running.empty()) {
+        while (static_cast<int>(running.size()) < options.processes && !queue.empty()) {
+            start(queue.front());
+            queue.pop_front();
+        }
+        publishQueue();
+
+        std::vector<pollfd> watch(running.size());
+        for (size_t i = 0; i < running.size(); i++) {
+            watch[i].fd = running[i].fd;
+            watch[i].events = POLLIN;
+            watch[i].revents = 0;
+        }
+        if (poll(watch.data(), watch.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            stopAll();
+            throw ShardFailedException("poll() failed while waiting for workers");
+        }
+
+        for (size_t i = running.size(); i-- > 0;) {
+            if (watch[i].revents == 0) {
+                continue;
+            }
+            Running& child = running[i];
+            char chunk[4096];
+            ssize_t got = read(child.fd, chunk, sizeof(chunk));
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got > 0) {
+                child.pending.append(chunk, static_cast<size_t>(got));
+                size_t newline;
+                while ((newline = child.pending.find('\n')) != std::string::npos) {
+                    std::string line = child.pending.substr(0, newline);
+                    child.pending.erase(0, newline + 1);
+                    long long index = 0;
+                    RoundStats stats;
+                    if (parseBlockLine(line, index, stats) && index >= child.shard.firstBlock &&
+                        index < child.shard.firstBlock + child.shard.blocks) {
+                        blockStats[static_cast<size_t>(index - waveStart)] = stats;
+                        child.received++;
+                        if (telemetry) {
+                            TelemetryPublisher::blockDone(telemetry->worker(child.slot),
+                                                          static_cast<uint64_t>(stats.getRounds()));
+                        }
+                    }
+                }
+                continue;
+            }
+
+            // End of output: the worker has finished (or died)
+            close(child.fd);
+            int status = 0;
+            waitpid(child.pid, &status, 0);
+            bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0 && child.received == child.shard.blocks;
+            Shard shard = child.shard;
+            slotUsed[static_cast<size_t>(child.slot)] = false;
+            running.erase(running.begin() + static_cast<long>(i));
+
+            if (ok) {
+                shardsRun++;
+                saveShardFile(shard, blockStats, waveStart);
+            } else if (shard.attempts < options.maxRetries) {
+                shard.attempts++;
+                restarts++;
+                queue.push_back(shard);  // Blocks are deterministic, so a rerun gives the same numbers
+            } else {
+                stopAll();
+                throw ShardFailedException("Shard starting at block " + std::to_string(shard.firstBlock) +
+                                           " failed " + std::to_string(shard.attempts + 1) + " times");
+            }
+        }
+    }
+}
+
+#endif
+
+SimulationResult ShardCoordinator::run() {
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    SimulationResult result;
+
+    const long long blockRounds = options.simulation.blockRounds;
+    const long long totalBlocks = (config.maxSimulationRounds + blockRounds - 1) / blockRounds;
+    const long long epochBlocks = options.simulation.blocksPerEpoch;
+
+    // A wave keeps every process busy and ends on an epoch boundary
+    long long waveBlocks = options.processes * options.blocksPerShard;
+    waveBlocks = ((waveBlocks + epochBlocks - 1) / epochBlocks) * epochBlocks;
+
+    TelemetryPublisher* telemetry = options.simulation.telemetry;
+    if (telemetry) {
+        telemetry->setLimits(config.maxSimulationRounds, config.targetEdgeCIWidth);
+    }
+
+    long long nextBlock = 0;
+    while (nextBlock < totalBlocks && !result.reachedTarget) {
+        long long waveEnd = std::min(totalBlocks, nextBlock + waveBlocks);
+        std::vector<RoundStats> blockStats(static_cast<size_t>(waveEnd - nextBlock));
+
+        std::vector<Shard> shards;
+        for (long long first = nextBlock; first < waveEnd; first += options.blocksPerShard) {
+            Shard shard = {first, std::min(options.blocksPerShard, waveEnd - first), 0};
+            if (!loadShardFile(shard, blockStats, nextBlock)) {
+                shards.push_back(shard);
+            }
+        }
+        runShards(shards, blockStats, nextBlock);
+
+        // Merge block by block and check at the same points as Simulator::run
+        for (long long b = nextBlock; b < waveEnd; b++) {
+            result.stats.merge(blockStats[static_cast<size_t>(b - nextBlock)]);
+            bool epochEnd = (b + 1) % epochBlocks == 0 || b + 1 == totalBlocks;
+            if (epochEnd && config.targetEdgeCIWidth > 0.0 &&
+                result.stats.getRounds() > 1 &&
+                result.stats.confidenceWidth() <= config.targetEdgeCIWidth) {
+                result.reachedTarget = true;
+                break;
+            }
+        }
+        nextBlock = waveEnd;
+        if (telemetry) {
+            telemetry->setEstimate(result.stats.getRounds(), result.stats.edge(), result.stats.confidenceWidth());
+        }
+    }
+    if (telemetry) {
+        telemetry->finish();
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
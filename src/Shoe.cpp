@@ -0,0 +1,25 @@
+#include "Shoe.h"
+#include "Deck.h"
+#include "CompositionDeck.h"
+#include <cstdlib>
+
+/*
+ * SHOEFACTORY IMPLEMENTATION
+ * --------------------------
+ * The only place that decides which Shoe backend a game uses.
+ */
+
+uint64_t ShoeFactory::seedFromRand() {
+    return (static_cast<uint64_t>(rand()) << 32) ^ static_cast<uint64_t>(rand());
+}
+
+std::unique_ptr<Shoe> ShoeFactory::createShoe(const GameConfig& config) {
+    return createShoe(config, seedFromRand());
+}
+
+std::unique_ptr<Shoe> ShoeFactory::createShoe(const GameConfig& config, uint64_t seed) {
+    if (config.useCompositionDeck) {
+        return std::make_unique<CompositionDeck>(config.deckSize, seed);
+    }
+    return std::make_unique<Deck>(config.deckSize, seed);
+}
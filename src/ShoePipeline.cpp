@@ -0,0 +1,200 @@
+#include "ShoePipeline.h"
+#include "Rng.h"
+#include <algorithm>
+
+/*
+ * SHOEPIPELINE IMPLEMENTATION
+ * ---------------------------
+ */
+
+/*
+ * One pipeline's shoes. The pipeline and the producer both hold it, so a
+ * pipeline can be destroyed while its next shoe is being built: it only
+ * sets 'stopping', and the producer lets go of the queue afterwards.
+ */
+struct ShoeProducer::Queue {
+    GameConfig config;
+    Rng seeds;                                   // Seed of shoe k = k-th number
+    size_t capacity;
+
+    std::mutex lock;
+    std::condition_variable changed;
+    std::deque<std::unique_ptr<Shoe> > ready;    // Oldest seed first
+    std::vector<std::unique_ptr<Shoe> > spare;   // Handed back, waiting to be refilled
+    bool building = false;                       // The producer is filling the next shoe
+    bool scheduled = false;                      // In the producer's work list (or being served)
+    bool stopping = false;                       // The pipeline is gone
+    bool takerWaiting = false;
+    long long taken = 0;
+    long long misses = 0;
+
+    Queue(const GameConfig& gameConfig, uint64_t seed, size_t readyShoes)
+        : config(gameConfig), seeds(seed), capacity(readyShoes) {}
+
+    bool buildOne();
+};
+
+/*
+ * Builds one shoe on the producer thread. Returns true while the queue
+ * still wants more (the producer then puts it back at the end of its
+ * list, so every table gets a turn); on false it is no longer scheduled.
+ */
+bool ShoeProducer::Queue::buildOne() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (spare.size() > capacity && !stopping) {
+        // More shoes than the pool needs (after misses): destroy them here
+        std::unique_ptr<Shoe> surplus = std::move(spare.back());
+        spare.pop_back();
+        guard.unlock();
+        surplus.reset();
+        guard.lock();
+    }
+    if (stopping || ready.size() >= capacity) {
+        scheduled = false;
+        return false;
+    }
+
+    // Claim the next seed under the lock, build outside it
+    std::unique_ptr<Shoe> shoe;
+    if (!spare.empty()) {
+        shoe = std::move(spare.back());
+        spare.pop_back();
+    }
+    uint64_t seed = seeds.next();
+    building = true;
+    guard.unlock();
+
+    if (shoe) {
+        shoe->refill(seed);
+    } else {
+        shoe = ShoeFactory::createShoe(config, seed);
+    }
+
+    guard.lock();
+    ready.push_back(std::move(shoe));
+    building = false;
+    if (takerWaiting) {
+        changed.notify_all();
+    }
+    bool more = !stopping && ready.size() < capacity;
+    scheduled = more;
+    return more;
+}
+
+ShoeProducer::ShoeProducer(int threads) : stopping(false) {
+    for (int t = 0; t < std::max(1, threads); t++) {
+        workers.emplace_back(&ShoeProducer::run, this);
+    }
+}
+
+ShoeProducer::~ShoeProducer() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ShoeProducer& ShoeProducer::shared() {
+    static ShoeProducer producer;
+    return producer;
+}
+
+void ShoeProducer::schedule(std::shared_ptr<Queue> queue) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (stopping) {
+            return;  // Shutting down: take() builds its own shoes from now on
+        }
+        work.push_back(std::move(queue));
+    }
+    wake.notify_one();
+}
+
+void ShoeProducer::run() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        wake.wait(guard, [this]() { return stopping || !work.empty(); });
+        if (stopping) {
+            return;
+        }
+        std::shared_ptr<Queue> queue = std::move(work.front());
+        work.pop_front();
+        guard.unlock();
+
+        bool more = queue->buildOne();
+
+        guard.lock();
+        if (more) {
+            work.push_back(std::move(queue));
+        } else {
+            // The last reference to a finished pipeline's queue may be this
+            // one; its shoes are destroyed here, not on the table's thread
+            guard.unlock();
+            queue.reset();
+            guard.lock();
+        }
+    }
+}
+
+ShoePipeline::ShoePipeline(const GameConfig& gameConfig, uint64_t seed, int readyShoes, ShoeProducer& shoeProducer)
+    : producer(shoeProducer),
+      queue(std::make_shared<ShoeProducer::Queue>(gameConfig, seed, static_cast<size_t>(std::max(1, readyShoes)))) {
+    queue->scheduled = true;
+    producer.schedule(queue);  // Starts building shoes right away
+}
+
+ShoePipeline::~ShoePipeline() {
+    std::lock_guard<std::mutex> guard(queue->lock);
+    queue->stopping = true;
+}
+
+std::unique_ptr<Shoe> ShoePipeline::take() {
+    ShoeProducer::Queue& q = *queue;
+    std::unique_lock<std::mutex> guard(q.lock);
+    q.taken++;
+    if (q.ready.empty()) {
+        q.misses++;
+        if (!q.building) {
+            // Nothing in progress: build the next shoe here, in seed order
+            uint64_t seed = q.seeds.next();
+            guard.unlock();
+            return ShoeFactory::createShoe(q.config, seed);
+        }
+        q.takerWaiting = true;
+        q.changed.wait(guard, [&q]() { return !q.ready.empty(); });
+        q.takerWaiting = false;
+    }
+    std::unique_ptr<Shoe> shoe = std::move(q.ready.front());
+    q.ready.pop_front();
+    bool refill = !q.scheduled && q.ready.size() <= q.capacity / 2;
+    if (refill) {
+        q.scheduled = true;
+    }
+    guard.unlock();
+    if (refill) {
+        producer.schedule(queue);  // Time to refill
+    }
+    return shoe;
+}
+
+void ShoePipeline::recycle(std::unique_ptr<Shoe> shoe) {
+    if (!shoe) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(queue->lock);
+    queue->spare.push_back(std::move(shoe));  // Picked up at the next refill
+}
+
+long long ShoePipeline::getTaken() const {
+    std::lock_guard<std::mutex> guard(queue->lock);
+    return queue->taken;
+}
+
+long long ShoePipeline::getMisses() const {
+    std::lock_guard<std::mutex> guard(queue->lock);
+    return queue->misses;
+}
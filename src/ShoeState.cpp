@@ -0,0 +1,20 @@
+#include "ShoeState.h"
+
+/*
+ * SHOESTATE IMPLEMENTATION
+ * ------------------------
+ * Only the non-trivial helpers live here; drawing is inline in the header
+ * because it sits on every simulation's hot path.
+ */
+
+ShoeState ShoeState::standard(int size) {
+    ShoeState shoe;
+    int base = size / RANKS;
+    int extra = size % RANKS;  // Left-over cards go to the lowest ranks
+
+    for (int i = 0; i < RANKS; i++) {
+        shoe.counts[i] = static_cast<uint32_t>(base + (i < extra ? 1 : 0));
+    }
+    shoe.remaining = static_cast<uint32_t>(size);
+    return shoe;
+}
@@ -0,0 +1,323 @@
+#include "ShuffleAudit.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+/*
+ * SHUFFLEAUDIT IMPLEMENTATION
+ * ---------------------------
+ */
+
+namespace {
+
+const int RANKS = 13;
+const int SUITS = 4;
+const int TYPES = Deck::CARD_TYPES;
+const int POSITIONS = ShuffleAudit::TRACKED_POSITIONS;
+
+// Chi-square statistic of observed counts against expected counts
+double chiSquare(const std::vector<double>& observed, const std::vector<double>& expected) {
+    double statistic = 0.0;
+    for (size_t i = 0; i < observed.size(); i++) {
+        double difference = observed[i] - expected[i];
+        statistic += difference * difference / expected[i];
+    }
+    return statistic;
+}
+
+AuditTest makeTest(const char* name, const char* description, double statistic, long long degreesOfFreedom) {
+    AuditTest test;
+    test.name = name;
+    test.description = description;
+    test.statistic = statistic;
+    test.degreesOfFreedom = degreesOfFreedom;
+    test.pValue = ShuffleAudit::chiSquarePValue(statistic, degreesOfFreedom);
+    return test;
+}
+
+// Regularised lower incomplete gamma P(a, x) by its series (x < a + 1)
+double lowerGammaSeries(double a, double x) {
+    double term = 1.0 / a;
+    double sum = term;
+    for (int n = 1; n < 100000; n++) {
+        term *= x / (a + n);
+        sum += term;
+        if (term < sum * 1e-16) {
+            break;
+        }
+    }
+    return sum * std::exp(-x + a * std::log(x) - std::lgamma(a));
+}
+
+// Regularised upper incomplete gamma Q(a, x) by its continued fraction (x >= a + 1)
+double upperGammaFraction(double a, double x) {
+    const double TINY = 1e-300;
+    double b = x + 1.0 - a;
+    double c = 1.0 / TINY;
+    double d = 1.0 / b;
+    double h = d;
+    for (int n = 1; n < 100000; n++) {
+        double an = -n * (n - a);
+        b += 2.0;
+        d = an * d + b;
+        d = std::fabs(d) < TINY ? TINY : d;
+        c = b + an / c;
+        c = std::fabs(c) < TINY ? TINY : c;
+        d = 1.0 / d;
+        double step = d * c;
+        h *= step;
+        if (std::fabs(step - 1.0) < 1e-16) {
+            break;
+        }
+    }
+    return std::exp(-x + a * std::log(x) - std::lgamma(a)) * h;
+}
+
+} // namespace
+
+/*
+ * One thread's count tables. Card type c is rank c % 13, suit c / 13.
+ */
+struct ShuffleAudit::Counts {
+    uint64_t cards[TYPES];
+    uint64_t byPosition[POSITIONS][TYPES];   // Card types at each tracked position
+    uint64_t firstAce[POSITIONS + 1];        // Position of a shoe's first ace; last = later or never
+    uint64_t pairs[RANKS][RANKS];            // Non-overlapping pairs (0,1), (2,3), ...
+    int64_t lagProducts;                     // Sum of (rank - 6)(next rank - 6)
+    uint64_t lagCount;
+    long long shoes;
+
+    Counts() {
+        std::fill(&cards[0], &cards[0] + TYPES, 0);
+        std::fill(&byPosition[0][0], &byPosition[0][0] + POSITIONS * TYPES, 0);
+        std::fill(&firstAce[0], &firstAce[0] + POSITIONS + 1, 0);
+        std::fill(&pairs[0][0], &pairs[0][0] + RANKS * RANKS, 0);
+        lagProducts = 0;
+        lagCount = 0;
+        shoes = 0;
+    }
+
+    void add(const Counts& other) {
+        for (int c = 0; c < TYPES; c++) {
+            cards[c] += other.cards[c];
+        }
+        for (int p = 0; p < POSITIONS; p++) {
+            for (int c = 0; c < TYPES; c++) {
+                byPosition[p][c] += other.byPosition[p][c];
+            }
+        }
+        for (int p = 0; p <= POSITIONS; p++) {
+            firstAce[p] += other.firstAce[p];
+        }
+        for (int a = 0; a < RANKS; a++) {
+            for (int b = 0; b < RANKS; b++) {
+                pairs[a][b] += other.pairs[a][b];
+            }
+        }
+        lagProducts += other.lagProducts;
+        lagCount += other.lagCount;
+        shoes += other.shoes;
+    }
+};
+
+double AuditResult::minPValue() const {
+    double lowest = 1.0;
+    for (const AuditTest& test : tests) {
+        lowest = std::min(lowest, test.pValue);
+    }
+    return lowest;
+}
+
+ShuffleAudit::ShuffleAudit(const AuditOptions& auditOptions) : options(auditOptions) {
+    options.shoes = std::max(1LL, options.shoes);
+    options.shoeSize = std::max(2, options.shoeSize);
+    options.threads = std::max(1, options.threads);
+}
+
+double ShuffleAudit::chiSquarePValue(double statistic, long long degreesOfFreedom) {
+    if (degreesOfFreedom <= 0) {
+        return 1.0;
+    }
+    double a = degreesOfFreedom / 2.0;
+    double x = statistic / 2.0;
+    if (x <= 0.0) {
+        return 1.0;
+    }
+    if (x < a + 1.0) {
+        return std::max(0.0, 1.0 - lowerGammaSeries(a, x));
+    }
+    return upperGammaFraction(a, x);
+}
+
+void ShuffleAudit::auditBlock(long long block, Counts& counts) const {
+    const int size = options.shoeSize;
+    const int tracked = std::min(size, POSITIONS);
+    long long first = block * BLOCK_SHOES;
+    long long shoes = std::min<long long>(BLOCK_SHOES, options.shoes - first);
+
+    Rng blockRng = Rng::forStream(options.seed, static_cast<uint64_t>(block));
+    for (long long s = 0; s < shoes; s++) {
+        // The same card sequence as Deck(size, seed)
+        Rng rng(shoeSeed(blockRng));
+        int firstAce = tracked;
+        int previous = 0;
+        for (int i = 0; i < size; i++) {
+            int type = Deck::randomCard(rng);
+            int rank = type % RANKS;
+            counts.cards[type]++;
+            if (i < tracked) {
+                counts.byPosition[i][type]++;
+                if (rank == 0 && firstAce == tracked) {
+                    firstAce = i;
+                }
+            }
+            if (i > 0) {
+                counts.lagProducts += (previous - 6) * (rank - 6);
+                if (i & 1) {
+                    counts.pairs[previous][rank]++;
+                }
+            }
+            previous = rank;
+        }
+        counts.lagCount += static_cast<uint64_t>(size - 1);
+        counts.firstAce[firstAce]++;
+    }
+    counts.shoes += shoes;
+}
+
+long long ShuffleAudit::verifyDecks() const {
+    // Build the first shoes as real Decks and compare every card
+    long long mismatches = 0;
+    long long shoes = std::min(options.verifyShoes, options.shoes);
+    Rng blockRng(0);
+    for (long long s = 0; s < shoes; s++) {
+        if (s % BLOCK_SHOES == 0) {
+            blockRng = Rng::forStream(options.seed, static_cast<uint64_t>(s / BLOCK_SHOES));
+        }
+        uint64_t seed = shoeSeed(blockRng);
+        Deck deck(options.shoeSize, seed);
+        Rng rng(seed);
+        while (!deck.isEmpty()) {
+            std::unique_ptr<Card> drawn(deck.drawCard());
+            int type = Deck::randomCard(rng);
+            std::unique_ptr<Card> expected(CardFactory::createCard(type % RANKS + 1, Deck::suitName(type / RANKS)));
+            if (drawn->getValue() != expected->getValue() || drawn->getName() != expected->getName()) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+AuditResult ShuffleAudit::run() const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    AuditResult result;
+
+    const long long blocks = (options.shoes + BLOCK_SHOES - 1) / BLOCK_SHOES;
+    std::vector<std::unique_ptr<Counts> > perThread;
+    for (int t = 0; t < options.threads; t++) {
+        perThread.push_back(std::unique_ptr<Counts>(new Counts()));
+    }
+    std::atomic<long long> claim(0);
+
+    auto worker = [&](Counts* counts) {
+        for (long long b = claim.fetch_add(1); b < blocks; b = claim.fetch_add(1)) {
+            auditBlock(b, *counts);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < options.threads; t++) {
+        threads.push_back(std::thread(worker, perThread[static_cast<size_t>(t)].get()));
+    }
+    result.mismatches = verifyDecks();
+    result.verifiedShoes = std::min(options.verifyShoes, options.shoes);
+    worker(perThread[0].get());
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    Counts& total = *perThread[0];
+    for (int t = 1; t < options.threads; t++) {
+        total.add(*perThread[static_cast<size_t>(t)]);
+    }
+    result.shoes = total.shoes;
+    result.cards = total.shoes * options.shoeSize;
+
+    const double cards = static_cast<double>(result.cards);
+    const double shoes = static_cast<double>(result.shoes);
+    const int tracked = std::min(options.shoeSize, POSITIONS);
+
+    // Overall frequencies
+    std::vector<double> observed(RANKS, 0.0);
+    for (int c = 0; c < TYPES; c++) {
+        observed[c % RANKS] += total.cards[c];
+    }
+    result.tests.push_back(makeTest("rank", "frequency of each rank",
+                                    chiSquare(observed, std::vector<double>(RANKS, cards / RANKS)), RANKS - 1));
+    observed.assign(SUITS, 0.0);
+    for (int c = 0; c < TYPES; c++) {
+        observed[c / RANKS] += total.cards[c];
+    }
+    result.tests.push_back(makeTest("suit", "frequency of each suit",
+                                    chiSquare(observed, std::vector<double>(SUITS, cards / SUITS)), SUITS - 1));
+    observed.assign(total.cards, total.cards + TYPES);
+    result.tests.push_back(makeTest("card", "frequency of each of the 52 cards",
+                                    chiSquare(observed, std::vector<double>(TYPES, cards / TYPES)), TYPES - 1));
+
+    // Position tests: each position is its own multinomial, so statistics add up
+    double rankStatistic = 0.0;
+    double suitStatistic = 0.0;
+    for (int p = 0; p < tracked; p++) {
+        std::vector<double> ranks(RANKS, 0.0);
+        std::vector<double> suits(SUITS, 0.0);
+        for (int c = 0; c < TYPES; c++) {
+            ranks[c % RANKS] += total.byPosition[p][c];
+            suits[c / RANKS] += total.byPosition[p][c];
+        }
+        rankStatistic += chiSquare(ranks, std::vector<double>(RANKS, shoes / RANKS));
+        suitStatistic += chiSquare(suits, std::vector<double>(SUITS, shoes / SUITS));
+    }
+    result.tests.push_back(makeTest("rank-by-position", "rank frequencies at each of the first positions",
+                                    rankStatistic, static_cast<long long>(tracked) * (RANKS - 1)));
+    result.tests.push_back(makeTest("suit-by-position", "suit frequencies at each of the first positions",
+                                    suitStatistic, static_cast<long long>(tracked) * (SUITS - 1)));
+    observed.assign(total.byPosition[0], total.byPosition[0] + TYPES);
+    result.tests.push_back(makeTest("first-card", "the first card of every shoe",
+                                    chiSquare(observed, std::vector<double>(TYPES, shoes / TYPES)), TYPES - 1));
+
+    // Position of the first ace: geometric with p = 1/13
+    std::vector<double> expected(static_cast<size_t>(tracked) + 1);
+    double notYet = 1.0;
+    for (int p = 0; p < tracked; p++) {
+        expected[static_cast<size_t>(p)] = shoes * notYet / RANKS;
+        notYet *= (RANKS - 1.0) / RANKS;
+    }
+    expected[static_cast<size_t>(tracked)] = shoes * notYet;
+    observed.assign(total.firstAce, total.firstAce + tracked + 1);
+    result.tests.push_back(makeTest("first-ace-position", "position of the first ace in a shoe",
+                                    chiSquare(observed, expected), tracked));
+
+    // Serial tests
+    observed.clear();
+    double pairCount = 0.0;
+    for (int a = 0; a < RANKS; a++) {
+        for (int b = 0; b < RANKS; b++) {
+            observed.push_back(static_cast<double>(total.pairs[a][b]));
+            pairCount += total.pairs[a][b];
+        }
+    }
+    result.tests.push_back(makeTest("serial-pairs", "ranks of consecutive card pairs",
+                                    chiSquare(observed, std::vector<double>(RANKS * RANKS, pairCount / (RANKS * RANKS))),
+                                    RANKS * RANKS - 1));
+    // Ranks 0-12 have mean 6 and variance 14; r * sqrt(n) is standard normal
+    double lags = static_cast<double>(total.lagCount);
+    double z = lags > 0.0 ? static_cast<double>(total.lagProducts) / (14.0 * std::sqrt(lags)) : 0.0;
+    result.tests.push_back(makeTest("serial-correlation", "lag-1 correlation of ranks (z squared)", z * z, 1));
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
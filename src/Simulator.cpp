@@ -0,0 +1,442 @@
+#include "Simulator.h"
+#include "CheckpointWriter.h"
+#include "GameException.h"
+#include "Strategy.h"
+#include "TableState.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/*
+ * SIMULATOR IMPLEMENTATION
+ * ------------------------
+ */
+
+// ============== ROUND ENGINE ==============
+RoundEngine::RoundEngine(const GameConfig& config)
+    : deckSize(config.deckSize),
+      reshuffleThreshold(config.reshuffleThreshold),
+      dealerThreshold(createDealerStrategy(config.useAggressiveDealer)->getThreshold()),
+      composition(config.useCompositionDeck),
+      ruleVariant(config.ruleVariant) {
+}
+
+ShoeState RoundEngine::freshShoe() const {
+    return ShoeState::standard(deckSize);
+}
+
+int RoundEngine::drawRank(ShoeState& shoe, Rng& rng) const {
+    if (composition) {
+        return shoe.drawRank(rng);
+    }
+    // Deck behaviour: independent random rank, only the size shrinks
+    shoe.remaining--;
+    return static_cast<int>(rng.below(ShoeState::RANKS)) + 1;
+}
+
+namespace {
+
+/*
+ * Map the policy's wish onto what the rules and the hand allow.
+ * Anything not allowed becomes a plain Hit. The Rules:: checks are
+ * compile-time constants, so disabled rules vanish from the code.
+ */
+template <typename Rules>
+PlayerAction allowedAction(PlayerAction wish, const HandState& hand, bool openingDecision) {
+    switch (wish) {
+    case PlayerAction::Stand:
+    case PlayerAction::Hit:
+        return wish;
+    case PlayerAction::Double:
+        return (Rules::doubleDown && hand.cards == 2) ? wish : PlayerAction::Hit;
+    case PlayerAction::Split:
+        return (Rules::split && openingDecision && hand.isPair()) ? wish : PlayerAction::Hit;
+    case PlayerAction::Surrender:
+        return (Rules::surrender && openingDecision) ? wish : PlayerAction::Hit;
+    }
+    return PlayerAction::Hit;
+}
+
+} // namespace
+
+RoundRecord RoundEngine::playRound(ShoeState& shoe, Rng& rng, const PlayerPolicy& policy) const {
+    switch (ruleVariant) {
+    case RuleVariant::Standard:
+        return playRoundWith<StandardRules>(shoe, rng, policy);
+    case RuleVariant::Vegas:
+        return playRoundWith<VegasRules>(shoe, rng, policy);
+    case RuleVariant::Classic:
+        break;
+    }
+    return playRoundWith<ClassicRules>(shoe, rng, policy);
+}
+
+namespace {
+
+// Cards for playRoundWith: random draws from the shoe
+struct RandomCards {
+    const RoundEngine& engine;
+    Rng& rng;
+
+    int draw(ShoeState& shoe) { return engine.drawRank(shoe, rng); }
+    void reshuffled() {}
+};
+
+// Cards for playScriptedRound: the next card of a pre-generated shoe
+struct ScriptedCards {
+    CardScript& script;
+    bool composition;
+
+    int draw(ShoeState& shoe) {
+        int rank = script.next < script.size ? script.ranks[script.next]
+                                             : static_cast<int>(script.overflow.below(ShoeState::RANKS)) + 1;
+        script.next++;
+        if (composition) {
+            shoe.removeRank(rank);
+        } else {
+            shoe.remaining--;  // Deck behaviour, as in drawRank
+        }
+        return rank;
+    }
+    void reshuffled() { script.finished = true; }
+};
+
+} // namespace
+
+template <typename Rules>
+RoundRecord RoundEngine::playRoundWith(ShoeState& shoe, Rng& rng, const PlayerPolicy& policy) const {
+    RandomCards cards = {*this, rng};
+    return playRoundFrom<Rules>(shoe, cards, policy);
+}
+
+RoundRecord RoundEngine::playScriptedRound(ShoeState& shoe, CardScript& script, const PlayerPolicy& policy) const {
+    ScriptedCards cards = {script, composition};
+    switch (ruleVariant) {
+    case RuleVariant::Standard:
+        return playRoundFrom<StandardRules>(shoe, cards, policy);
+    case RuleVariant::Vegas:
+        return playRoundFrom<VegasRules>(shoe, cards, policy);
+    case RuleVariant::Classic:
+        break;
+    }
+    return playRoundFrom<ClassicRules>(shoe, cards, policy);
+}
+
+template <typename Rules, typename Cards>
+RoundRecord RoundEngine::playRoundFrom(ShoeState& shoe, Cards& cards, const PlayerPolicy& policy) const {
+    HandState hands[2];           // A split makes a second hand
+    double stakes[2] = {1.0, 1.0};
+    int handCount = 1;
+    HandState dealer;
+    RoundRecord record;
+
+    // dealInitialCards
+    if (!shoe.isEmpty()) hands[0].addRank(cards.draw(shoe));
+    if (!shoe.isEmpty()) hands[0].addRank(cards.draw(shoe));
+    if (!shoe.isEmpty()) {
+        record.dealerUpcard = cards.draw(shoe);
+        dealer.addRank(record.dealerUpcard);
+    }
+    record.playerStart = hands[0].getScore();
+    record.playerStartSoft = hands[0].isSoft();
+
+    // playerTurn for each hand: 21 or an empty shoe ends the turn
+    for (int h = 0; h < handCount; h++) {
+        HandState& hand = hands[h];
+        if (h == 1 && !shoe.isEmpty()) {
+            hand.addRank(cards.draw(shoe));  // Second card for the split hand
+        }
+        bool splitAces = Rules::split && record.split && hand.first == 1;
+        bool opening = !record.split;  // Split/surrender only on the original two cards
+
+        while (!splitAces && hand.getScore() < 21 && !shoe.isEmpty()) {
+            PlayerAction action = allowedAction<Rules>(policy.decide(hand, record.dealerUpcard, shoe), hand, opening);
+            opening = false;
+
+            if (action == PlayerAction::Stand) {
+                break;
+            }
+            if (Rules::surrender && action == PlayerAction::Surrender) {
+                record.surrendered = true;
+                break;
+            }
+            if (Rules::split && action == PlayerAction::Split) {
+                int firstRank = hand.first;
+                int secondRank = firstRank == 1 ? 1 : hand.total - (firstRank > 10 ? 10 : firstRank);
+                hands[0] = HandState();
+                hands[0].addRank(firstRank);
+                hands[1] = HandState();
+                hands[1].addRank(secondRank);
+                handCount = 2;
+                record.split = true;
+                if (!shoe.isEmpty()) {
+                    hand.addRank(cards.draw(shoe));
+                }
+                splitAces = firstRank == 1;
+                continue;
+            }
+            hand.addRank(cards.draw(shoe));
+            if (Rules::doubleDown && action == PlayerAction::Double) {
+                stakes[h] *= 2.0;
+                record.doubled = true;
+                break;  // Exactly one card after doubling
+            }
+        }
+    }
+
+    // dealerTurn (skipped when no hand is still in play)
+    bool anyLive = false;
+    for (int h = 0; h < handCount; h++) {
+        anyLive = anyLive || !hands[h].isBust();
+    }
+    if (anyLive && !record.surrendered) {
+        while (dealerDraws<Rules>(dealer.getScore(), dealer.isSoft(), dealerThreshold) && !shoe.isEmpty()) {
+            dealer.addRank(cards.draw(shoe));
+        }
+    }
+
+    // determineWinner - settle every hand
+    record.dealerScore = dealer.getScore();
+    for (int h = 0; h < handCount; h++) {
+        bool natural = !record.split && hands[h].isNatural();
+        record.net += settleHand<Rules>(hands[h].getScore(), natural, record.dealerScore, dealer.isNatural(),
+                                        stakes[h], record.surrendered);
+    }
+
+    record.playerScore = hands[0].getScore();
+    record.playerCards = hands[0].cards;
+    record.dealerCards = dealer.cards;
+    record.playerSoft = hands[0].isSoft();
+    record.playerBust = hands[0].isBust();
+    record.dealerBust = anyLive && !record.surrendered && record.dealerScore > 21;
+
+    // resetRound
+    if (shoe.getSize() < reshuffleThreshold) {
+        shoe = freshShoe();
+        cards.reshuffled();
+    }
+    return record;
+}
+
+// Pre-built versions for the common rule sets
+template RoundRecord RoundEngine::playRoundWith<ClassicRules>(ShoeState&, Rng&, const PlayerPolicy&) const;
+template RoundRecord RoundEngine::playRoundWith<StandardRules>(ShoeState&, Rng&, const PlayerPolicy&) const;
+template RoundRecord RoundEngine::playRoundWith<VegasRules>(ShoeState&, Rng&, const PlayerPolicy&) const;
+
+// ============== SIMULATOR ==============
+Simulator::Simulator(const GameConfig& gameConfig, const PlayerPolicy& playerPolicy)
+    : config(gameConfig), policy(playerPolicy), engine(gameConfig) {
+}
+
+RoundStats Simulator::runBlock(uint64_t seed, long long blockIndex, long long rounds,
+                               std::vector<HandRecord>* history) const {
+    // Choose the rule set once per block, not once per decision
+    switch (engine.getRuleVariant()) {
+    case RuleVariant::Standard:
+        return runBlockWith<StandardRules>(seed, blockIndex, rounds, history);
+    case RuleVariant::Vegas:
+        return runBlockWith<VegasRules>(seed, blockIndex, rounds, history);
+    case RuleVariant::Classic:
+        break;
+    }
+    return runBlockWith<ClassicRules>(seed, blockIndex, rounds, history);
+}
+
+template <typename Rules>
+RoundStats Simulator::runBlockWith(uint64_t seed, long long blockIndex, long long rounds,
+                                   std::vector<HandRecord>* history) const {
+    RoundStats stats;
+    Rng rng = Rng::forStream(seed, static_cast<uint64_t>(blockIndex));
+    ShoeState shoe = engine.freshShoe();
+
+    if (history != nullptr) {
+        history->reserve(history->size() + static_cast<size_t>(rounds));
+    }
+    for (long long r = 0; r < rounds; r++) {
+        RoundRecord record = engine.playRoundWith<Rules>(shoe, rng, policy);
+        stats.add(record);
+        if (history != nullptr) {
+            history->push_back(HandRecord::fromRound(record));
+        }
+    }
+    return stats;
+}
+
+namespace {
+const char* const CHECKPOINT_HEADER = "blackjack-simulation-checkpoint";
+const int CHECKPOINT_VERSION = 3;  // 2: the key covers the policy, 3: hand log length
+}
+
+uint64_t Simulator::checkpointKey(const SimulationOptions& options) const {
+    // Everything that decides which rounds are played, and how they are played
+    const long long parts[] = {
+        static_cast<long long>(options.seed), options.blockRounds, options.blocksPerEpoch,
+        config.maxSimulationRounds, config.deckSize, config.reshuffleThreshold,
+        engine.getDealerThreshold(), config.useCompositionDeck ? 1 : 0,
+        static_cast<long long>(engine.getRuleVariant()), config.playerStandThreshold,
+        static_cast<long long>(policy.identity())};
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (long long part : parts) {
+        hash = (hash ^ static_cast<uint64_t>(part)) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+std::string Simulator::checkpointText(const SimulationOptions& options, long long nextBlock,
+                                      const SimulationResult& result, long long historyRecords) const {
+    std::ostringstream text;
+    text << CHECKPOINT_HEADER << " " << CHECKPOINT_VERSION << "\n";
+    text << "key " << std::hex << checkpointKey(options) << std::dec << "\n";
+    text << "next-block " << nextBlock << "\n";
+    text << "finished " << (result.reachedTarget ? 1 : 0) << "\n";
+    text << "history " << historyRecords << "\n";
+    text << "stats " << result.stats.toString() << "\n";
+    return text.str();
+}
+
+bool Simulator::loadCheckpoint(const SimulationOptions& options, long long& nextBlock, SimulationResult& result,
+                               long long& historyRecords) const {
+    std::ifstream file(options.checkpointPath.c_str());
+    if (!file) {
+        return false;  // Nothing saved yet - start from the beginning
+    }
+    std::string header, label, stats;
+    int version = 0;
+    uint64_t key = 0;
+    long long block = 0;
+    int finished = 0;
+    long long records = -1;
+    if (!(file >> header >> version) || header != CHECKPOINT_HEADER || version != CHECKPOINT_VERSION) {
+        throw TableFormatException("Not a simulation checkpoint (or wrong version): " + options.checkpointPath);
+    }
+    if (!(file >> label >> std::hex >> key >> std::dec) || label != "key" ||
+        !(file >> label >> block) || label != "next-block" ||
+        !(file >> label >> finished) || label != "finished" ||
+        !(file >> label >> records) || label != "history" ||
+        !(file >> label) || label != "stats" || !std::getline(file, stats) ||
+        !RoundStats::fromString(stats, result.stats)) {
+        throw TableFormatException("Checkpoint is truncated: " + options.checkpointPath);
+    }
+    if (key != checkpointKey(options)) {
+        throw TableFormatException("Checkpoint belongs to a different run: " + options.checkpointPath);
+    }
+    nextBlock = block;
+    historyRecords = records;
+    result.reachedTarget = finished != 0;
+    result.resumedRounds = result.stats.getRounds();
+    return true;
+}
+
+SimulationResult Simulator::run(const SimulationOptions& options) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    SimulationResult result;
+
+    const long long blockRounds = std::max(1LL, options.blockRounds);
+    const long long maxRounds = config.maxSimulationRounds;
+    const long long totalBlocks = (maxRounds + blockRounds - 1) / blockRounds;
+    const int threadCount = std::max(1, options.threads);
+    long long nextBlock = 0;
+
+    long long savedHistory = -1;  // Hand log length the checkpoint goes with (-1 = no log)
+    if (!options.checkpointPath.empty() && options.resume) {
+        loadCheckpoint(options, nextBlock, result, savedHistory);
+    }
+
+    // The log is appended before each epoch's checkpoint is written, and the
+    // writer can lag, so a resumed log may hold epochs the checkpoint does
+    // not: cut it back to the checkpoint's length before running them again
+    std::unique_ptr<HandLog> history;
+    if (!options.historyPath.empty()) {
+        history.reset(new HandLog(options.historyPath, savedHistory));
+    }
+    auto historyRecords = [&history]() { return history ? history->getRecords() : -1LL; };
+
+    std::unique_ptr<CheckpointWriter> checkpoints;
+    if (!options.checkpointPath.empty()) {
+        // One write up front, so a path that cannot be written fails now and
+        // not after the whole run (the same pattern as PolicyTrainer)
+        if (!CheckpointWriter::writeAtomically(options.checkpointPath,
+                                               checkpointText(options, nextBlock, result, historyRecords()))) {
+            throw TableFormatException("Cannot write checkpoint: " + options.checkpointPath);
+        }
+        checkpoints.reset(new CheckpointWriter(options.checkpointPath));
+    }
+    TelemetryPublisher* telemetry = options.telemetry;
+    if (telemetry) {
+        telemetry->setLimits(maxRounds, config.targetEdgeCIWidth);
+    }
+
+    while (nextBlock < totalBlocks && !result.reachedTarget) {
+        long long epochBlocks = std::min<long long>(options.blocksPerEpoch, totalBlocks - nextBlock);
+        std::vector<RoundStats> shards(static_cast<size_t>(epochBlocks));
+        std::vector<std::vector<HandRecord> > blockHistory(history ? static_cast<size_t>(epochBlocks) : 0);
+        std::atomic<long long> claim(0);
+        const long long firstBlock = nextBlock;
+        if (telemetry) {
+            // Published here, not by the workers: this epoch is in flight, later ones wait
+            telemetry->setQueue(totalBlocks - nextBlock - epochBlocks, epochBlocks);
+        }
+
+        // Each thread claims whole blocks and owns the shard it writes
+        auto worker = [&](int slot) {
+            TelemetryWorker* live = telemetry ? telemetry->worker(slot) : nullptr;
+            for (long long i = claim.fetch_add(1); i < epochBlocks; i = claim.fetch_add(1)) {
+                long long block = firstBlock + i;
+                long long rounds = std::min(blockRounds, maxRounds - block * blockRounds);
+                shards[static_cast<size_t>(i)] = runBlock(options.seed, block, rounds,
+                                                          history ? &blockHistory[static_cast<size_t>(i)] : nullptr);
+                TelemetryPublisher::blockDone(live, static_cast<uint64_t>(rounds));
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < threadCount; t++) {
+            threads.push_back(std::thread(worker, t));
+        }
+        worker(0);  // The calling thread works too
+        for (std::thread& t : threads) {
+            t.join();
+        }
+
+        // Merge in block order - keeps results independent of thread timing
+        for (const RoundStats& shard : shards) {
+            result.stats.merge(shard);
+        }
+        if (history) {
+            for (const std::vector<HandRecord>& records : blockHistory) {
+                history->append(records);
+            }
+            history->flush();
+        }
+        nextBlock += epochBlocks;
+        if (telemetry) {
+            telemetry->setEstimate(result.stats.getRounds(), result.stats.edge(), result.stats.confidenceWidth());
+            telemetry->setQueue(totalBlocks - nextBlock, 0);
+        }
+
+        if (config.targetEdgeCIWidth > 0.0 &&
+            result.stats.getRounds() > 1 &&
+            result.stats.confidenceWidth() <= config.targetEdgeCIWidth) {
+            result.reachedTarget = true;
+        }
+        if (checkpoints) {
+            checkpoints->submit(checkpointText(options, nextBlock, result, historyRecords()));
+        }
+    }
+    if (checkpoints) {
+        checkpoints->flush();
+        result.checkpointFailures = checkpoints->getFailures();
+    }
+    if (telemetry) {
+        telemetry->finish();
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,180 @@
+#include "Solver.h"
+#include "Strategy.h"
+
+/*
+ * SOLVER IMPLEMENTATION
+ * ---------------------
+ * Each function follows the same pattern:
+ * 1. Answer trivial positions directly (bust, standing, empty shoe)
+ * 2. Look the position up in the cache
+ * 3. Otherwise add up "probability of next card x result after it"
+ * 4. Store the answer in the cache for other branches / threads
+ */
+
+namespace {
+
+// Cache key: shoe fingerprint mixed with the hand details that matter
+uint64_t positionKey(uint64_t shoeHash, uint64_t handBits) {
+    uint64_t z = shoeHash + handBits * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Only the hard total and "has an Ace" affect future scores
+uint64_t handBits(const HandState& hand) {
+    return static_cast<uint64_t>(hand.total) << 1 | (hand.aces > 0 ? 1 : 0);
+}
+
+} // namespace
+
+Solver::Solver(const GameConfig& config, DealerCache* dealers, PlayerCache* players)
+    : dealerThreshold(createDealerStrategy(config.useAggressiveDealer)->getThreshold()),
+      hitSoft17(config.ruleVariant == RuleVariant::Vegas),
+      infiniteDeck(!config.useCompositionDeck),
+      dealerCache(dealers),
+      playerCache(players) {
+}
+
+double Solver::rankProbability(const ShoeState& shoe, int rank) const {
+    return infiniteDeck ? 1.0 / ShoeState::RANKS : shoe.probability(rank);
+}
+
+ShoeState Solver::without(const ShoeState& shoe, int rank) const {
+    ShoeState next = shoe;
+    if (!infiniteDeck) {
+        next.removeRank(rank);
+    }
+    return next;
+}
+
+DealerDistribution Solver::dealerDistribution(const ShoeState& shoe, const HandState& dealer) {
+    DealerDistribution result;
+    int score = dealer.getScore();
+
+    // Dealer stops: the rules say stand (see dealerDraws), or (Game rule) the deck is empty
+    bool draws = score < dealerThreshold || (hitSoft17 && dealer.isSoft() && score <= 17);
+    bool outOfCards = !infiniteDeck && shoe.isEmpty();
+    if (!draws || outOfCards) {
+        result.p[score > 21 ? DealerDistribution::BUST : score] = 1.0;
+        return result;
+    }
+
+    uint64_t key = positionKey(infiniteDeck ? 0 : shoe.hash(), handBits(dealer));
+    if (dealerCache != nullptr && dealerCache->find(key, result)) {
+        return result;
+    }
+
+    for (int rank = 1; rank <= ShoeState::RANKS; rank++) {
+        double chance = rankProbability(shoe, rank);
+        if (chance <= 0.0) {
+            continue;
+        }
+        HandState next = dealer;
+        next.addRank(rank);
+        DealerDistribution after = dealerDistribution(without(shoe, rank), next);
+        for (int s = 0; s <= DealerDistribution::BUST; s++) {
+            result.p[s] += chance * after.p[s];
+        }
+    }
+
+    if (dealerCache != nullptr) {
+        dealerCache->insert(key, result);
+    }
+    return result;
+}
+
+Outcome Solver::standOutcome(const ShoeState& shoe, const HandState& player, const HandState& dealer) {
+    Outcome outcome;
+    int playerScore = player.getScore();
+    if (playerScore > 21) {
+        outcome.loss = 1.0;  // Player bust: dealer wins without playing
+        return outcome;
+    }
+
+    DealerDistribution dealerEnd = dealerDistribution(shoe, dealer);
+    outcome.win = dealerEnd.p[DealerDistribution::BUST];
+    for (int s = 0; s <= 21; s++) {
+        if (s < playerScore) {
+            outcome.win += dealerEnd.p[s];
+        } else if (s > playerScore) {
+            outcome.loss += dealerEnd.p[s];
+        }
+    }
+    return outcome;
+}
+
+ActionValues Solver::actionValues(const ShoeState& shoe, const HandState& player, const HandState& dealer) {
+    ActionValues values;
+    uint64_t key = positionKey(infiniteDeck ? 0 : shoe.hash(), handBits(player) << 8 | handBits(dealer));
+    if (playerCache != nullptr && playerCache->find(key, values)) {
+        return values;
+    }
+
+    values.stand = standOutcome(shoe, player, dealer);
+
+    // Game::playerTurn ends the turn on 21, and an empty deck forces a stand
+    bool canHit = player.getScore() < 21 && (infiniteDeck || !shoe.isEmpty());
+    if (!canHit) {
+        values.hit = values.stand;
+    } else {
+        for (int rank = 1; rank <= ShoeState::RANKS; rank++) {
+            double chance = rankProbability(shoe, rank);
+            if (chance <= 0.0) {
+                continue;
+            }
+            HandState next = player;
+            next.addRank(rank);
+            if (next.isBust()) {
+                values.hit.loss += chance;
+                continue;
+            }
+            Outcome after = actionValues(without(shoe, rank), next, dealer).bestOutcome();
+            values.hit.win += chance * after.win;
+            values.hit.loss += chance * after.loss;
+        }
+    }
+
+    if (playerCache != nullptr) {
+        playerCache->insert(key, values);
+    }
+    return values;
+}
+
+Outcome Solver::roundOutcome(const ShoeState& shoe) {
+    // Same order as Game::dealInitialCards: player, player, dealer
+    Outcome total;
+    for (int first = 1; first <= ShoeState::RANKS; first++) {
+        double p1 = rankProbability(shoe, first);
+        if (p1 <= 0.0) {
+            continue;
+        }
+        ShoeState afterFirst = without(shoe, first);
+
+        for (int second = 1; second <= ShoeState::RANKS; second++) {
+            double p2 = rankProbability(afterFirst, second);
+            if (p2 <= 0.0) {
+                continue;
+            }
+            ShoeState afterSecond = without(afterFirst, second);
+
+            for (int up = 1; up <= ShoeState::RANKS; up++) {
+                double p3 = rankProbability(afterSecond, up);
+                if (p3 <= 0.0) {
+                    continue;
+                }
+                HandState player;
+                player.addRank(first);
+                player.addRank(second);
+                HandState dealer;
+                dealer.addRank(up);
+
+                Outcome best = actionValues(without(afterSecond, up), player, dealer).bestOutcome();
+                double chance = p1 * p2 * p3;
+                total.win += chance * best.win;
+                total.loss += chance * best.loss;
+            }
+        }
+    }
+    return total;
+}
@@ -23,7 +23,7 @@ bool ConservativeStrategy::shouldDraw(int score) {
      * Here we create a lambda that takes a score and returns true/false.
      * [threshold] captures the threshold value (15) from outside the lambda.
      */
-    int threshold = 15;  // The score at which we stop drawing
+    int threshold = THRESHOLD;  // The score at which we stop drawing (15)
 
     // Lambda that checks if we should draw
     auto shouldContinue = [threshold](int currentScore) {
@@ -33,6 +33,10 @@ bool ConservativeStrategy::shouldDraw(int score) {
     return shouldContinue(score);  // Call the lambda with our score
 }
 
+int ConservativeStrategy::getThreshold() const {
+    return THRESHOLD;
+}
+
 bool AggressiveStrategy::shouldDraw(int score) {
     /*
      * Aggressive approach:
@@ -40,7 +44,7 @@ bool AggressiveStrategy::shouldDraw(int score) {
      * - Riskier, more likely to bust
      * - Aims for higher winning scores
      */
-    int threshold = 18;  // Higher threshold = more risk
+    int threshold = THRESHOLD;  // Higher threshold = more risk (18)
 
     // Same lambda pattern as above
     auto shouldContinue = [threshold](int currentScore) {
@@ -49,3 +53,14 @@ bool AggressiveStrategy::shouldDraw(int score) {
 
     return shouldContinue(score);
 }
+
+int AggressiveStrategy::getThreshold() const {
+    return THRESHOLD;
+}
+
+std::unique_ptr<DrawStrategy> createDealerStrategy(bool aggressive) {
+    if (aggressive) {
+        return std::make_unique<AggressiveStrategy>();
+    }
+    return std::make_unique<ConservativeStrategy>();
+}
@@ -0,0 +1,293 @@
+#include "StrategyComparison.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+/*
+ * STRATEGYCOMPARISON IMPLEMENTATION
+ * ---------------------------------
+ */
+
+namespace {
+
+// Mirror image of each rank 1-13: small <-> big, ordered by blackjack value
+const uint8_t MIRROR[ShoeState::RANKS + 1] = {
+    0,
+    2,              // A  <-> 2
+    1,              // 2  <-> A
+    13, 12, 11,     // 3, 4, 5 <-> K, Q, J
+    10,             // 6  <-> 10
+    9,              // 7  <-> 9
+    8,              // 8 stays
+    7, 6,           // 9, 10 <-> 7, 6
+    5, 4, 3         // J, Q, K <-> 5, 4, 3
+};
+
+const double Z95 = 1.96;
+
+} // namespace
+
+/*
+ * Running sums over units (a round or a shoe, together with its mirror).
+ * Per unit the vector x = (net 0, rounds 0, net 1, rounds 1, ...) is added
+ * to 'sum' and its outer product to 'cross'.
+ */
+struct StrategyComparison::Moments {
+    int width;
+    long long units;
+    std::vector<double> sum;
+    std::vector<double> cross;  // width x width
+
+    explicit Moments(int values) : width(values), units(0), sum(values, 0.0), cross(values * values, 0.0) {}
+
+    void add(const double* x) {
+        units++;
+        for (int i = 0; i < width; i++) {
+            sum[i] += x[i];
+            for (int j = 0; j < width; j++) {
+                cross[i * width + j] += x[i] * x[j];
+            }
+        }
+    }
+
+    void merge(const Moments& other) {
+        units += other.units;
+        for (int i = 0; i < width; i++) {
+            sum[i] += other.sum[i];
+        }
+        for (size_t i = 0; i < cross.size(); i++) {
+            cross[i] += other.cross[i];
+        }
+    }
+
+    // Sample covariance of values i and j
+    double covariance(int i, int j) const {
+        if (units < 2) {
+            return 0.0;
+        }
+        double n = static_cast<double>(units);
+        return (cross[i * width + j] - sum[i] * sum[j] / n) / (n - 1.0);
+    }
+};
+
+StrategyComparison::StrategyComparison(const std::vector<Contender>& contenderList)
+    : contenders(contenderList) {
+    shoeConfig = contenders.empty() ? GameConfig() : contenders[0].config;
+    for (Contender& contender : contenders) {
+        // Everyone plays the same shoes
+        contender.config.deckSize = shoeConfig.deckSize;
+        contender.config.reshuffleThreshold = shoeConfig.reshuffleThreshold;
+        contender.config.useCompositionDeck = shoeConfig.useCompositionDeck;
+        contender.config.ruleVariant = shoeConfig.ruleVariant;
+        engines.push_back(RoundEngine(contender.config));
+    }
+}
+
+bool StrategyComparison::antitheticSupported() const {
+    if (!shoeConfig.useCompositionDeck) {
+        return true;  // Independent uniform ranks: the mirror is just as likely
+    }
+    ShoeState shoe = ShoeState::standard(shoeConfig.deckSize);
+    for (int rank = 1; rank <= ShoeState::RANKS; rank++) {
+        if (shoe.getCount(rank) != shoe.getCount(MIRROR[rank])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A composition shoe: the standard composition, shuffled (Fisher-Yates)
+void StrategyComparison::fillShoe(Rng& rng, uint8_t* ranks) const {
+    const int size = shoeConfig.deckSize;
+    ShoeState shoe = ShoeState::standard(size);
+    int i = 0;
+    for (int rank = 1; rank <= ShoeState::RANKS; rank++) {
+        for (int c = 0; c < shoe.getCount(rank); c++) {
+            ranks[i++] = static_cast<uint8_t>(rank);
+        }
+    }
+    for (int j = size - 1; j > 0; j--) {
+        std::swap(ranks[j], ranks[rng.below(static_cast<uint32_t>(j + 1))]);
+    }
+}
+
+int StrategyComparison::unitCards() const {
+    return shoeConfig.useCompositionDeck ? shoeConfig.deckSize : ROUND_CARDS;
+}
+
+void StrategyComparison::playShoe(const uint8_t* ranks, double* totals) const {
+    for (size_t k = 0; k < contenders.size(); k++) {
+        CardScript script;
+        script.ranks = ranks;
+        script.size = shoeConfig.deckSize;
+        ShoeState shoe = engines[k].freshShoe();
+        double net = 0.0;
+        double rounds = 0.0;
+        while (!script.finished && !shoe.isEmpty()) {
+            net += engines[k].playScriptedRound(shoe, script, *contenders[k].policy).net;
+            rounds += 1.0;
+        }
+        totals[2 * k] += net;
+        totals[2 * k + 1] += rounds;
+    }
+}
+
+void StrategyComparison::playRound(const CardScript& script, std::vector<ShoeState>& shoes, double* totals) const {
+    for (size_t k = 0; k < contenders.size(); k++) {
+        CardScript copy = script;  // Every contender gets the same cards, overflow included
+        totals[2 * k] += engines[k].playScriptedRound(shoes[k], copy, *contenders[k].policy).net;
+        totals[2 * k + 1] += 1.0;
+    }
+}
+
+void StrategyComparison::runBlock(const ComparisonOptions& options, long long block, bool antithetic,
+                                  Scratch& scratch, Moments& moments) const {
+    const size_t size = static_cast<size_t>(unitCards());
+    const int units = std::max(1, options.blockUnits);
+    const bool composition = shoeConfig.useCompositionDeck;
+    scratch.cards.resize(2 * size * static_cast<size_t>(units));
+    scratch.overflowSeeds.resize(static_cast<size_t>(units));
+    scratch.totals.resize(2 * contenders.size());
+
+    // Pre-generate the block's cards (and their mirrors) once for all contenders
+    Rng rng = Rng::forStream(options.seed, static_cast<uint64_t>(block));
+    for (int u = 0; u < units; u++) {
+        uint8_t* cards = &scratch.cards[2 * size * u];
+        if (composition) {
+            fillShoe(rng, cards);
+        } else {
+            for (size_t i = 0; i < size; i++) {
+                cards[i] = static_cast<uint8_t>(rng.below(ShoeState::RANKS) + 1);  // Same as RoundEngine::drawRank
+            }
+            scratch.overflowSeeds[u] = rng.next();
+        }
+        if (antithetic) {
+            for (size_t i = 0; i < size; i++) {
+                cards[size + i] = MIRROR[cards[i]];
+            }
+        }
+    }
+
+    // Like a Simulator block, every contender starts the block with a fresh shoe
+    scratch.shoes.clear();
+    for (const RoundEngine& engine : engines) {
+        scratch.shoes.push_back(engine.freshShoe());
+    }
+    for (int u = 0; u < units; u++) {
+        std::fill(scratch.totals.begin(), scratch.totals.end(), 0.0);
+        const uint8_t* cards = &scratch.cards[2 * size * u];
+        for (int copy = 0; copy < (antithetic ? 2 : 1); copy++) {
+            if (composition) {
+                playShoe(cards + copy * size, scratch.totals.data());
+            } else {
+                CardScript script;
+                script.ranks = cards + copy * size;
+                script.size = static_cast<int>(size);
+                script.overflow = Rng(scratch.overflowSeeds[u]);
+                playRound(script, scratch.shoes, scratch.totals.data());
+            }
+        }
+        moments.add(scratch.totals.data());
+    }
+}
+
+ComparisonResult StrategyComparison::summarise(const Moments& moments, bool antithetic) const {
+    ComparisonResult result;
+    result.antithetic = antithetic;
+    result.units = moments.units * (antithetic ? 2 : 1);
+    const double n = static_cast<double>(std::max(1LL, moments.units));
+    const int count = static_cast<int>(contenders.size());
+
+    // Delta method: edge_k = meanNet_k / meanRounds_k has gradient
+    // (1 / meanRounds_k, -edge_k / meanRounds_k) in (net_k, rounds_k)
+    std::vector<double> edge(count);
+    std::vector<double> gradNet(count);
+    std::vector<double> gradRounds(count);
+    for (int k = 0; k < count; k++) {
+        double rounds = moments.sum[2 * k + 1];
+        double meanRounds = rounds / n;
+        edge[k] = rounds > 0.0 ? moments.sum[2 * k] / rounds : 0.0;
+        gradNet[k] = meanRounds > 0.0 ? 1.0 / meanRounds : 0.0;
+        gradRounds[k] = meanRounds > 0.0 ? -edge[k] / meanRounds : 0.0;
+    }
+    // Variance of gradient-weighted contenders a and b (covariance term)
+    auto covariance = [&](int a, int b) {
+        return gradNet[a] * gradNet[b] * moments.covariance(2 * a, 2 * b) +
+               gradNet[a] * gradRounds[b] * moments.covariance(2 * a, 2 * b + 1) +
+               gradRounds[a] * gradNet[b] * moments.covariance(2 * a + 1, 2 * b) +
+               gradRounds[a] * gradRounds[b] * moments.covariance(2 * a + 1, 2 * b + 1);
+    };
+
+    for (int k = 0; k < count; k++) {
+        ContenderResult contender;
+        contender.name = contenders[k].name;
+        contender.rounds = static_cast<long long>(moments.sum[2 * k + 1]);
+        contender.edge = edge[k];
+        contender.halfWidth = Z95 * std::sqrt(std::max(0.0, covariance(k, k)) / n);
+        result.contenders.push_back(contender);
+    }
+    for (int k = 1; k < count; k++) {
+        double alone = covariance(k, k) + covariance(0, 0);
+        double paired = alone - 2.0 * covariance(k, 0);
+        ContrastResult contrast;
+        contrast.name = contenders[k].name + " - " + contenders[0].name;
+        contrast.difference = edge[k] - edge[0];
+        contrast.halfWidth = Z95 * std::sqrt(std::max(0.0, paired) / n);
+        contrast.independentHalfWidth = Z95 * std::sqrt(std::max(0.0, alone) / n);
+        result.contrasts.push_back(contrast);
+    }
+    return result;
+}
+
+ComparisonResult StrategyComparison::run(const ComparisonOptions& options) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const int width = static_cast<int>(2 * contenders.size());
+    const bool antithetic = options.antithetic && antitheticSupported();
+    const int threadCount = std::max(1, options.threads);
+
+    Moments total(width);
+    ComparisonResult result = summarise(total, antithetic);
+    long long nextBlock = 0;
+    while (!contenders.empty() && !result.reachedTarget && (result.contenders[0].rounds < options.maxRounds)) {
+        const long long firstBlock = nextBlock;
+        const int epochBlocks = std::max(1, options.blocksPerEpoch);
+        std::vector<Moments> shards(static_cast<size_t>(epochBlocks), Moments(width));
+        std::atomic<int> claim(0);
+
+        auto worker = [&]() {
+            Scratch scratch;
+            for (int i = claim.fetch_add(1); i < epochBlocks; i = claim.fetch_add(1)) {
+                runBlock(options, firstBlock + i, antithetic, scratch, shards[static_cast<size_t>(i)]);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < threadCount; t++) {
+            threads.push_back(std::thread(worker));
+        }
+        worker();
+        for (std::thread& t : threads) {
+            t.join();
+        }
+
+        // Merge in block order - the same sums for any thread count
+        for (const Moments& shard : shards) {
+            total.merge(shard);
+        }
+        nextBlock += epochBlocks;
+
+        result = summarise(total, antithetic);
+        if (options.targetHalfWidth > 0.0 && total.units > 1 && !result.contrasts.empty()) {
+            bool precise = true;
+            for (const ContrastResult& contrast : result.contrasts) {
+                precise = precise && contrast.halfWidth <= options.targetHalfWidth;
+            }
+            result.reachedTarget = precise;
+        }
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,269 @@
+#include "StrategyTables.h"
+#include "Strategy.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * STRATEGYTABLES IMPLEMENTATION
+ * -----------------------------
+ */
+
+// The file is used straight from memory, so every section must be plain data
+static_assert(std::is_trivially_copyable<TableFileHeader>::value, "TableFileHeader must be plain data");
+static_assert(std::is_trivially_copyable<DealerDistribution>::value, "DealerDistribution must be plain data");
+static_assert(std::is_trivially_copyable<ActionValues>::value, "ActionValues must be plain data");
+
+namespace {
+
+const char TABLE_MAGIC[8] = {'B', 'J', 'T', 'A', 'B', 'L', 'E', 'S'};
+const int DEALER_ENTRIES = StrategyTables::UPCARDS + 1;
+const int ACTION_ENTRIES = 2 * StrategyTables::TOTALS * (StrategyTables::UPCARDS + 1);
+
+size_t roundUp8(size_t bytes) {
+    return (bytes + 7) & ~static_cast<size_t>(7);
+}
+
+// Where each section starts - the same for every file of this version
+const size_t DEALER_OFFSET = roundUp8(sizeof(TableFileHeader));
+const size_t ACTION_OFFSET = roundUp8(DEALER_OFFSET + sizeof(DealerDistribution) * DEALER_ENTRIES);
+const size_t FILE_SIZE = roundUp8(ACTION_OFFSET + sizeof(ActionValues) * ACTION_ENTRIES);
+
+int actionIndex(bool soft, int total, int upcard) {
+    return ((soft ? 1 : 0) * StrategyTables::TOTALS + total) * (StrategyTables::UPCARDS + 1) + upcard;
+}
+
+uint64_t mix(uint64_t hash, uint64_t value) {
+    // FNV-1a, one byte at a time
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (8 * i)) & 0xFF;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+long processId() {
+#if defined(_WIN32)
+    return static_cast<long>(_getpid());
+#else
+    return static_cast<long>(getpid());
+#endif
+}
+
+} // namespace
+
+StrategyTables::StrategyTables()
+    : header(nullptr), dealer(nullptr), actions(nullptr), mapping(nullptr), mappingSize(0), built(false) {
+}
+
+StrategyTables::~StrategyTables() {
+#if !defined(_WIN32)
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+#endif
+}
+
+uint64_t StrategyTables::configHash(const GameConfig& config) {
+    // Only what changes the solved numbers (and the file layout itself)
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = mix(hash, VERSION);
+    hash = mix(hash, FILE_SIZE);
+    hash = mix(hash, static_cast<uint64_t>(createDealerStrategy(config.useAggressiveDealer)->getThreshold()));
+    hash = mix(hash, Solver(config).hitsSoft17() ? 1 : 0);
+    return hash;
+}
+
+std::string StrategyTables::defaultPath(const GameConfig& config) {
+    if (config.tableDirectory.empty()) {
+        return "";
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "blackjack_tables_%016llx.bin",
+                  static_cast<unsigned long long>(configHash(config)));
+    return config.tableDirectory + "/" + name;
+}
+
+bool StrategyTables::attach(const char* data, size_t size, const GameConfig& config) {
+    if (size < sizeof(TableFileHeader)) {
+        return false;
+    }
+    const TableFileHeader* candidate = reinterpret_cast<const TableFileHeader*>(data);
+    if (std::memcmp(candidate->magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0 ||
+        candidate->version != VERSION ||
+        candidate->headerSize != sizeof(TableFileHeader) ||
+        candidate->configHash != configHash(config) ||
+        candidate->fileSize != size || size != FILE_SIZE ||
+        candidate->dealerOffset != DEALER_OFFSET ||
+        candidate->actionOffset != ACTION_OFFSET) {
+        return false;  // Stale or foreign file
+    }
+    header = candidate;
+    dealer = reinterpret_cast<const DealerDistribution*>(data + DEALER_OFFSET);
+    actions = reinterpret_cast<const ActionValues*>(data + ACTION_OFFSET);
+    return true;
+}
+
+std::unique_ptr<StrategyTables> StrategyTables::open(const std::string& path, const GameConfig& config) {
+    if (path.empty()) {
+        return nullptr;
+    }
+    std::unique_ptr<StrategyTables> tables(new StrategyTables());
+
+#if defined(_WIN32)
+    // No mmap here: read the file into a private, aligned buffer instead
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!file) {
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(file.tellg());
+    tables->owned.assign((size + 7) / 8, 0);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(tables->owned.data()), static_cast<std::streamsize>(size)) ||
+        !tables->attach(reinterpret_cast<const char*>(tables->owned.data()), size, config)) {
+        return nullptr;
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* region = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping stays valid without the descriptor
+    if (region == MAP_FAILED) {
+        return nullptr;
+    }
+    tables->mapping = region;
+    tables->mappingSize = size;
+    if (!tables->attach(static_cast<const char*>(region), size, config)) {
+        return nullptr;  // Destructor unmaps
+    }
+#endif
+    return tables;
+}
+
+std::vector<uint64_t> StrategyTables::solve(const GameConfig& config) {
+    std::vector<uint64_t> buffer(FILE_SIZE / 8, 0);
+    char* data = reinterpret_cast<char*>(buffer.data());
+
+    GameConfig infinite = config;
+    infinite.useCompositionDeck = false;
+    Solver::DealerCache dealerCache(1 << 12);
+    Solver::PlayerCache playerCache(1 << 12);
+    Solver solver(infinite, &dealerCache, &playerCache);
+    ShoeState shoe = ShoeState::standard(config.deckSize);
+
+    TableFileHeader fileHeader{};
+    std::memcpy(fileHeader.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+    fileHeader.version = VERSION;
+    fileHeader.headerSize = sizeof(TableFileHeader);
+    fileHeader.configHash = configHash(config);
+    fileHeader.fileSize = FILE_SIZE;
+    fileHeader.dealerOffset = DEALER_OFFSET;
+    fileHeader.actionOffset = ACTION_OFFSET;
+    fileHeader.roundOutcome = solver.roundOutcome(shoe);
+    std::memcpy(data, &fileHeader, sizeof(fileHeader));
+
+    DealerDistribution* dealerOut = reinterpret_cast<DealerDistribution*>(data + DEALER_OFFSET);
+    ActionValues* actionOut = reinterpret_cast<ActionValues*>(data + ACTION_OFFSET);
+    for (int up = 1; up <= UPCARDS; up++) {
+        HandState upcard;
+        upcard.addRank(up);
+        dealerOut[up] = solver.dealerDistribution(shoe, upcard);
+
+        for (int total = 2; total < TOTALS; total++) {
+            HandState hard;
+            hard.total = static_cast<uint8_t>(total);
+            hard.cards = 2;
+            actionOut[actionIndex(false, total, up)] = solver.actionValues(shoe, hard, upcard);
+            if (total >= 12) {
+                HandState soft;
+                soft.total = static_cast<uint8_t>(total - 10);
+                soft.aces = 1;
+                soft.cards = 2;
+                actionOut[actionIndex(true, total, up)] = solver.actionValues(shoe, soft, upcard);
+            }
+        }
+    }
+    return buffer;
+}
+
+std::unique_ptr<StrategyTables> StrategyTables::openOrBuild(const GameConfig& config) {
+    return openOrBuild(config, defaultPath(config));
+}
+
+std::unique_ptr<StrategyTables> StrategyTables::openOrBuild(const GameConfig& config, const std::string& path) {
+    std::unique_ptr<StrategyTables> tables = open(path, config);
+    if (tables) {
+        return tables;
+    }
+
+    std::vector<uint64_t> buffer = solve(config);
+
+    if (!path.empty()) {
+        // Write under a private name, then rename: readers see the old file or the new one
+        std::ostringstream temporary;
+        temporary << path << ".tmp" << processId();
+        bool written = false;
+        {
+            std::ofstream file(temporary.str().c_str(), std::ios::binary);
+            if (file) {
+                file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(FILE_SIZE));
+                written = static_cast<bool>(file);
+            }
+        }
+        if (written && std::rename(temporary.str().c_str(), path.c_str()) == 0) {
+            tables = open(path, config);
+        } else {
+            std::remove(temporary.str().c_str());
+        }
+    }
+
+    if (!tables) {
+        // Could not persist - keep the solved tables in memory for this run
+        tables.reset(new StrategyTables());
+        tables->owned.swap(buffer);
+        tables->attach(reinterpret_cast<const char*>(tables->owned.data()), FILE_SIZE, config);
+    }
+    tables->built = true;
+    return tables;
+}
+
+const DealerDistribution& StrategyTables::dealerDistribution(int upcard) const {
+    return dealer[upcard < 1 ? 1 : (upcard > UPCARDS ? UPCARDS : upcard)];
+}
+
+const ActionValues& StrategyTables::actionValues(bool soft, int total, int upcard) const {
+    int clampedTotal = total < 0 ? 0 : (total >= TOTALS ? TOTALS - 1 : total);
+    int clampedUp = upcard < 1 ? 1 : (upcard > UPCARDS ? UPCARDS : upcard);
+    return actions[actionIndex(soft, clampedTotal, clampedUp)];
+}
+
+DecisionTable StrategyTables::decisionTable() const {
+    DecisionTable table;
+    for (int soft = 0; soft < 2; soft++) {
+        for (int total = soft ? 12 : 4; total < TOTALS; total++) {
+            for (int up = 1; up <= UPCARDS; up++) {
+                table.set(soft == 1, total, up, actionValues(soft == 1, total, up).best());
+            }
+        }
+    }
+    return table;
+}
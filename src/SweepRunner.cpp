@@ -0,0 +1,208 @@
+#include "SweepRunner.h"
+#include "MatchOdds.h"
+#include "PlayerPolicy.h"
+#include "Simulator.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+/*
+ * SWEEPRUNNER IMPLEMENTATION
+ * --------------------------
+ */
+
+std::vector<SweepPoint> SweepGrid::expand(const GameConfig& base) const {
+    // An empty list means "keep the base value"
+    std::vector<int> decks = deckSizes.empty() ? std::vector<int>(1, base.deckSize) : deckSizes;
+    std::vector<int> reshuffles = reshuffleThresholds.empty() ? std::vector<int>(1, base.reshuffleThreshold) : reshuffleThresholds;
+    std::vector<int> targets = targetScores.empty() ? std::vector<int>(1, base.targetScore) : targetScores;
+    std::vector<bool> dealers = aggressiveDealers.empty() ? std::vector<bool>(1, base.useAggressiveDealer) : aggressiveDealers;
+    std::vector<int> stands = playerStandThresholds.empty() ? std::vector<int>(1, base.playerStandThreshold) : playerStandThresholds;
+
+    std::vector<SweepPoint> points;
+    for (int deck : decks) {
+        for (int reshuffle : reshuffles) {
+            for (int target : targets) {
+                for (bool aggressive : dealers) {
+                    for (int stand : stands) {
+                        SweepPoint point;
+                        point.config = base;
+                        point.config.deckSize = deck;
+                        point.config.reshuffleThreshold = reshuffle;
+                        point.config.targetScore = target;
+                        point.config.useAggressiveDealer = aggressive;
+                        point.config.playerStandThreshold = stand;
+                        point.label = "deck" + std::to_string(deck) +
+                                      "_reshuffle" + std::to_string(reshuffle) +
+                                      "_target" + std::to_string(target) +
+                                      (aggressive ? "_aggressive" : "_conservative") +
+                                      "_stand" + std::to_string(stand);
+                        points.push_back(point);
+                    }
+                }
+            }
+        }
+    }
+    return points;
+}
+
+namespace {
+
+// Blocks of one point finished so far, merged in block order as they complete
+struct PointProgress {
+    std::mutex lock;
+    std::vector<char> done;            // Per block
+    long long merged = 0;              // Blocks [0, merged) are in 'stats'
+    RoundStats stats;
+    bool reachedTarget = false;
+    std::atomic<long long> stopBlock;  // Blocks from here on are not needed
+
+    explicit PointProgress(long long blocks) : done(static_cast<size_t>(blocks), 0), stopBlock(blocks) {}
+
+    void finished(long long first, long long last, const std::vector<RoundStats>& blockStats,
+                  int blocksPerTask, double targetWidth) {
+        std::lock_guard<std::mutex> guard(lock);
+        for (long long b = first; b < last; b++) {
+            done[static_cast<size_t>(b)] = 1;
+        }
+        const long long blocks = static_cast<long long>(done.size());
+        while (!reachedTarget && merged < blocks && done[static_cast<size_t>(merged)]) {
+            stats.merge(blockStats[static_cast<size_t>(merged)]);
+            merged++;
+            // Only at sub-batch boundaries, so the stop is the same for any timing
+            bool boundary = merged % blocksPerTask == 0 || merged == blocks;
+            if (boundary && targetWidth > 0.0 && stats.getRounds() > 1 && stats.confidenceWidth() <= targetWidth) {
+                reachedTarget = true;
+                stopBlock.store(merged, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+} // namespace
+
+SweepRunner::SweepRunner(int threadCount, uint64_t runSeed)
+    : threads(threadCount), seed(runSeed), blockRounds(4096), blocksPerTask(16) {
+}
+
+void SweepRunner::setBlockRounds(long long rounds) {
+    blockRounds = std::max(1LL, rounds);
+}
+
+void SweepRunner::setBlocksPerTask(int blocks) {
+    blocksPerTask = std::max(1, blocks);
+}
+
+std::vector<SweepResult> SweepRunner::run(const std::vector<SweepPoint>& points) const {
+    // Policies and simulators must outlive every task, so build them first
+    std::vector<std::unique_ptr<ThresholdPolicy> > policies;
+    std::vector<std::unique_ptr<Simulator> > simulators;
+    std::vector<std::vector<RoundStats> > blockStats(points.size());
+
+    for (const SweepPoint& point : points) {
+        policies.push_back(std::unique_ptr<ThresholdPolicy>(new ThresholdPolicy(point.config.playerStandThreshold)));
+        simulators.push_back(std::unique_ptr<Simulator>(new Simulator(point.config, *policies.back())));
+    }
+
+    ThreadPool pool(threads);
+    std::vector<std::unique_ptr<PointProgress> > progress;
+    for (size_t p = 0; p < points.size(); p++) {
+        const long long maxRounds = points[p].config.maxSimulationRounds;
+        const long long blocks = (maxRounds + blockRounds - 1) / blockRounds;
+        blockStats[p].resize(static_cast<size_t>(blocks));
+        progress.push_back(std::unique_ptr<PointProgress>(new PointProgress(blocks)));
+
+        // One task per sub-batch; each task writes only its own blocks
+        for (long long first = 0; first < blocks; first += blocksPerTask) {
+            long long last = std::min(blocks, first + blocksPerTask);
+            const Simulator* simulator = simulators[p].get();
+            std::vector<RoundStats>* out = &blockStats[p];
+            PointProgress* point = progress.back().get();
+            long long size = blockRounds;
+            uint64_t runSeed = seed;
+            int perTask = blocksPerTask;
+            double targetWidth = points[p].config.targetEdgeCIWidth;
+
+            pool.submit([=]() {
+                if (first >= point->stopBlock.load(std::memory_order_relaxed)) {
+                    return;  // The point is already precise enough
+                }
+                for (long long b = first; b < last; b++) {
+                    long long rounds = std::min(size, maxRounds - b * size);
+                    (*out)[static_cast<size_t>(b)] = simulator->runBlock(runSeed, b, rounds);
+                }
+                point->finished(first, last, *out, perTask, targetWidth);
+            });
+        }
+    }
+    pool.wait();
+
+    std::vector<SweepResult> results;
+    for (size_t p = 0; p < points.size(); p++) {
+        SweepResult result;
+        result.point = points[p];
+        result.stats = progress[p]->stats;
+        result.reachedTarget = progress[p]->reachedTarget;
+
+        Outcome round;
+        round.win = result.stats.winRate();
+        round.loss = result.stats.lossRate();
+        MatchOdds match(points[p].config.targetScore, round);
+        result.matchWin = match.winProbability(0, 0);
+        result.matchRounds = match.expectedRounds(0, 0);
+        results.push_back(result);
+    }
+    return results;
+}
+
+void SweepRunner::writeCsv(std::ostream& out, const std::vector<SweepResult>& results) {
+    out << "label,deck_size,reshuffle_threshold,target_score,dealer,player_stand,composition,"
+        << "rounds,stopped_early,edge,edge_ci95,win_rate,tie_rate,loss_rate,player_bust_rate,dealer_bust_rate,"
+        << "match_win,match_rounds\n";
+    for (const SweepResult& r : results) {
+        const GameConfig& c = r.point.config;
+        out << r.point.label << ',' << c.deckSize << ',' << c.reshuffleThreshold << ',' << c.targetScore << ','
+            << (c.useAggressiveDealer ? "aggressive" : "conservative") << ',' << c.playerStandThreshold << ','
+            << (c.useCompositionDeck ? 1 : 0) << ',' << r.stats.getRounds() << ','
+            << (r.reachedTarget ? 1 : 0) << ',' << r.stats.edge() << ',' << r.stats.confidenceHalfWidth() << ','
+            << r.stats.winRate() << ',' << r.stats.tieRate() << ',' << r.stats.lossRate() << ','
+            << r.stats.playerBustRate() << ',' << r.stats.dealerBustRate() << ','
+            << r.matchWin << ',' << r.matchRounds << '\n';
+    }
+}
+
+void SweepRunner::writeJson(std::ostream& out, const std::vector<SweepResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const SweepResult& r = results[i];
+        const GameConfig& c = r.point.config;
+        out << "  {\"label\": \"" << r.point.label << "\""
+            << ", \"deck_size\": " << c.deckSize
+            << ", \"reshuffle_threshold\": " << c.reshuffleThreshold
+            << ", \"target_score\": " << c.targetScore
+            << ", \"dealer\": \"" << (c.useAggressiveDealer ? "aggressive" : "conservative") << "\""
+            << ", \"player_stand\": " << c.playerStandThreshold
+            << ", \"composition\": " << (c.useCompositionDeck ? "true" : "false")
+            << ", \"rounds\": " << r.stats.getRounds()
+            << ", \"stopped_early\": " << (r.reachedTarget ? "true" : "false")
+            << ", \"edge\": " << r.stats.edge()
+            << ", \"edge_ci95\": " << r.stats.confidenceHalfWidth()
+            << ", \"win_rate\": " << r.stats.winRate()
+            << ", \"tie_rate\": " << r.stats.tieRate()
+            << ", \"loss_rate\": " << r.stats.lossRate()
+            << ", \"player_bust_rate\": " << r.stats.playerBustRate()
+            << ", \"dealer_bust_rate\": " << r.stats.dealerBustRate()
+            << ", \"match_win\": " << r.matchWin
+            << ", \"match_rounds\": ";
+        if (std::isfinite(r.matchRounds)) {
+            out << r.matchRounds;
+        } else {
+            out << "null";  // No round is ever decided: the game never ends
+        }
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
@@ -0,0 +1,63 @@
+#include "TableState.h"
+
+/*
+ * DRAWUNDOLOG IMPLEMENTATION
+ * --------------------------
+ * A small circular buffer of draws.
+ *
+ * Undoing a draw needs two things:
+ * - Put the card back in the shoe (ShoeState::addRank)
+ * - Put the hand back exactly as it was (the saved HandState)
+ * Saving the whole HandState (4 bytes) is simpler and safer than
+ * trying to "subtract" a card from the totals.
+ */
+
+DrawUndoLog::DrawUndoLog() : start(0), count(0) {
+}
+
+void DrawUndoLog::record(Seat seat, int rank, const HandState& before) {
+    int slot = (start + count) % CAPACITY;
+    if (count == CAPACITY) {
+        start = (start + 1) % CAPACITY;  // Full - forget the oldest draw
+    } else {
+        count++;
+    }
+
+    entries[slot].rank = static_cast<uint8_t>(rank);
+    entries[slot].seat = seat;
+    entries[slot].before = before;
+}
+
+int DrawUndoLog::draw(TableState& table, Seat seat, Rng& rng) {
+    HandState before = table.hand(seat);
+    int rank = table.draw(seat, rng);
+    record(seat, rank, before);
+    return rank;
+}
+
+void DrawUndoLog::deal(TableState& table, Seat seat, int rank) {
+    HandState before = table.hand(seat);
+    table.deal(seat, rank);
+    record(seat, rank, before);
+}
+
+bool DrawUndoLog::undo(TableState& table) {
+    if (count == 0) {
+        return false;
+    }
+
+    count--;
+    const Entry& last = entries[(start + count) % CAPACITY];
+    table.shoe.addRank(last.rank);
+    table.hand(last.seat) = last.before;
+    return true;
+}
+
+int DrawUndoLog::size() const {
+    return count;
+}
+
+void DrawUndoLog::clear() {
+    start = 0;
+    count = 0;
+}
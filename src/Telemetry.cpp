@@ -0,0 +1,202 @@
+#include "Telemetry.h"
+#include <algorithm>
+#include <chrono>
+#include <new>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * TELEMETRY IMPLEMENTATION
+ * ------------------------
+ */
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "Telemetry counters must be plain 64-bit words");
+static_assert(sizeof(TelemetryWorker) == 64, "One cache line per worker");
+
+const char* const TelemetryPublisher::PREFIX = "blackjack_sim.";
+
+uint64_t TelemetryPublisher::nowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#if defined(_WIN32)
+
+TelemetryPublisher::TelemetryPublisher(const std::string&, int) : segment(nullptr) {
+}
+
+TelemetryPublisher::~TelemetryPublisher() {
+}
+
+TelemetryReader::TelemetryReader(const std::string&) : segment(nullptr) {
+}
+
+TelemetryReader::~TelemetryReader() {
+}
+
+bool TelemetryReader::processAlive() const {
+    return false;
+}
+
+std::vector<std::string> TelemetryReader::list() {
+    return std::vector<std::string>();
+}
+
+bool TelemetryReader::remove(const std::string&) {
+    return false;
+}
+
+#else
+
+TelemetryPublisher::TelemetryPublisher(const std::string& role, int workerSlots)
+    : name(std::string("/") + PREFIX + std::to_string(getpid())),
+      segment(nullptr) {
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) {
+        return;
+    }
+    if (ftruncate(fd, sizeof(TelemetrySegment)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        return;
+    }
+    void* region = mmap(nullptr, sizeof(TelemetrySegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the segment alive
+    if (region == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return;
+    }
+
+    // The new segment is all zeros; fill in the header, magic last
+    TelemetrySegment* fresh = new (region) TelemetrySegment;
+    fresh->version = TelemetrySegment::VERSION;
+    fresh->size = sizeof(TelemetrySegment);
+    fresh->workerSlots = static_cast<uint32_t>(std::min(std::max(1, workerSlots), TelemetrySegment::MAX_WORKERS));
+    fresh->pid = static_cast<int64_t>(getpid());
+    fresh->parentPid = static_cast<int64_t>(getppid());
+    fresh->startNanos = nowNanos();
+    std::strncpy(fresh->role, role.c_str(), sizeof(fresh->role) - 1);
+    std::atomic_thread_fence(std::memory_order_release);
+    fresh->magic = TelemetrySegment::MAGIC;
+    segment = fresh;
+}
+
+TelemetryPublisher::~TelemetryPublisher() {
+    if (segment != nullptr) {
+        munmap(segment, sizeof(TelemetrySegment));
+        shm_unlink(name.c_str());
+    }
+}
+
+TelemetryReader::TelemetryReader(const std::string& name) : segment(nullptr) {
+    std::string path = !name.empty() && name[0] == '/' ? name : "/" + name;
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(TelemetrySegment))) {
+        close(fd);
+        return;
+    }
+    void* region = mmap(nullptr, sizeof(TelemetrySegment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) {
+        return;
+    }
+    const TelemetrySegment* mapped = static_cast<const TelemetrySegment*>(region);
+    if (mapped->magic != TelemetrySegment::MAGIC || mapped->version != TelemetrySegment::VERSION ||
+        mapped->size != sizeof(TelemetrySegment)) {
+        munmap(region, sizeof(TelemetrySegment));
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    segment = mapped;
+}
+
+TelemetryReader::~TelemetryReader() {
+    if (segment != nullptr) {
+        munmap(const_cast<TelemetrySegment*>(segment), sizeof(TelemetrySegment));
+    }
+}
+
+bool TelemetryReader::processAlive() const {
+    return segment != nullptr && (kill(static_cast<pid_t>(segment->pid), 0) == 0 || errno == EPERM);
+}
+
+// POSIX has no portable way to list segments; Linux keeps them in /dev/shm
+std::vector<std::string> TelemetryReader::list() {
+    std::vector<std::string> names;
+    DIR* directory = opendir("/dev/shm");
+    if (directory == nullptr) {
+        return names;
+    }
+    const std::string prefix = TelemetryPublisher::PREFIX;
+    while (dirent* entry = readdir(directory)) {
+        std::string file = entry->d_name;
+        if (file.compare(0, prefix.size(), prefix) == 0) {
+            names.push_back("/" + file);
+        }
+    }
+    closedir(directory);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool TelemetryReader::remove(const std::string& name) {
+    return shm_unlink((!name.empty() && name[0] == '/' ? name : "/" + name).c_str()) == 0;
+}
+
+#endif
+
+TelemetryWorker* TelemetryPublisher::worker(int slot) {
+    if (segment == nullptr || slot < 0 || slot >= static_cast<int>(segment->workerSlots)) {
+        return nullptr;
+    }
+    TelemetryWorker* own = &segment->workers[slot];
+    if (own->startNanos.load(std::memory_order_relaxed) == 0) {
+        store(own->startNanos, nowNanos());
+    }
+    return own;
+}
+
+void TelemetryPublisher::setLimits(long long maxRounds, double targetWidth) {
+    if (segment != nullptr) {
+        store(segment->maxRounds, static_cast<uint64_t>(std::max(0LL, maxRounds)));
+        store(segment->targetBits, TelemetrySegment::toBits(targetWidth));
+    }
+}
+
+void TelemetryPublisher::setQueue(long long queued, long long inFlight) {
+    if (segment != nullptr) {
+        store(segment->queued, static_cast<uint64_t>(std::max(0LL, queued)));
+        store(segment->inFlight, static_cast<uint64_t>(std::max(0LL, inFlight)));
+    }
+}
+
+void TelemetryPublisher::setEstimate(long long rounds, double edge, double ciWidth) {
+    if (segment != nullptr) {
+        store(segment->totalRounds, static_cast<uint64_t>(std::max(0LL, rounds)));
+        store(segment->edgeBits, TelemetrySegment::toBits(edge));
+        store(segment->ciWidthBits, TelemetrySegment::toBits(ciWidth));
+        store(segment->epochs, segment->epochs.load(std::memory_order_relaxed) + 1);
+        store(segment->updatedNanos, nowNanos());
+    }
+}
+
+void TelemetryPublisher::finish() {
+    if (segment != nullptr) {
+        store(segment->queued, 0);
+        store(segment->inFlight, 0);
+        store(segment->state, TelemetrySegment::Finished);
+        store(segment->updatedNanos, nowNanos());
+    }
+}
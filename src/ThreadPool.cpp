@@ -0,0 +1,103 @@
+#include "ThreadPool.h"
+#include <chrono>
+
+/*
+ * THREADPOOL IMPLEMENTATION
+ * -------------------------
+ */
+
+ThreadPool::ThreadPool(int threadCount)
+    : pending(0), nextQueue(0), stopping(false) {
+    if (threadCount < 1) {
+        threadCount = 1;
+    }
+    for (int i = 0; i < threadCount; i++) {
+        queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int i = 0; i < threadCount; i++) {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(workers.size());
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // Spread new tasks round-robin; stealing evens out the rest
+    unsigned target = nextQueue.fetch_add(1) % queues.size();
+    pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    {
+        // Taking the lock avoids a missed wake-up between check and sleep
+        std::lock_guard<std::mutex> guard(sleepLock);
+    }
+    workReady.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> guard(sleepLock);
+    allDone.wait(guard, [this]() { return pending.load() == 0; });
+}
+
+bool ThreadPool::takeTask(int index, std::function<void()>& task) {
+    // 1. Own queue, from the front
+    {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // 2. Steal from the back of the other queues
+    int count = static_cast<int>(queues.size());
+    for (int offset = 1; offset < count; offset++) {
+        WorkerQueue& victim = *queues[(index + offset) % count];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(int index) {
+    while (true) {
+        std::function<void()> task;
+        if (takeTask(index, task)) {
+            task();
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        // Nothing anywhere: sleep until new work arrives or shutdown
+        std::unique_lock<std::mutex> guard(sleepLock);
+        if (stopping) {
+            return;
+        }
+        workReady.wait_for(guard, std::chrono::milliseconds(10));
+    }
+}
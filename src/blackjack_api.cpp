@@ -0,0 +1,276 @@
+#include "blackjack.h"
+#include "PlayerPolicy.h"
+#include "RoundStats.h"
+#include "Simulator.h"
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+
+/*
+ * LIBBLACKJACK C API IMPLEMENTATION
+ * ---------------------------------
+ * Thin wrappers around RoundEngine. Every entry point catches everything:
+ * a C++ exception must never unwind into a C caller.
+ */
+
+// The opaque table handed to C callers
+struct bj_table {
+    std::unique_ptr<PlayerPolicy> policy;
+    RoundEngine engine;
+    ShoeState shoe;
+    Rng rng;
+    RoundStats stats;
+
+    bj_table(const GameConfig& gameConfig, std::unique_ptr<PlayerPolicy> playerPolicy, uint64_t seed, uint64_t stream)
+        : policy(std::move(playerPolicy)),
+          engine(gameConfig),
+          shoe(engine.freshShoe()),
+          rng(Rng::forStream(seed, stream)) {
+    }
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+int fail(int code, const std::string& message) {
+    lastError = message;
+    return code;
+}
+
+// Calls 'body' and turns any exception into a return code
+template <typename Body>
+int guarded(Body body) {
+    try {
+        lastError.clear();
+        return body();
+    }
+    catch (const std::bad_alloc&) {
+        return fail(BJ_ERROR_OUT_OF_MEMORY, "out of memory");
+    }
+    catch (const std::exception& e) {
+        return fail(BJ_ERROR_INTERNAL, e.what());
+    }
+    catch (...) {
+        return fail(BJ_ERROR_INTERNAL, "unknown error");
+    }
+}
+
+/*
+ * Copies the caller's bj_config over the defaults. Only the first
+ * config->size bytes are read, so older (shorter) structs still work.
+ */
+bool readConfig(const bj_config* given, bj_config& config) {
+    bj_config_init(&config);
+    if (given == nullptr || given->size < sizeof(uint32_t)) {
+        return false;
+    }
+    size_t bytes = given->size < sizeof(bj_config) ? given->size : sizeof(bj_config);
+    std::memcpy(&config, given, bytes);
+    config.size = sizeof(bj_config);
+    return true;
+}
+
+int validate(const bj_config& config) {
+    if (config.deck_size < 1) {
+        return fail(BJ_ERROR_INVALID_ARGUMENT, "deck_size must be at least 1");
+    }
+    if (config.reshuffle_threshold < 0 || config.reshuffle_threshold > config.deck_size) {
+        return fail(BJ_ERROR_INVALID_ARGUMENT, "reshuffle_threshold must be between 0 and deck_size");
+    }
+    if (config.rules < BJ_RULES_CLASSIC || config.rules > BJ_RULES_VEGAS) {
+        return fail(BJ_ERROR_INVALID_ARGUMENT, "unknown rules");
+    }
+    if (config.policy != BJ_POLICY_THRESHOLD && config.policy != BJ_POLICY_BASIC) {
+        return fail(BJ_ERROR_INVALID_ARGUMENT, "unknown policy");
+    }
+    return BJ_OK;
+}
+
+GameConfig toGameConfig(const bj_config& config) {
+    GameConfig game = createNormalConfig();
+    game.deckSize = config.deck_size;
+    game.reshuffleThreshold = config.reshuffle_threshold;
+    game.useCompositionDeck = config.composition_deck != 0;
+    game.useAggressiveDealer = config.aggressive_dealer != 0;
+    game.ruleVariant = static_cast<RuleVariant>(config.rules);
+    game.playerStandThreshold = config.player_stand_threshold;
+    return game;
+}
+
+std::unique_ptr<PlayerPolicy> makePolicy(const bj_config& config) {
+    if (config.policy == BJ_POLICY_BASIC) {
+        return std::unique_ptr<PlayerPolicy>(new BasicStrategyPolicy());
+    }
+    return std::unique_ptr<PlayerPolicy>(new ThresholdPolicy(config.player_stand_threshold));
+}
+
+bj_table* newTable(const bj_config& config, uint64_t stream) {
+    return new bj_table(toGameConfig(config), makePolicy(config), config.seed, stream);
+}
+
+void toRound(const RoundRecord& record, bj_round& round) {
+    round.net = record.net;
+    round.player_score = static_cast<int16_t>(record.playerScore);
+    round.dealer_score = static_cast<int16_t>(record.dealerScore);
+    round.dealer_upcard = static_cast<uint8_t>(record.dealerUpcard);
+    round.player_cards = static_cast<uint8_t>(record.playerCards);
+    round.dealer_cards = static_cast<uint8_t>(record.dealerCards);
+    round.flags = static_cast<uint8_t>((record.playerBust ? BJ_ROUND_PLAYER_BUST : 0) |
+                                       (record.dealerBust ? BJ_ROUND_DEALER_BUST : 0) |
+                                       (record.playerSoft ? BJ_ROUND_PLAYER_SOFT : 0) |
+                                       (record.doubled ? BJ_ROUND_DOUBLED : 0) |
+                                       (record.split ? BJ_ROUND_SPLIT : 0) |
+                                       (record.surrendered ? BJ_ROUND_SURRENDERED : 0));
+}
+
+// The rule set is picked once per call, not once per round
+template <typename Rules>
+void simulateWith(bj_table& table, uint64_t rounds, bj_round* results) {
+    for (uint64_t r = 0; r < rounds; r++) {
+        RoundRecord record = table.engine.playRoundWith<Rules>(table.shoe, table.rng, *table.policy);
+        table.stats.add(record);
+        if (results != nullptr) {
+            toRound(record, results[r]);
+        }
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+uint32_t bj_abi_version(void) {
+    return BJ_ABI_VERSION;
+}
+
+const char* bj_last_error(void) {
+    return lastError.c_str();
+}
+
+void bj_config_init(bj_config* config) {
+    if (config == nullptr) {
+        return;
+    }
+    GameConfig defaults = createNormalConfig();
+    std::memset(config, 0, sizeof(bj_config));
+    config->size = sizeof(bj_config);
+    config->deck_size = defaults.deckSize;
+    config->reshuffle_threshold = defaults.reshuffleThreshold;
+    config->composition_deck = defaults.useCompositionDeck ? 1 : 0;
+    config->aggressive_dealer = defaults.useAggressiveDealer ? 1 : 0;
+    config->rules = static_cast<int32_t>(defaults.ruleVariant);
+    config->policy = BJ_POLICY_THRESHOLD;
+    config->player_stand_threshold = defaults.playerStandThreshold;
+    config->seed = 1;
+    config->stream = 0;
+}
+
+int bj_table_create(const bj_config* given, bj_table** table) {
+    return bj_tables_create(given, 1, table);
+}
+
+void bj_table_destroy(bj_table* table) {
+    delete table;
+}
+
+int bj_tables_create(const bj_config* given, size_t count, bj_table** tables) {
+    return guarded([&]() {
+        bj_config config;
+        if (tables == nullptr || !readConfig(given, config)) {
+            return fail(BJ_ERROR_INVALID_ARGUMENT, "config and tables must not be NULL");
+        }
+        int status = validate(config);
+        if (status != BJ_OK) {
+            return status;
+        }
+        size_t made = 0;
+        try {
+            for (; made < count; made++) {
+                tables[made] = newTable(config, config.stream + made);
+            }
+        }
+        catch (...) {
+            bj_tables_destroy(tables, made);  // All or nothing
+            for (size_t i = 0; i < count; i++) {
+                tables[i] = nullptr;
+            }
+            throw;
+        }
+        return BJ_OK;
+    });
+}
+
+void bj_tables_destroy(bj_table** tables, size_t count) {
+    if (tables == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        delete tables[i];
+        tables[i] = nullptr;
+    }
+}
+
+int bj_tables_step(bj_table* const* tables, size_t count, bj_round* results) {
+    return guarded([&]() {
+        if (tables == nullptr && count > 0) {
+            return fail(BJ_ERROR_INVALID_ARGUMENT, "tables must not be NULL");
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (tables[i] == nullptr) {
+                return fail(BJ_ERROR_INVALID_ARGUMENT, "tables[" + std::to_string(i) + "] is NULL");
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            bj_table& table = *tables[i];
+            RoundRecord record = table.engine.playRound(table.shoe, table.rng, *table.policy);
+            table.stats.add(record);
+            if (results != nullptr) {
+                toRound(record, results[i]);
+            }
+        }
+        return BJ_OK;
+    });
+}
+
+int bj_table_simulate(bj_table* table, uint64_t rounds, bj_round* results) {
+    return guarded([&]() {
+        if (table == nullptr) {
+            return fail(BJ_ERROR_INVALID_ARGUMENT, "table must not be NULL");
+        }
+        switch (table->engine.getRuleVariant()) {
+        case RuleVariant::Standard:
+            simulateWith<StandardRules>(*table, rounds, results);
+            break;
+        case RuleVariant::Vegas:
+            simulateWith<VegasRules>(*table, rounds, results);
+            break;
+        case RuleVariant::Classic:
+            simulateWith<ClassicRules>(*table, rounds, results);
+            break;
+        }
+        return BJ_OK;
+    });
+}
+
+int bj_table_summary(const bj_table* table, bj_summary* summary) {
+    return guarded([&]() {
+        if (table == nullptr || summary == nullptr) {
+            return fail(BJ_ERROR_INVALID_ARGUMENT, "table and summary must not be NULL");
+        }
+        const RoundStats& stats = table->stats;
+        summary->rounds = static_cast<uint64_t>(stats.getRounds());
+        summary->wins = static_cast<uint64_t>(stats.getWins());
+        summary->ties = static_cast<uint64_t>(stats.getTies());
+        summary->losses = static_cast<uint64_t>(stats.getLosses());
+        summary->player_busts = static_cast<uint64_t>(stats.getPlayerBusts());
+        summary->dealer_busts = static_cast<uint64_t>(stats.getDealerBusts());
+        summary->edge = stats.edge();
+        summary->edge_half_width = stats.confidenceHalfWidth();
+        return BJ_OK;
+    });
+}
+
+} // extern "C"
@@ -37,9 +37,12 @@
 
 #include "Game.h"
 #include "GameConfig.h"  // For game configuration
+#include "GameException.h"  // Bad rule files are reported, not crashed on
+#include "MetricsServer.h"  // Optional Prometheus endpoint
 #include <ctime>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 
 int main() {
     // Seed random number generator for card shuffling
@@ -61,11 +64,35 @@ int main() {
      *   Game game(createHardConfig());
      */
 
+    // Hosted tables: BLACKJACK_METRICS_PORT=9464 serves http://127.0.0.1:9464/metrics
+    std::unique_ptr<MetricsServer> metricsServer;
+    if (const char* port = getenv("BLACKJACK_METRICS_PORT")) {
+        metricsServer.reset(new MetricsServer(Metrics::global(), atoi(port)));
+        if (!metricsServer->start()) {
+            std::cerr << "Could not open the metrics port " << port << std::endl;
+        }
+    }
     // Using normal (default) configuration
-    Game game(createNormalConfig());
+    GameConfig config = createNormalConfig();
 
-    // Start the game
-    game.play();
+    // Dealer behaviour without a rebuild: BLACKJACK_DEALER_RULES=dealer.rules
+    if (const char* rules = getenv("BLACKJACK_DEALER_RULES")) {
+        config.dealerRulesFile = rules;
+    }
+    // Share solved tables with other runs: BLACKJACK_TABLE_DIR=~/.cache/blackjack
+    if (const char* tableDir = getenv("BLACKJACK_TABLE_DIR")) {
+        config.tableDirectory = tableDir;
+    }
+    try {
+        Game game(config);
+
+        // Start the game
+        game.play();
+    }
+    catch (const RuleFormatException& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
 
     // Game destructor automatically cleans up all resources
     // (Smart pointers prevent memory leaks)
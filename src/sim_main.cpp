@@ -0,0 +1,1060 @@
+/*
+ * BLACKJACK SIMULATOR (HEADLESS)
+ * ==============================
+ * Command-line entry point for running the game without a human player.
+ * Used for strategy sweeps, benchmarks and statistics.
+ *
+ * USAGE:
+ *   blackjack_sim batch [--preset easy|normal|hard] [--rounds N] [--lanes N] [--seed N]
+ *   blackjack_sim simulate [--preset ...] [--rules classic|standard|vegas] [--policy threshold|basic|mcts|table|solved|rules]
+ *                          [--rollouts N] [--budget-us N] [--search-threads N] [--table FILE] [--rule-file FILE]
+ *                          [--ci-width W] [--max-rounds N] [--threads N] [--seed N]
+ *                          [--checkpoint FILE] [--resume] [--history FILE] [--no-telemetry]
+ *   blackjack_sim sweep [--preset ...] [--deck-sizes A,B] [--reshuffles A,B] [--targets A,B]
+ *                       [--dealers aggressive,conservative] [--player-stands A,B]
+ *                       [--rounds N] [--threads N] [--format csv|json] [--out FILE]
+ *   blackjack_sim solve [--preset ...] [--composition] [--deck-size N] [--threads N] [--cache-slots N]
+ *   blackjack_sim match [--preset ...] [--composition] [--target N]
+ *   blackjack_sim tables [--preset ...] [--rules ...] [--table-dir DIR]
+ *   blackjack_sim train [--preset ...] [--episodes N] [--epoch-episodes N] [--threads N] [--epsilon E]
+ *                       [--checkpoint FILE] [--resume] [--out FILE]
+ *   blackjack_sim bankroll [--preset ...] [--policy ...] [--composition] [--betting flat|spread]
+ *                          [--max-bet N] [--ramp N] [--bankrolls N] [--rounds N] [--units N]
+ *                          [--points N] [--threads N] [--seed N]
+ *   blackjack_sim compare [--preset ...] [--rules ...] [--composition] [--contenders DEALER:POLICY,...]
+ *                         [--target-width W] [--max-rounds N] [--no-antithetic] [--threads N] [--seed N]
+ *   blackjack_sim audit [--preset ...] [--deck-size N] [--shoes N] [--verify N] [--threads N] [--seed N]
+ *   blackjack_sim check-rules [--file FILE] [--preset ...]
+ *   blackjack_sim query [--history FILE] [--total N] [--soft 0|1] [--upcard N] [--outcome A,B]
+ *                       [--dealer-cards-min N] [--dealer-cards-max N] [--player-cards-min N]
+ *                       [--player-cards-max N] [--show N] [--threads N]
+ *   blackjack_sim distribute [simulate options] [--processes N] [--shard-blocks N] [--retries N] [--shard-dir DIR]
+ *   blackjack_sim sessions [--preset ...] [--composition] [--tables N] [--resident N] [--touches N]
+ *                          [--session-dir DIR] [--seed N]
+ *
+ * Each sub-command reads simple "--name value" options.
+ */
+
+#include "AllocationTracker.h"
+#include "BankrollSimulator.h"
+#include "BatchSimulator.h"
+#include "DecisionTable.h"
+#include "GameException.h"
+#include "GameConfig.h"
+#include "HandIndex.h"
+#include "MatchOdds.h"
+#include "MctsPolicy.h"
+#include "PlayerPolicy.h"
+#include "PolicyTrainer.h"
+#include "RuleTable.h"
+#include "SessionStore.h"
+#include "ShardCoordinator.h"
+#include "ShuffleAudit.h"
+#include "Simulator.h"
+#include "Solver.h"
+#include "StrategyComparison.h"
+#include "StrategyTables.h"
+#include "SweepRunner.h"
+#include "Telemetry.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+namespace {
+
+// Parsed "--name value" pairs for one sub-command
+typedef map<string, string> Options;
+
+Options parseOptions(int argc, char* argv[], int first) {
+    Options options;
+    for (int i = first; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.size() > 2 && arg.compare(0, 2, "--") == 0) {
+            string value = (i + 1 < argc) ? argv[i + 1] : "";
+            if (!value.empty() && value.compare(0, 2, "--") != 0) {
+                i++;
+            } else {
+                value = "1";  // Plain flag
+            }
+            options[arg.substr(2)] = value;
+        }
+    }
+    return options;
+}
+
+long long optionInt(const Options& options, const string& name, long long fallback) {
+    Options::const_iterator it = options.find(name);
+    return it == options.end() ? fallback : atoll(it->second.c_str());
+}
+
+string optionString(const Options& options, const string& name, const string& fallback) {
+    Options::const_iterator it = options.find(name);
+    return it == options.end() ? fallback : it->second;
+}
+
+// Comma separated list, e.g. "52,104,208"
+vector<string> optionList(const Options& options, const string& name) {
+    vector<string> items;
+    stringstream stream(optionString(options, name, ""));
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+vector<int> optionIntList(const Options& options, const string& name) {
+    vector<int> values;
+    for (const string& item : optionList(options, name)) {
+        values.push_back(atoi(item.c_str()));
+    }
+    return values;
+}
+
+GameConfig presetConfig(const Options& options) {
+    string preset = optionString(options, "preset", "normal");
+    GameConfig config = (preset == "easy") ? createEasyConfig()
+                      : (preset == "hard") ? createHardConfig()
+                      : createNormalConfig();
+    config.playerStandThreshold = static_cast<int>(
+        optionInt(options, "player-stand", config.playerStandThreshold));
+    config.deckSize = static_cast<int>(optionInt(options, "deck-size", config.deckSize));
+    config.useCompositionDeck = options.count("composition") > 0;
+    config.maxSimulationRounds = optionInt(options, "max-rounds", config.maxSimulationRounds);
+    string rules = optionString(options, "rules", "classic");
+    config.ruleVariant = (rules == "standard") ? RuleVariant::Standard
+                       : (rules == "vegas") ? RuleVariant::Vegas
+                       : RuleVariant::Classic;
+    if (options.count("ci-width") > 0) {
+        config.targetEdgeCIWidth = atof(optionString(options, "ci-width", "0").c_str());
+    }
+    config.tableDirectory = optionString(options, "table-dir", config.tableDirectory);
+    return config;
+}
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void printResult(const string& label, const BatchResult& result, double seconds) {
+    cout << label << ": " << result.rounds << " rounds in " << seconds << " s ("
+         << (seconds > 0 ? result.rounds / seconds : 0.0) << " rounds/s)" << endl;
+    cout << "  player wins " << result.playerWins
+         << ", dealer wins " << result.dealerWins
+         << ", ties " << result.ties
+         << ", player busts " << result.playerBusts
+         << ", dealer busts " << result.dealerBusts << endl;
+    cout << "  player edge " << result.edge() << " points/round" << endl;
+}
+
+// Heap use while running; only in builds configured with BLACKJACK_TRACK_ALLOCATIONS
+struct AllocationSnapshot {
+    AllocationCounts phases[AllocationTracker::PHASES];
+
+    static AllocationSnapshot take() {
+        AllocationSnapshot snapshot;
+        for (int i = 0; i < AllocationTracker::PHASES; i++) {
+            snapshot.phases[i] = AllocationTracker::phase(static_cast<AllocationPhase>(i));
+        }
+        return snapshot;
+    }
+};
+
+void printAllocations(const AllocationSnapshot& before, long long rounds, bool byPhase) {
+    if (!AllocationTracker::enabled()) {
+        return;
+    }
+    AllocationSnapshot after = AllocationSnapshot::take();
+    AllocationCounts total;
+    double perRound = rounds > 0 ? 1.0 / static_cast<double>(rounds) : 0.0;
+    for (int i = 0; i < AllocationTracker::PHASES; i++) {
+        AllocationCounts used = after.phases[i] - before.phases[i];
+        total.allocations += used.allocations;
+        total.bytes += used.bytes;
+        if (byPhase && used.allocations > 0) {
+            cout << "    " << AllocationTracker::phaseName(static_cast<AllocationPhase>(i)) << ": "
+                 << used.allocations * perRound << " allocations, " << used.bytes * perRound << " bytes per round" << endl;
+        }
+    }
+    cout << "  heap: " << total.allocations << " allocations (" << total.allocations * perRound
+         << " per round), " << total.bytes << " bytes" << endl;
+}
+
+int runBatch(const Options& options) {
+    GameConfig config = presetConfig(options);
+    long long rounds = optionInt(options, "rounds", 1000000);
+    int lanes = static_cast<int>(optionInt(options, "lanes", 256));
+    uint64_t seed = static_cast<uint64_t>(optionInt(options, "seed", 1));
+
+    AllocationSnapshot heap = AllocationSnapshot::take();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    BatchResult scalar = runScalarReference(config, rounds, static_cast<unsigned int>(seed));
+    printResult("scalar", scalar, secondsSince(start));
+    printAllocations(heap, scalar.rounds, true);
+
+    BatchSimulator simulator(config, lanes, seed);
+    heap = AllocationSnapshot::take();
+    start = chrono::steady_clock::now();
+    BatchResult batch = simulator.run(rounds);
+    printResult("batch ", batch, secondsSince(start));
+    printAllocations(heap, batch.rounds, true);
+    return 0;
+}
+
+int threadOption(const Options& options) {
+    long long threads = optionInt(options, "threads", thread::hardware_concurrency());
+    return threads < 1 ? 1 : static_cast<int>(threads);
+}
+
+void printStats(const RoundStats& stats) {
+    cout << "  rounds " << stats.getRounds() << endl;
+    cout << "  edge " << stats.edge() << " +/- " << stats.confidenceHalfWidth()
+         << " points/round (95% CI), std dev " << sqrt(stats.variance()) << endl;
+    cout << "  win " << stats.winRate() << ", tie " << stats.tieRate() << ", loss " << stats.lossRate()
+         << ", player bust " << stats.playerBustRate() << ", dealer bust " << stats.dealerBustRate() << endl;
+    cout << "  dealer final totals:";
+    for (int bucket = 0; bucket < RoundStats::HISTOGRAM_SIZE; bucket++) {
+        long long count = stats.getDealerHistogram(bucket);
+        if (count > 0) {
+            cout << " " << (bucket == RoundStats::BUST_BUCKET ? string("bust") : to_string(bucket)) << "=" << count;
+        }
+    }
+    cout << endl;
+}
+
+// threshold (hit below playerStandThreshold), basic, table, solved or mcts
+unique_ptr<PlayerPolicy> makeNamedPolicy(const string& name, const Options& options, const GameConfig& config) {
+    if (name == "basic") {
+        return unique_ptr<PlayerPolicy>(new BasicStrategyPolicy());
+    }
+    if (name == "table") {
+        // A learned or hand-written DecisionTable file (see the train command)
+        return unique_ptr<PlayerPolicy>(new DecisionTable(DecisionTable::loadFile(optionString(options, "table", "policy.txt"))));
+    }
+    if (name == "rules") {
+        // Text rules (see RuleTable.h), compiled into a flat table
+        return unique_ptr<PlayerPolicy>(new RulePolicy(RuleTable::loadFile(optionString(options, "rule-file", "player.rules")),
+                                                       config.deckSize));
+    }
+    if (name == "solved") {
+        // Best play from the shared strategy tables (solved on first use)
+        unique_ptr<StrategyTables> tables = StrategyTables::openOrBuild(config);
+        return unique_ptr<PlayerPolicy>(new DecisionTable(tables->decisionTable()));
+    }
+    if (name == "mcts") {
+        MctsOptions search;
+        search.rollouts = optionInt(options, "rollouts", 2000);
+        search.timeMicros = optionInt(options, "budget-us", 0);
+        search.threads = optionInt(options, "search-threads", 1);
+        search.seed = static_cast<uint64_t>(optionInt(options, "seed", 1));
+        return unique_ptr<PlayerPolicy>(new MctsPolicy(config, search));
+    }
+    return unique_ptr<PlayerPolicy>(new ThresholdPolicy(config.playerStandThreshold));
+}
+
+unique_ptr<PlayerPolicy> makePolicy(const Options& options, const GameConfig& config) {
+    return makeNamedPolicy(optionString(options, "policy", "threshold"), options, config);
+}
+
+// Live progress for blackjack_top, unless --no-telemetry
+unique_ptr<TelemetryPublisher> makeTelemetry(const Options& options, const string& role, int workers) {
+    if (options.count("no-telemetry") > 0) {
+        return nullptr;
+    }
+    return unique_ptr<TelemetryPublisher>(new TelemetryPublisher(role, workers));
+}
+
+int runSimulate(const Options& options) {
+    GameConfig config = presetConfig(options);
+    unique_ptr<PlayerPolicy> policy = makePolicy(options, config);
+    Simulator simulator(config, *policy);
+
+    SimulationOptions run;
+    run.seed = static_cast<uint64_t>(optionInt(options, "seed", 1));
+    run.threads = threadOption(options);
+    run.checkpointPath = optionString(options, "checkpoint", "");
+    run.resume = options.count("resume") > 0;
+    run.historyPath = optionString(options, "history", "");
+    unique_ptr<TelemetryPublisher> telemetry = makeTelemetry(options, "simulate", run.threads);
+    run.telemetry = telemetry.get();
+
+    AllocationSnapshot heap = AllocationSnapshot::take();
+    SimulationResult result = simulator.run(run);
+    cout << "Simulated " << result.stats.getRounds() << " rounds in " << result.seconds << " s"
+         << (result.reachedTarget ? " (stopped early: CI target reached)" : "") << endl;
+    if (result.resumedRounds > 0) {
+        cout << "  resumed from " << result.resumedRounds << " rounds in " << run.checkpointPath << endl;
+    }
+    printAllocations(heap, result.stats.getRounds() - result.resumedRounds, false);
+    printStats(result.stats);
+    if (result.checkpointFailures > 0) {
+        cerr << "Error: " << result.checkpointFailures << " checkpoint writes to " << run.checkpointPath
+             << " failed; it does not hold the final state" << endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runBankroll(const Options& options) {
+    GameConfig config = presetConfig(options);
+    unique_ptr<PlayerPolicy> policy = makePolicy(options, config);
+    unique_ptr<BettingStrategy> betting = createBettingStrategy(optionString(options, "betting", "flat"),
+                                                                atof(optionString(options, "max-bet", "8").c_str()),
+                                                                atof(optionString(options, "ramp", "2").c_str()));
+    BankrollSimulator simulator(config, *policy, *betting);
+
+    BankrollOptions run;
+    run.bankrolls = optionInt(options, "bankrolls", run.bankrolls);
+    run.rounds = optionInt(options, "rounds", run.rounds);
+    run.startingUnits = atof(optionString(options, "units", "100").c_str());
+    run.trajectoryPoints = static_cast<int>(optionInt(options, "points", run.trajectoryPoints));
+    run.threads = threadOption(options);
+    run.seed = static_cast<uint64_t>(optionInt(options, "seed", 1));
+
+    BankrollResult result = simulator.run(run);
+    cout << run.bankrolls << " bankrolls of " << run.startingUnits << " units, up to " << run.rounds
+         << " rounds each, betting " << betting->describe() << endl;
+    cout << "  " << result.roundsPlayed << " rounds in " << result.seconds << " s" << endl;
+    cout << "  risk of ruin " << result.riskOfRuin << " +/- " << result.riskOfRuinHalfWidth << " (95% CI)";
+    if (result.meanRoundsToRuin > 0.0) {
+        cout << ", ruined after " << result.meanRoundsToRuin << " rounds on average";
+    }
+    cout << endl;
+    cout << "  mean bet " << result.meanBet << " units, edge " << result.edgePerUnit()
+         << " per unit wagered, net " << result.won << " units" << endl;
+    cout << "  round      ruined     mean       p5      p25   median      p75      p95" << endl;
+    cout << fixed << setprecision(1);
+    for (const BankrollSnapshot& point : result.trajectory) {
+        cout << "  " << setw(9) << point.round << setw(9) << point.ruined * 100.0 << "%"
+             << setw(9) << point.mean << setw(9) << point.p5 << setw(9) << point.p25 << setw(9) << point.median
+             << setw(9) << point.p75 << setw(9) << point.p95 << endl;
+    }
+    return 0;
+}
+
+int runCompare(const Options& options) {
+    GameConfig base = presetConfig(options);
+
+    // --contenders dealer:policy,... - the first one is the baseline
+    vector<string> specs = optionList(options, "contenders");
+    if (specs.empty()) {
+        specs = {"conservative:threshold", "aggressive:threshold"};
+    }
+    vector<unique_ptr<PlayerPolicy> > policies;
+    vector<Contender> contenders;
+    for (const string& spec : specs) {
+        size_t colon = spec.find(':');
+        string dealer = spec.substr(0, colon);
+        Contender contender;
+        contender.name = spec;
+        contender.config = base;
+        contender.config.useAggressiveDealer = dealer == "aggressive";
+        policies.push_back(makeNamedPolicy(colon == string::npos ? "threshold" : spec.substr(colon + 1), options,
+                                           contender.config));
+        contender.policy = policies.back().get();
+        contenders.push_back(contender);
+    }
+    StrategyComparison comparison(contenders);
+
+    ComparisonOptions run;
+    run.seed = static_cast<uint64_t>(optionInt(options, "seed", 1));
+    run.threads = threadOption(options);
+    run.blockUnits = static_cast<int>(optionInt(options, "block-units", run.blockUnits));
+    run.antithetic = options.count("no-antithetic") == 0;
+    run.targetHalfWidth = atof(optionString(options, "target-width", "0.002").c_str());
+    run.maxRounds = optionInt(options, "max-rounds", run.maxRounds);
+
+    ComparisonResult result = comparison.run(run);
+    cout << "Compared " << contenders.size() << " strategies on " << result.units
+         << (base.useCompositionDeck ? " shared shoes in " : " shared deals in ")
+         << result.seconds << " s" << (result.antithetic ? " (each also mirrored)" : "")
+         << (result.reachedTarget ? " (stopped early: target precision reached)" : "") << endl;
+    if (run.antithetic && !result.antithetic) {
+        cout << "  (no antithetic shoes: this composition is not symmetric under the mirror)" << endl;
+    }
+    for (const ContenderResult& contender : result.contenders) {
+        cout << "  " << left << setw(28) << contender.name << right << " edge " << contender.edge << " +/- "
+             << contender.halfWidth << " over " << contender.rounds << " rounds" << endl;
+    }
+    for (const ContrastResult& contrast : result.contrasts) {
+        cout << "  " << contrast.name << ": " << contrast.difference << " +/- " << contrast.halfWidth
+             << " points/round (95% CI, paired)" << endl;
+        cout << "    independent runs: +/- " << contrast.independentHalfWidth << ", so they would need "
+             << contrast.roundsSaved() << "x the rounds" << endl;
+    }
+    return 0;
+}
+
+int runAudit(const Options& options) {
+    AuditOptions audit;
+    audit.shoes = optionInt(options, "shoes", audit.shoes);
+    audit.shoeSize = static_cast<int>(optionInt(options, "deck-size", presetConfig(options).deckSize));
+    audit.verifyShoes = optionInt(options, "verify", audit.verifyShoes);
+    audit.threads = threadOption(options);
+    audit.seed = static_cast<uint64_t>(optionInt(options, "seed", 1));
+
+    AuditResult result = ShuffleAudit(audit).run();
+    cout << "Shuffle audit: " << result.shoes << " shoes of " << audit.shoeSize << " cards (" << result.cards
+         << " cards) in " << result.seconds << " s, " << static_cast<long long>(result.cardsPerSecond())
+         << " cards/s" << endl;
+    cout << "  " << result.verifiedShoes << " shoes rebuilt as Deck objects, " << result.mismatches
+         << " mismatching cards" << endl;
+    cout << "  test                  chi-square        df   p-value" << endl;
+    for (const AuditTest& test : result.tests) {
+        cout << "  " << left << setw(20) << test.name << right << setw(12) << fixed << setprecision(2)
+             << test.statistic << setw(10) << test.degreesOfFreedom << "   " << defaultfloat << setprecision(4)
+             << test.pValue << "   " << test.description << endl;
+    }
+    // Bonferroni: with this many tests a fair Deck rarely has any p below 0.001 / tests
+    double threshold = 0.001 / result.tests.size();
+    bool passed = result.mismatches == 0 && result.minPValue() >= threshold;
+    cout << (passed ? "PASS" : "FAIL") << ": smallest p-value " << result.minPValue() << " (threshold " << threshold
+         << ")" << endl;
+    return passed ? 0 : 2;
+}
+
+// Times 'decide' over a fixed set of hands; returns nanoseconds per decision
+template <typename Decide>
+double timeDecisions(Decide decide, long long& draws) {
+    const int HANDS = 4096;
+    const int PASSES = 5000;
+    vector<int> totals(HANDS);
+    vector<int> softs(HANDS);
+    vector<int> counts(HANDS);
+    Rng rng(7);
+    for (int i = 0; i < HANDS; i++) {
+        totals[i] = 2 + static_cast<int>(rng.below(20));
+        softs[i] = static_cast<int>(rng.below(2));
+        counts[i] = static_cast<int>(rng.below(9)) - 4;
+    }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; pass++) {
+        for (int i = 0; i < HANDS; i++) {
+            draws += decide(totals[i], softs[i] != 0, counts[i]);
+        }
+    }
+    return secondsSince(start) * 1e9 / (static_cast<double>(HANDS) * PASSES);
+}
+
+int runCheckRules(const Options& options) {
+    string path = optionString(options, "file", "dealer.rules");
+    RuleTable rules = RuleTable::loadFile(path);  // Throws RuleFormatException with the bad rule
+    cout << path << ": OK" << endl;
+    cout << rules.describe();
+    cout << "Nearest plain threshold (hard hands, count 0): stand from " << rules.nearestThreshold() << endl;
+
+    // Both through the DrawStrategy interface, as the Dealer calls them
+    long long draws = 0;
+    vector<unique_ptr<DrawStrategy> > strategies;
+    strategies.push_back(unique_ptr<DrawStrategy>(new RuleStrategy(make_shared<const RuleTable>(rules))));
+    strategies.push_back(createDealerStrategy(presetConfig(options).useAggressiveDealer));
+    double seconds[2];
+    for (int s = 0; s < 2; s++) {
+        DrawStrategy* strategy = strategies[s].get();
+        seconds[s] = timeDecisions([&](int total, bool soft, int count) {
+            return strategy->shouldDrawHand(total, soft, count);
+        }, draws);
+    }
+    cout << fixed << setprecision(2) << "Decision time: " << seconds[0] << " ns (these rules), " << seconds[1]
+         << " ns (built-in threshold strategy)" << defaultfloat << endl;
+    if (draws < 0) {
+        cout << draws << endl;  // Keeps the timed loops from being optimised away
+    }
+    return 0;
+}
+
+// Hosts many tables in a SessionStore and touches them at random, so most
+// accesses page a table in from disk
+// Silences cout while tables are played headless
+struct QuietOutput {
+    QuietOutput() : saved(cout.rdbuf(nullptr)) {}
+    ~QuietOutput() { cout.rdbuf(saved); }
+    streambuf* saved;
+};
+
+// A few random decisions for one round; the hand stands once they run out
+string randomAnswers(Rng& rng) {
+    static const char MOVES[] = "hhhsdpu";
+    string answers;
+    for (int i = 0; i < 3; i++) {
+        answers += MOVES[rng.below(sizeof(MOVES) - 1)];
+        answers += ' ';
+    }
+    return answers;
+}
+
+int runSessions(const Options& options) {
+    GameConfig config = presetConfig(options);
+    long long tables = max(1LL, optionInt(options, "tables", 200));
+    long long touches = max(0LL, optionInt(options, "touches", 2000));
+    SessionStore store(optionString(options, "session-dir", "."),
+                       static_cast<size_t>(max(1LL, optionInt(options, "resident", 16))));
+    Rng rng(static_cast<uint64_t>(optionInt(options, "seed", 1)));
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long long t = 0; t < tables; t++) {
+        store.open(static_cast<uint64_t>(t), config);
+    }
+    double openSeconds = secondsSince(start);
+
+    // Each touch is a player acting: the table plays one round, so saved
+    // sessions carry real state (hands, splits, stakes, a part-used shoe)
+    double pageInSeconds = 0.0;
+    double hitSeconds = 0.0;
+    long long hits = 0;
+    long long played = 0;
+    for (long long i = 0; i < touches; i++) {
+        uint64_t table = rng.below(static_cast<uint32_t>(tables));
+        long long pagedBefore = store.getPageIns();
+        chrono::steady_clock::time_point touched = chrono::steady_clock::now();
+        Game& game = store.get(table);
+        (store.getPageIns() > pagedBefore ? pageInSeconds : hitSeconds) += secondsSince(touched);
+        hits += store.getPageIns() > pagedBefore ? 0 : 1;
+
+        istringstream answers(randomAnswers(rng));
+        QuietOutput quiet;
+        game.playScriptedRound(answers);
+        played++;
+    }
+
+    // Every resident table must survive save -> load -> save byte for byte,
+    // and the loaded copy must then play the next round exactly like the
+    // original: same cards, same result. Only checked when no reshuffle is
+    // due, since a new shoe comes from each game's own random pipeline
+    long long mismatches = 0;
+    long long replayed = 0;
+    long long diverged = 0;
+    size_t sessionBytes = 0;
+    for (long long t = 0; t < tables && t < static_cast<long long>(store.getResident()); t++) {
+        Game& game = store.get(static_cast<uint64_t>(tables - 1 - t));
+        string saved;
+        game.saveSession(saved);
+        unique_ptr<Game> copy = Game::loadSession(saved);
+        string again;
+        copy->saveSession(again);
+        mismatches += saved == again ? 0 : 1;
+        sessionBytes = max(sessionBytes, saved.size());
+
+        if (game.getCardsLeft() >= config.reshuffleThreshold) {
+            string script = randomAnswers(rng);
+            istringstream originalAnswers(script);
+            istringstream copyAnswers(script);
+            {
+                QuietOutput quiet;
+                game.playScriptedRound(originalAnswers);
+                copy->playScriptedRound(copyAnswers);
+            }
+            string original;
+            string loaded;
+            game.saveSession(original);
+            copy->saveSession(loaded);
+            replayed++;
+            diverged += original == loaded ? 0 : 1;
+        }
+    }
+
+    long long pageIns = store.getPageIns();
+    cout << "Sessions: " << tables << " tables, at most " << store.getResident() << " in memory, " << touches
+         << " random touches (" << played << " rounds played)" << endl;
+    cout << fixed << setprecision(1);
+    cout << "  open: " << openSeconds * 1e6 / tables << " us per new table" << endl;
+    cout << "  evicted " << store.getEvictions() << " times, " << store.getBytesWritten() / max(1LL, store.getEvictions())
+         << " bytes per saved session (largest " << sessionBytes << ")" << endl;
+    cout << "  page-in: " << pageIns << " touches, " << (pageIns > 0 ? pageInSeconds * 1e6 / pageIns : 0.0)
+         << " us each (load + evict another); resident hit: " << hits << " touches, "
+         << (hits > 0 ? hitSeconds * 1e9 / hits : 0.0) << " ns each" << endl;
+    cout << defaultfloat;
+    cout << "  round trip: " << mismatches << " mismatching sessions, " << store.getFailures() << " failed writes" << endl;
+    cout << "  next round after loading: " << diverged << " of " << replayed << " copies drew different cards" << endl;
+
+    // A restarted host: a new store on the same directory adopts every saved table
+    long long failures = store.getFailures();
+    if (store.evictAll() > 0) {
+        failures = store.getFailures();
+        cout << "  shutdown: " << store.getResident() << " tables could not be saved" << endl;
+    }
+    SessionStore restarted(optionString(options, "session-dir", "."),
+                           static_cast<size_t>(max(1LL, optionInt(options, "resident", 16))));
+    long long adopted = 0;
+    for (long long t = 0; t < tables; t++) {
+        adopted += restarted.contains(static_cast<uint64_t>(t)) ? 1 : 0;
+    }
+    if (restarted.contains(0)) {
+        restarted.get(0);  // Pages in a file this store never wrote
+    }
+    cout << "  restart: " << adopted << " of " << tables << " tables adopted from disk" << endl;
+
+    for (long long t = 0; t < tables; t++) {
+        store.close(static_cast<uint64_t>(t));
+        restarted.close(static_cast<uint64_t>(t));  // Removes the session files
+    }
+    return mismatches == 0 && diverged == 0 && failures == 0 && adopted == tables ? 0 : 2;
+}
+
+HandOutcome parseOutcome(const string& name) {
+    for (int o = 0; o < static_cast<int>(HandOutcome::COUNT); o++) {
+        if (name == outcomeName(static_cast<HandOutcome>(o))) {
+            return static_cast<HandOutcome>(o);
+        }
+    }
+    throw TableFormatException("Unknown outcome: " + name);
+}
+
+int runQuery(const Options& options) {
+    string path = optionString(options, "history", "hands.bin");
+    HandIndex index(path);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    long long added = index.update();
+    if (added > 0) {
+        cout << "Indexed " << added << " new blocks in " << secondsSince(start) << " s (" << index.getIndexPath()
+             << ")" << endl;
+    }
+
+    HandQuery query;
+    query.openingTotal = static_cast<int>(optionInt(options, "total", 0));
+    if (options.count("soft") > 0) {
+        query.soft = optionInt(options, "soft", 1) != 0 ? 1 : 0;
+    }
+    query.upcard = static_cast<int>(optionInt(options, "upcard", 0));
+    vector<string> outcomes = optionList(options, "outcome");
+    if (!outcomes.empty()) {
+        query.outcomes = 0;
+        for (const string& name : outcomes) {
+            query.outcomes |= 1u << static_cast<int>(parseOutcome(name));
+        }
+    }
+    query.minDealerCards = static_cast<int>(optionInt(options, "dealer-cards-min", 0));
+    query.maxDealerCards = static_cast<int>(optionInt(options, "dealer-cards-max", 255));
+    query.minPlayerCards = static_cast<int>(optionInt(options, "player-cards-min", 0));
+    query.maxPlayerCards = static_cast<int>(optionInt(options, "player-cards-max", 255));
+    query.show = static_cast<int>(optionInt(options, "show", 0));
+
+    HandQueryResult result = index.query(query, threadOption(options));
+    cout << result.rounds << " matching rounds in " << result.seconds << " s" << endl;
+    cout << "  blocks: " << result.blocksFromIndex << " from index, " << result.blocksScanned << " scanned, "
+         << result.blocksSkipped << " skipped, " << result.tailRecords << " unindexed rounds read" << endl;
+    if (result.rounds > 0) {
+        cout << "  mean net " << result.meanNet() << " points/round" << endl;
+        for (int o = 0; o < static_cast<int>(HandOutcome::COUNT); o++) {
+            HandOutcome outcome = static_cast<HandOutcome>(o);
+            cout << "  " << outcomeName(outcome) << " " << result.outcomes[o] << " (" << result.rate(outcome) << ")" << endl;
+        }
+    }
+    for (const HandMatch& match : result.matches) {
+        const HandRecord& r = match.record;
+        cout << "  #" << match.position << ": start " << static_cast<int>(r.openingTotal)
+             << (r.has(HandRecord::OpeningSoft) ? " soft" : "") << " vs " << r.upcardValue()
+             << ", player " << static_cast<int>(r.playerScore) << " (" << static_cast<int>(r.playerCards) << " cards)"
+             << ", dealer " << static_cast<int>(r.dealerScore) << " (" << static_cast<int>(r.dealerCards) << " cards)"
+             << ", " << outcomeName(outcomeOf(r)) << ", net " << r.net() << endl;
+    }
+    return 0;
+}
+
+// Options only the coordinator reads - everything else is handed to the workers
+bool coordinatorOption(const string& name) {
+    return name == "processes" || name == "shard-blocks" || name == "retries" || name == "shard-dir" ||
+           name == "threads";
+}
+
+int runDistribute(const Options& options, const string& program) {
+    GameConfig config = presetConfig(options);
+
+    CoordinatorOptions coordinator;
+    coordinator.processes = static_cast<int>(optionInt(options, "processes", thread::hardware_concurrency()));
+    coordinator.blocksPerShard = optionInt(options, "shard-blocks", coordinator.blocksPerShard);
+    coordinator.maxRetries = static_cast<int>(optionInt(options, "retries", coordinator.maxRetries));
+    coordinator.shardDirectory = optionString(options, "shard-dir", "");
+    coordinator.simulation.seed = static_cast<uint64_t>(optionInt(options, "seed", 1));
+    unique_ptr<TelemetryPublisher> telemetry = makeTelemetry(options, "distribute", coordinator.processes);
+    coordinator.simulation.telemetry = telemetry.get();
+
+    // Each worker is this program again: "<program> worker <options> --first-block A --blocks N"
+    vector<string> workerCommand;
+    workerCommand.push_back(program);
+    workerCommand.push_back("worker");
+    for (const Options::value_type& option : options) {
+        if (!coordinatorOption(option.first)) {
+            workerCommand.push_back("--" + option.first);
+            workerCommand.push_back(option.second);
+        }
+    }
+
+    ShardCoordinator shards(config, workerCommand, coordinator);
+    SimulationResult result = shards.run();
+    cout << "Simulated " << result.stats.getRounds() << " rounds in " << result.seconds << " s"
+         << (result.reachedTarget ? " (stopped early: CI target reached)" : "") << endl;
+    cout << "  " << shards.getShardsRun() << " shards run, " << shards.getRestarts() << " restarts" << endl;
+    printStats(result.stats);
+    return 0;
+}
+
+// Hidden command started by distribute: prints one line per block on stdout
+int runWorker(const Options& options) {
+    GameConfig config = presetConfig(options);
+    unique_ptr<PlayerPolicy> policy = makePolicy(options, config);
+    Simulator simulator(config, *policy);
+
+    SimulationOptions run;
+    run.seed = static_cast<uint64_t>(optionInt(options, "seed", 1));
+    unique_ptr<TelemetryPublisher> telemetry = makeTelemetry(options, "worker", 1);
+    run.telemetry = telemetry.get();
+    return ShardCoordinator::runWorker(simulator, config, run, optionInt(options, "first-block", 0),
+                                       optionInt(options, "blocks", 1), cout);
+}
+
+int runSweep(const Options& options) {
+    GameConfig base = presetConfig(options);
+    base.maxSimulationRounds = optionInt(options, "rounds", 1000000);
+
+    SweepGrid grid;
+    grid.deckSizes = optionIntList(options, "deck-sizes");
+    grid.reshuffleThresholds = optionIntList(options, "reshuffles");
+    grid.targetScores = optionIntList(options, "targets");
+    grid.playerStandThresholds = optionIntList(options, "player-stands");
+    for (const string& dealer : optionList(options, "dealers")) {
+        grid.aggressiveDealers.push_back(dealer == "aggressive");
+    }
+
+    vector<SweepPoint> points = grid.expand(base);
+    SweepRunner runner(threadOption(options), static_cast<uint64_t>(optionInt(options, "seed", 1)));
+    runner.setBlockRounds(optionInt(options, "block-rounds", 4096));
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<SweepResult> results = runner.run(points);
+    cerr << "Swept " << points.size() << " configurations in " << secondsSince(start) << " s" << endl;
+
+    string format = optionString(options, "format", "csv");
+    string path = optionString(options, "out", "");
+    ofstream file;
+    if (!path.empty()) {
+        file.open(path.c_str());
+        if (!file) {
+            cerr << "Cannot open " << path << endl;
+            return 1;
+        }
+    }
+    ostream& out = path.empty() ? cout : file;
+
+    if (format == "json") {
+        SweepRunner::writeJson(out, results);
+    } else {
+        SweepRunner::writeCsv(out, results);
+    }
+    return 0;
+}
+
+void printCacheStats(const string& label, const MemoCacheStats& stats) {
+    cout << "  " << label << " cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+         << stats.evictions << " evictions (hit rate " << stats.hitRate() * 100.0 << "%)" << endl;
+}
+
+int runSolve(const Options& options) {
+    GameConfig config = presetConfig(options);
+    int threadCount = threadOption(options);
+    size_t cacheSlots = static_cast<size_t>(optionInt(options, "cache-slots", 1 << 16));
+
+    // One pair of caches shared by every thread
+    Solver::DealerCache dealerCache(cacheSlots);
+    Solver::PlayerCache playerCache(cacheSlots);
+    ShoeState shoe = ShoeState::standard(config.deckSize);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    /*
+     * Best action for every hard total 4-20 against every dealer upcard.
+     * Threads take upcards in turn; overlapping subproblems are shared
+     * through the caches.
+     */
+    const int lowTotal = 4;
+    const int highTotal = 20;
+    vector<vector<char> > table(highTotal + 1, vector<char>(ShoeState::RANKS + 1, ' '));
+    vector<thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.push_back(thread([&, t]() {
+            Solver solver(config, &dealerCache, &playerCache);
+            for (int up = 1 + t; up <= 10; up += threadCount) {
+                for (int total = lowTotal; total <= highTotal; total++) {
+                    // Any two non-Ace cards making 'total'
+                    int first = total / 2;
+                    int second = total - first;
+                    if (second > 10) {
+                        continue;
+                    }
+                    ShoeState remaining = shoe;
+                    HandState player;
+                    HandState dealer;
+                    if (config.useCompositionDeck) {
+                        remaining.removeRank(first);
+                        remaining.removeRank(second);
+                        remaining.removeRank(up);
+                    }
+                    player.addRank(first);
+                    player.addRank(second);
+                    dealer.addRank(up);
+                    ActionValues values = solver.actionValues(remaining, player, dealer);
+                    table[total][up] = values.best() == PlayerAction::Hit ? 'H' : 'S';
+                }
+            }
+        }));
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    Solver solver(config, &dealerCache, &playerCache);
+    Outcome round = solver.roundOutcome(shoe);
+    double seconds = secondsSince(start);
+
+    cout << "Best play (hard totals) vs dealer upcard, dealer stands on "
+         << solver.getDealerThreshold() << (solver.isInfiniteDeck() ? ", infinite deck" : ", finite shoe") << endl;
+    cout << "       A  2  3  4  5  6  7  8  9 10" << endl;
+    for (int total = lowTotal; total <= highTotal; total++) {
+        cout << setw(4) << total << " ";
+        for (int up = 1; up <= 10; up++) {
+            cout << "  " << table[total][up];
+        }
+        cout << endl;
+    }
+
+    cout << "Round with best play: win " << round.win << ", tie " << round.tie()
+         << ", loss " << round.loss << ", edge " << round.value() << endl;
+    cout << "Solved in " << seconds << " s with " << threadCount << " thread(s)" << endl;
+    printCacheStats("dealer", dealerCache.getStats());
+    printCacheStats("player", playerCache.getStats());
+    return 0;
+}
+
+int runMatch(const Options& options) {
+    GameConfig config = presetConfig(options);
+    config.targetScore = optionInt(options, "target", config.targetScore);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Outcome round = MatchOdds::roundOdds(config);
+    double solveSeconds = secondsSince(start);
+
+    start = chrono::steady_clock::now();
+    MatchOdds match(config.targetScore, round);
+    double tableSeconds = secondsSince(start);
+
+    cout << "Round with best play: win " << round.win << ", tie " << round.tie()
+         << ", loss " << round.loss << endl;
+    cout << "First to " << match.getTargetScore() << ": chance the player wins the game"
+         << " (rounds treated as independent, each from a fresh shoe)" << endl;
+
+    // Rows: player points, columns: dealer points
+    cout << "  you\\dealer";
+    for (int b = 0; b < match.getTargetScore(); b++) {
+        cout << setw(7) << b;
+    }
+    cout << endl;
+    cout << fixed << setprecision(3);
+    for (int a = 0; a < match.getTargetScore(); a++) {
+        cout << setw(12) << a;
+        for (int b = 0; b < match.getTargetScore(); b++) {
+            cout << setw(7) << match.winProbability(a, b);
+        }
+        cout << endl;
+    }
+    cout << defaultfloat << setprecision(6);
+
+    cout << "From 0-0: win " << match.winProbability(0, 0) << ", expected rounds "
+         << match.expectedRounds(0, 0) << endl;
+    cout << "Round odds solved in " << solveSeconds * 1e6 << " us, match table built in "
+         << tableSeconds * 1e6 << " us" << endl;
+    return 0;
+}
+
+int runTables(const Options& options) {
+    GameConfig config = presetConfig(options);
+    config.tableDirectory = optionString(options, "table-dir", ".");  // This command is for saving them
+    string path = StrategyTables::defaultPath(config);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    unique_ptr<StrategyTables> tables = StrategyTables::openOrBuild(config);
+    double seconds = secondsSince(start);
+
+    cout << "Strategy tables " << (path.empty() ? string("(memory only)") : path) << endl;
+    cout << "  rules hash " << hex << StrategyTables::configHash(config) << dec
+         << ", format version " << StrategyTables::VERSION << endl;
+    cout << "  " << (!tables->wasBuilt() ? "opened existing file" : tables->isMapped() ? "solved and saved" : "solved (could not save)")
+         << (tables->isMapped() ? ", memory-mapped" : ", in memory") << ", " << seconds * 1e6 << " us" << endl;
+    const Outcome& round = tables->roundOutcome();
+    cout << "  round with best play: win " << round.win << ", tie " << round.tie()
+         << ", loss " << round.loss << endl;
+    return 0;
+}
+
+int runTrain(const Options& options) {
+    GameConfig config = presetConfig(options);
+
+    TrainerOptions training;
+    training.episodes = optionInt(options, "episodes", training.episodes);
+    training.epochEpisodes = optionInt(options, "epoch-episodes", training.epochEpisodes);
+    training.actors = threadOption(options);
+    training.seed = static_cast<uint64_t>(optionInt(options, "seed", 1));
+    training.checkpointPath = optionString(options, "checkpoint", "");
+    if (options.count("epsilon")) {
+        training.epsilon = atof(options.at("epsilon").c_str());
+    }
+
+    PolicyTrainer trainer(config, training);
+    if (options.count("resume") && !training.checkpointPath.empty()) {
+        trainer.resume(training.checkpointPath);
+    }
+
+    TrainingProgress done = trainer.train([](const TrainingProgress& p) {
+        cerr << "epoch " << p.epoch << ": " << p.episodes << " rounds, " << p.policyChanges
+             << " policy changes, max value change " << p.maxValueChange << ", epsilon " << p.epsilon
+             << ", " << static_cast<long long>(p.roundsPerSecond) << " rounds/s" << endl;
+    });
+    cerr << "Trained on " << done.episodes << " rounds in " << done.seconds << " s" << endl;
+
+    DecisionTable table = trainer.table();
+    string path = optionString(options, "out", "");
+    if (path.empty()) {
+        table.save(cout);
+    } else {
+        table.saveFile(path);
+        cerr << "Wrote " << path << " (use: simulate --policy table --table " << path << ")" << endl;
+    }
+    return 0;
+}
+
+void printUsage() {
+    cout << "Usage: blackjack_sim <command> [options]" << endl;
+    cout << "Commands:" << endl;
+    cout << "  batch     Compare the scalar round loop with the lockstep batch simulator" << endl;
+    cout << "            --preset easy|normal|hard --rounds N --lanes N --seed N --player-stand N" << endl;
+    cout << "  simulate  Multi-threaded simulation that stops when the edge is known precisely" << endl;
+    cout << "            --preset ... --rules classic|standard|vegas --policy threshold|basic|mcts|table|solved|rules" << endl;
+    cout << "            --rollouts N --budget-us N --search-threads N (mcts search budget per decision)" << endl;
+    cout << "            --table FILE (DecisionTable for --policy table)" << endl;
+    cout << "            --rule-file FILE (strategy rules for --policy rules, see check-rules)" << endl;
+    cout << "            --ci-width W --max-rounds N --threads N --seed N --composition" << endl;
+    cout << "            --checkpoint FILE --resume (save after every epoch / continue a stopped run)" << endl;
+    cout << "            --history FILE (append every round to a hand-history log)" << endl;
+    cout << "            --no-telemetry (do not publish live progress for blackjack_top)" << endl;
+    cout << "  sweep     Simulate a grid of GameConfig variants on all cores (CSV or JSON)" << endl;
+    cout << "            --deck-sizes A,B --reshuffles A,B --targets A,B --dealers aggressive,conservative" << endl;
+    cout << "            --player-stands A,B --rounds N --threads N --format csv|json --out FILE" << endl;
+    cout << "  solve     Exact best play and round odds using the parallel memoised solver" << endl;
+    cout << "            --preset ... --composition --deck-size N --threads N --cache-slots N" << endl;
+    cout << "  match     Chance of winning the whole game from every score (rounds from fresh shoes)" << endl;
+    cout << "            --preset ... --composition --deck-size N --target N" << endl;
+    cout << "  tables    Solve (or open) the shared memory-mapped strategy tables" << endl;
+    cout << "            --preset ... --rules ... --table-dir DIR" << endl;
+    cout << "  train     Learn a Hit/Stand table by reinforcement learning on all cores" << endl;
+    cout << "            --episodes N --epoch-episodes N --threads N --epsilon E" << endl;
+    cout << "            --checkpoint FILE --resume --out FILE" << endl;
+    cout << "  bankroll  Risk of ruin and bankroll spread for many betting players" << endl;
+    cout << "            --betting flat|spread --max-bet N --ramp N (spread: Hi-Lo count, needs --composition)" << endl;
+    cout << "            --bankrolls N --rounds N --units N --points N --threads N --seed N" << endl;
+    cout << "  compare   Paired comparison of strategies on the same shoes (common random numbers)" << endl;
+    cout << "            --contenders conservative:threshold,aggressive:basic,... (first = baseline)" << endl;
+    cout << "            --target-width W --max-rounds N --no-antithetic --block-units N --threads N --seed N" << endl;
+    cout << "  audit     Chi-square tests that Deck's cards are unbiased (exit code 2 on failure)" << endl;
+    cout << "            --deck-size N --shoes N --verify N (shoes also built as Deck objects) --threads N --seed N" << endl;
+    cout << "  check-rules Validate and compile a strategy rule file, show its table and lookup speed" << endl;
+    cout << "            --file FILE (e.g. \"soft 17: hit; hard >=17: stand; any: hit\")" << endl;
+    cout << "  query     Count rounds in a hand-history log using its sidecar index" << endl;
+    cout << "            --history FILE --total N --soft 0|1 --upcard N --outcome player-bust,dealer-bust,win,tie,loss,surrender" << endl;
+    cout << "            --dealer-cards-min N --dealer-cards-max N --player-cards-min N --player-cards-max N --show N" << endl;
+    cout << "  distribute Same as simulate, split across worker processes (bit-identical result)" << endl;
+    cout << "            simulate options plus --processes N --shard-blocks N --retries N --shard-dir DIR" << endl;
+    cout << "  sessions  Host many tables, keep the recently used ones in memory, page the rest from disk" << endl;
+    cout << "            --preset ... --composition --tables N --resident N --touches N --session-dir DIR --seed N" << endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    string command = argv[1];
+    Options options = parseOptions(argc, argv, 2);
+
+    // Bad table or checkpoint files are reported, not crashed on
+    try {
+        if (command == "batch") {
+            return runBatch(options);
+        }
+        if (command == "simulate") {
+            return runSimulate(options);
+        }
+        if (command == "sweep") {
+            return runSweep(options);
+        }
+        if (command == "solve") {
+            return runSolve(options);
+        }
+        if (command == "match") {
+            return runMatch(options);
+        }
+        if (command == "tables") {
+            return runTables(options);
+        }
+        if (command == "train") {
+            return runTrain(options);
+        }
+        if (command == "bankroll") {
+            return runBankroll(options);
+        }
+        if (command == "compare") {
+            return runCompare(options);
+        }
+        if (command == "audit") {
+            return runAudit(options);
+        }
+        if (command == "check-rules") {
+            return runCheckRules(options);
+        }
+        if (command == "query") {
+            return runQuery(options);
+        }
+        if (command == "distribute") {
+            return runDistribute(options, argv[0]);
+        }
+        if (command == "worker") {
+            return runWorker(options);
+        }
+        if (command == "sessions") {
+            return runSessions(options);
+        }
+    }
+    catch (const TableFormatException& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    catch (const ShardFailedException& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    catch (const RuleFormatException& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    catch (const invalid_argument& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    printUsage();
+    return 1;
+}
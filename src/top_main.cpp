@@ -0,0 +1,221 @@
+/*
+ * BLACKJACK_TOP (LIVE SIMULATION VIEWER)
+ * ======================================
+ * Shows every running blackjack_sim simulate / distribute / worker process,
+ * read from the shared-memory segments they publish (see Telemetry.h):
+ * rounds per second per worker, total rounds, the current edge estimate,
+ * CI width and queue depths, refreshed every second.
+ *
+ * USAGE:
+ *   blackjack_top [--pid N] [--interval SECONDS] [--once] [--clean]
+ *
+ * - Workers much slower than the median of their run are marked "slow",
+ *   workers with no finished block for 10 s are marked "stalled"
+ * - Segments left behind by a process that died are marked "exited";
+ *   --clean removes them
+ *
+ * The viewer only maps the segments read-only and loads from them, so
+ * watching a run never slows it down.
+ */
+
+#include "Telemetry.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+namespace {
+
+const double NANOS = 1e-9;
+const double STALLED_SECONDS = 10.0;
+
+struct Options {
+    long long pid = 0;       // 0 = every run
+    double interval = 1.0;
+    bool once = false;
+    bool clean = false;
+};
+
+// Counters seen at the previous refresh, to turn totals into rates
+struct Sample {
+    uint64_t nanos = 0;
+    uint64_t rounds[TelemetrySegment::MAX_WORKERS] = {};
+};
+
+string human(double value) {
+    ostringstream text;
+    text << fixed << setprecision(value >= 1e6 ? 2 : 1);
+    if (value >= 1e9) {
+        text << value / 1e9 << "G";
+    } else if (value >= 1e6) {
+        text << value / 1e6 << "M";
+    } else if (value >= 1e3) {
+        text << value / 1e3 << "k";
+    } else {
+        text << setprecision(0) << value;
+    }
+    return text.str();
+}
+
+double seconds(uint64_t from, uint64_t to) {
+    return to > from ? (to - from) * NANOS : 0.0;
+}
+
+void showRun(const string& name, const TelemetryReader& reader, map<string, Sample>& samples, ostream& out) {
+    const TelemetrySegment& run = reader.get();
+    const uint64_t now = TelemetryPublisher::nowNanos();
+    const bool finished = run.state.load(memory_order_relaxed) == TelemetrySegment::Finished;
+    Sample& previous = samples[name];
+    Sample current;
+    current.nanos = now;
+
+    out << "PID " << run.pid << " " << run.role;
+    if (!reader.processAlive()) {
+        out << "  exited (stale segment, --clean removes it)" << endl;
+        return;
+    }
+    out << "  " << (finished ? "finished" : "running") << " " << fixed << setprecision(1)
+        << seconds(run.startNanos, now) << " s";
+    if (string(run.role) == "worker") {
+        out << "  (parent " << run.parentPid << ")";
+    }
+    out << endl;
+
+    uint64_t totalRounds = run.totalRounds.load(memory_order_relaxed);
+    uint64_t maxRounds = run.maxRounds.load(memory_order_relaxed);
+    double edge = TelemetrySegment::fromBits(run.edgeBits.load(memory_order_relaxed));
+    double width = TelemetrySegment::fromBits(run.ciWidthBits.load(memory_order_relaxed));
+    double target = TelemetrySegment::fromBits(run.targetBits.load(memory_order_relaxed));
+    if (maxRounds > 0) {  // distribute workers only run blocks; their coordinator merges
+        out << "  merged " << human(static_cast<double>(totalRounds)) << " / " << human(static_cast<double>(maxRounds))
+            << " rounds after " << run.epochs.load(memory_order_relaxed) << " merges";
+        if (totalRounds > 1) {
+            out << "   edge " << setprecision(5) << edge << " +/- " << width / 2.0 << "  (CI width " << width;
+            if (target > 0.0) {
+                out << ", stops at " << target;
+            }
+            out << ")";
+        }
+        out << endl;
+    }
+    out << "  queue " << run.queued.load(memory_order_relaxed) << " waiting, "
+        << run.inFlight.load(memory_order_relaxed) << " in flight" << endl;
+
+    // Per-worker rates: since the last refresh, or since the slot started
+    vector<double> rates;
+    vector<int> slots;
+    double totalRate = 0.0;
+    for (uint32_t w = 0; w < run.workerSlots && w < static_cast<uint32_t>(TelemetrySegment::MAX_WORKERS); w++) {
+        const TelemetryWorker& worker = run.workers[w];
+        current.rounds[w] = worker.rounds.load(memory_order_relaxed);
+        uint64_t start = worker.startNanos.load(memory_order_relaxed);
+        if (start == 0) {
+            continue;
+        }
+        double rate = previous.nanos > 0 && current.rounds[w] >= previous.rounds[w]
+                          ? (current.rounds[w] - previous.rounds[w]) / seconds(previous.nanos, now)
+                          : current.rounds[w] / std::max(NANOS, seconds(start, now));
+        rates.push_back(finished ? 0.0 : rate);
+        slots.push_back(static_cast<int>(w));
+        totalRate += rates.back();
+    }
+    vector<double> sorted = rates;
+    sort(sorted.begin(), sorted.end());
+    double median = sorted.empty() ? 0.0 : sorted[sorted.size() / 2];
+
+    out << "  " << human(totalRate) << " rounds/s" << endl;
+    out << "    slot      rounds   blocks   rounds/s   last block" << endl;
+    for (size_t i = 0; i < slots.size(); i++) {
+        const TelemetryWorker& worker = run.workers[slots[i]];
+        uint64_t updated = worker.updatedNanos.load(memory_order_relaxed);
+        double idle = updated == 0 ? seconds(worker.startNanos.load(memory_order_relaxed), now) : seconds(updated, now);
+        out << "    " << setw(4) << slots[i] << setw(12) << human(static_cast<double>(current.rounds[slots[i]]))
+            << setw(9) << worker.blocks.load(memory_order_relaxed) << setw(11) << human(rates[i]) << setw(10)
+            << setprecision(1) << idle << " s";
+        if (!finished && idle > STALLED_SECONDS) {
+            out << "  stalled";
+        } else if (!finished && median > 0.0 && rates[i] < 0.5 * median) {
+            out << "  slow";
+        }
+        out << endl;
+    }
+    out << defaultfloat;
+    previous = current;
+}
+
+Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        string value = i + 1 < argc ? argv[i + 1] : "";
+        if (arg == "--pid") {
+            options.pid = atoll(value.c_str());
+            i++;
+        } else if (arg == "--interval") {
+            options.interval = std::max(0.1, atof(value.c_str()));
+            i++;
+        } else if (arg == "--once") {
+            options.once = true;
+        } else if (arg == "--clean") {
+            options.clean = true;
+        } else {
+            cerr << "Usage: blackjack_top [--pid N] [--interval SECONDS] [--once] [--clean]" << endl;
+            exit(1);
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options = parseOptions(argc, argv);
+
+    if (options.clean) {
+        int removed = 0;
+        for (const string& name : TelemetryReader::list()) {
+            TelemetryReader reader(name);
+            if (reader.isOpen() && !reader.processAlive() && TelemetryReader::remove(name)) {
+                removed++;
+            }
+        }
+        cout << "Removed " << removed << " stale segments" << endl;
+        return 0;
+    }
+
+    map<string, Sample> samples;
+    while (true) {
+        ostringstream screen;
+        int shown = 0;
+        for (const string& name : TelemetryReader::list()) {
+            TelemetryReader reader(name);
+            if (!reader.isOpen() || (options.pid != 0 && reader.get().pid != options.pid)) {
+                continue;
+            }
+            showRun(name, reader, samples, screen);
+            screen << endl;
+            shown++;
+        }
+        if (shown == 0) {
+            screen << "No running simulations (start one with: blackjack_sim simulate ...)" << endl;
+        }
+
+        if (!options.once) {
+            cout << "\033[H\033[2J";  // Home and clear: redraw in place
+            cout << "blackjack_top - refresh " << options.interval << " s, Ctrl-C to quit" << endl << endl;
+        }
+        cout << screen.str() << flush;
+        if (options.once) {
+            return 0;
+        }
+        this_thread::sleep_for(chrono::duration<double>(options.interval));
+    }
+}